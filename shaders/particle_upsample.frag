@@ -0,0 +1,35 @@
+#version 330 core
+in vec2 vTexCoord;
+uniform sampler2D uParticles;   // low-res additive layer
+uniform sampler2D uLowDepth;    // scene depth the particles were tested against
+uniform sampler2D uDepth;       // full-res scene depth
+uniform vec2 uLowTexel;         // 1 / particle target size
+uniform vec2 uClip;             // near, far
+out vec4 FragColor;
+
+float linearDepth(float d) {
+    return uClip.x * uClip.y / (uClip.y - d * (uClip.y - uClip.x));
+}
+
+void main() {
+    float z = linearDepth(texture(uDepth, vTexCoord).r);
+
+    // The four particle texels bilinear filtering would blend here
+    vec2 base = (floor(vTexCoord / uLowTexel - 0.5) + 0.5) * uLowTexel;
+    vec2 taps[4] = vec2[4](base, base + vec2(uLowTexel.x, 0.0),
+                           base + vec2(0.0, uLowTexel.y), base + uLowTexel);
+    float best = 1e30;
+    float spread = 0.0;
+    vec2 nearest = taps[0];
+    for (int i = 0; i < 4; i++) {
+        float diff = abs(linearDepth(texture(uLowDepth, taps[i]).r) - z);
+        spread = max(spread, diff);
+        if (diff < best) { best = diff; nearest = taps[i]; }
+    }
+
+    // Across a depth edge take the texel on this pixel's side, so glows
+    // neither bleed onto planets nor leave a dark rim around them
+    vec3 c = spread < 0.1 * z ? texture(uParticles, vTexCoord).rgb
+                              : texture(uParticles, nearest).rgb;
+    FragColor = vec4(c, 1.0);
+}
@@ -0,0 +1,472 @@
+#pragma once
+
+#include "miniaudio.h"
+#include "readahead_vfs.h"
+#include "cast_renderer.h"
+#include "music_data.h"
+#include <string>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include "log.h"
+
+// ============================================================
+// SPSC QUEUE - fixed-size lock-free ring, one producer, one consumer
+// ============================================================
+template <typename T, size_t N>
+class SpscQueue {
+    static_assert((N & (N - 1)) == 0, "N must be a power of two");
+public:
+    bool push(T&& v) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == N) return false;
+        slots[h & (N - 1)] = std::move(v);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& v) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        v = std::move(slots[t & (N - 1)]);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, N> slots;
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+};
+
+// ============================================================
+// SEQLOCK - single writer publishes a trivially-copyable snapshot,
+// readers retry instead of blocking it
+// ============================================================
+template <typename T>
+class Seqlock {
+public:
+    void store(const T& v) {
+        unsigned s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&data, &v, sizeof(T));
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    T load() const {
+        T v;
+        unsigned s0, s1;
+        do {
+            s0 = seq.load(std::memory_order_acquire);
+            std::memcpy(&v, &data, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            s1 = seq.load(std::memory_order_relaxed);
+        } while (s0 != s1 || (s0 & 1));
+        return v;
+    }
+
+private:
+    std::atomic<unsigned> seq{0};
+    T data{};
+};
+
+// ============================================================
+// AUDIO PLAYER - miniaudio (supports MP3, FLAC, WAV, OGG, etc.)
+// Every miniaudio call after init happens on a control thread.
+// The main thread posts commands and reads a published snapshot,
+// so input and rendering never wait on decoder or network I/O.
+// play() and friends must only be called from the main thread.
+// ============================================================
+class AudioPlayer {
+public:
+    // Main-thread view of what was last asked for (shown immediately,
+    // before the control thread has loaded it)
+    std::string currentTrack;
+    std::string currentTrackName;
+    std::string currentArtist;
+    std::string currentAlbum;
+    float duration = 0;
+    float volume = 0.8f;
+    bool castEnabled = false;
+    std::string castTarget = "Living Room";
+    std::string nextTrack;      // hinted with setNext() for cast prefetch
+
+    void init() {
+        ma_engine_config config = ma_engine_config_init();
+#ifndef _WIN32
+        readAhead.start();
+        config.pResourceManagerVFS = readAhead.vfs();
+#endif
+        if (ma_engine_init(&config, &engine) != MA_SUCCESS) {
+            LOG_ERROR("Audio") << "Failed to init miniaudio engine";
+            return;
+        }
+        engineInit = true;
+        ma_engine_set_volume(&engine, volume);
+        const char* castEnv = std::getenv("PLANETARY_CAST");
+        const char* targetEnv = std::getenv("PLANETARY_CAST_TARGET");
+        castEnabled = (castEnv && std::string(castEnv) == "1");
+        if (targetEnv && std::string(targetEnv).size() > 0) castTarget = targetEnv;
+#ifdef _WIN32
+        castEnabled = false;    // media server is POSIX sockets only
+#else
+        if (castEnabled) {
+            const char* portEnv = std::getenv("PLANETARY_CAST_PORT");
+            bool local = castTarget == "local";
+            // The local stand-in never leaves the machine; keep it off the LAN
+            castEnabled = castServer.start(portEnv ? atoi(portEnv) : 0, local ? "127.0.0.1" : "0.0.0.0");
+            if (local) renderer = std::make_unique<LocalCastRenderer>(&engine);
+            else renderer = std::make_unique<UpnpCastRenderer>(castTarget);
+        }
+#endif
+        LOG_INFO("Audio") << "miniaudio engine ready (MP3/FLAC/WAV/OGG)"
+                          << (castEnabled ? " | CAST MODE ON -> " + castTarget : std::string());
+        quit = false;
+        control = std::thread([this] { controlLoop(); });
+    }
+
+    void play(const std::string& path, const std::string& name, const std::string& artist, const std::string& album, float dur) {
+        if (!engineInit) return;
+        currentTrack = path;
+        currentTrackName = name;
+        currentArtist = artist;
+        currentAlbum = album;
+        duration = dur;
+        Command c;
+        c.type = Command::Play;
+        c.path = path;
+        c.label = name + " by " + artist;
+        c.value = dur;
+        c.generation = ++requested;
+        post(std::move(c));
+    }
+
+    // Track likely to play after the current one. Cast receivers get it
+    // ahead of time so the switch is gapless; no-op for local playback.
+    void setNext(const std::string& path, const std::string& name) {
+        if (!castEnabled || path == nextTrack) return;
+        nextTrack = path;
+        Command c{Command::SetNext};
+        c.path = path;
+        c.label = name;
+        post(std::move(c));
+    }
+
+    void togglePause() { post(Command{Command::TogglePause}); }
+    void stop() { post(Command{Command::Stop}); }
+
+    void seek(float seconds) {
+        Command c{Command::Seek};
+        c.value = seconds;
+        post(std::move(c));
+    }
+
+    void setVolume(float v) {
+        volume = v;
+        Command c{Command::Volume};
+        c.value = v;
+        post(std::move(c));
+    }
+
+    // ---- State (lock-free reads of the control thread's snapshot) ----
+
+    // Snapshot describes the track most recently passed to play()
+    bool isCurrent() const { return state.load().generation == requested; }
+    bool isLoaded() const { State s = state.load(); return s.loaded && s.generation == requested; }
+    bool isPlaying() const { State s = state.load(); return s.playing && s.generation == requested; }
+    bool isBuffering() const { State s = state.load(); return s.buffering || s.generation != requested; }
+    bool isAtEnd() const { State s = state.load(); return s.atEnd && s.generation == requested; }
+
+    float currentTime() const {
+        State s = state.load();
+        return s.generation == requested ? s.cursor : 0.0f;
+    }
+
+    float progress() const {
+        if (duration <= 0) return 0;
+        return std::min(1.0f, currentTime() / duration);
+    }
+
+    void cleanup() {
+        if (control.joinable()) {
+            quit = true;
+            wake.notify_one();
+            control.join();
+        }
+#ifndef _WIN32
+        renderer.reset();
+        castServer.stop();
+#endif
+        if (engineInit) ma_engine_uninit(&engine);
+        engineInit = false;
+#ifndef _WIN32
+        readAhead.stop();
+        if (readAhead.stats.reads > 0) {
+            LOG_INFO("ReadAhead") << readAhead.stats.bytes / (1024 * 1024) << " MB in "
+                                  << readAhead.stats.reads << " reads, " << readAhead.stats.underruns << " underruns, "
+                                  << readAhead.stats.stallMicros / 1000 << " ms stalled";
+        }
+#endif
+    }
+
+private:
+    struct Command {
+        enum Type { Play, TogglePause, Stop, Seek, Volume, SetNext } type = Play;
+        std::string path;
+        std::string label;
+        float value = 0;
+        unsigned generation = 0;
+
+        Command() = default;
+        explicit Command(Type t) : type(t) {}
+    };
+
+    struct State {
+        unsigned generation;
+        bool loaded;
+        bool playing;
+        bool buffering;
+        bool atEnd;
+        float cursor;
+    };
+
+    ma_engine engine;
+    ma_sound sound;
+    bool engineInit = false;
+#ifndef _WIN32
+    ReadAheadVFS readAhead;     // keeps streams fed from NFS/SMB/slow disks
+    MediaServer castServer;
+    std::unique_ptr<CastRenderer> renderer;
+#endif
+
+    SpscQueue<Command, 64> commands;
+    Seqlock<State> state;
+    unsigned requested = 0;     // main thread: generation of the last play()
+    std::thread control;
+    std::atomic<bool> quit{false};
+    std::mutex wakeMutex;       // only for sleeping, never held by the main thread
+    std::condition_variable wake;
+
+    // Control-thread state
+    bool soundInit = false;
+    bool castLoaded = false;
+    bool playing = false;
+    unsigned loadedGen = 0;
+    std::string castCurrent, castNext;
+
+    void post(Command&& c) {
+        if (!commands.push(std::move(c))) {
+            LOG_WARN("Audio") << "Command queue full, dropping";
+            return;
+        }
+        wake.notify_one();
+    }
+
+    void publish(bool buffering = false) {
+        State s{};
+        s.generation = loadedGen;
+        s.loaded = soundInit || castLoaded;
+        s.playing = playing;
+        s.buffering = buffering;
+        if (soundInit) {
+            ma_sound_get_cursor_in_seconds(&sound, &s.cursor);
+            s.atEnd = ma_sound_at_end(&sound);
+        }
+#ifndef _WIN32
+        if (castLoaded) {
+            s.cursor = renderer->position();
+            s.atEnd = renderer->finished();
+        }
+#endif
+        state.store(s);
+    }
+
+    void controlLoop() {
+        std::vector<Command> batch;
+        while (!quit) {
+            batch.clear();
+            Command c;
+            while (commands.pop(c)) batch.push_back(std::move(c));
+
+            for (size_t i = 0; i < batch.size(); i++) {
+                // Skip work a later command in the same batch overrides
+                // (fast track skipping, seek-slider drags)
+                bool superseded = false;
+                for (size_t j = i + 1; j < batch.size() && !superseded; j++) {
+                    if (batch[i].type == Command::Play || batch[i].type == Command::Seek)
+                        superseded = batch[j].type == Command::Play ||
+                                     (batch[i].type == Command::Seek && batch[j].type == Command::Seek);
+                }
+                if (superseded) {
+                    // The old track must not keep playing under the new generation
+                    if (batch[i].type == Command::Play) {
+                        unload();
+                        loadedGen = batch[i].generation;
+                    }
+                    continue;
+                }
+                execute(batch[i]);
+            }
+            publish();
+
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait_for(lock, std::chrono::milliseconds(10));
+        }
+        if (soundInit) ma_sound_uninit(&sound);
+        soundInit = false;
+#ifndef _WIN32
+        if (castLoaded) renderer->stop();
+        castLoaded = false;
+#endif
+    }
+
+    void execute(const Command& c) {
+#ifndef _WIN32
+        if (castEnabled && c.type != Command::Play && c.type != Command::Volume) {
+            castExecute(c);
+            return;
+        }
+#endif
+        switch (c.type) {
+            case Command::Play: load(c); break;
+            case Command::TogglePause:
+                if (!soundInit) break;
+                if (playing) ma_sound_stop(&sound);
+                else ma_sound_start(&sound);
+                playing = !playing;
+                break;
+            case Command::Stop:
+                if (soundInit) ma_sound_stop(&sound);
+                playing = false;
+                break;
+            case Command::Seek:
+                if (soundInit) {
+                    ma_uint32 sampleRate = ma_engine_get_sample_rate(&engine);
+                    ma_sound_seek_to_pcm_frame(&sound, (ma_uint64)(std::max(0.0f, c.value) * sampleRate));
+                }
+                break;
+            case Command::Volume:
+                ma_engine_set_volume(&engine, c.value);
+                break;
+            case Command::SetNext:
+                break;
+        }
+    }
+
+#ifndef _WIN32
+    // ---- Cast mode: the receiver plays, we serve files and steer it ----
+
+    void castLoad(const Command& c) {
+        castCurrent = c.path;
+        castServer.serve(castCurrent, castNext);
+        std::string mime = mediaMimeType(c.path);
+        castLoaded = renderer->load(castServer.urlFor(c.path), c.label, mime, c.value);
+        playing = castLoaded;
+        if (castLoaded && !castNext.empty() && castNext != castCurrent)
+            renderer->setNext(castServer.urlFor(castNext), "", mediaMimeType(castNext));
+        LOG_INFO("Audio") << "Cast (" << renderer->name() << "): " << c.label
+                          << (castLoaded ? "" : " FAILED");
+    }
+
+    void castExecute(const Command& c) {
+        switch (c.type) {
+            case Command::TogglePause:
+                if (!castLoaded) break;
+                if (playing) renderer->pause();
+                else renderer->resume();
+                playing = !playing;
+                break;
+            case Command::Stop:
+                if (castLoaded) renderer->pause();
+                playing = false;
+                break;
+            case Command::Seek:
+                if (castLoaded) renderer->seek(c.value);
+                break;
+            case Command::SetNext:
+                castNext = c.path;
+                castServer.serve(castCurrent, castNext);
+                if (castLoaded) renderer->setNext(castServer.urlFor(c.path), c.label, mediaMimeType(c.path));
+                break;
+            default:
+                break;
+        }
+    }
+#endif
+
+    // Stop the current track. A cast receiver is left to the next load,
+    // which replaces its stream anyway.
+    void unload() {
+        if (soundInit) {
+            ma_sound_uninit(&sound);
+            soundInit = false;
+        }
+        castLoaded = false;
+        playing = false;
+    }
+
+    void load(const Command& c) {
+        unload();
+        loadedGen = c.generation;
+        const std::string& path = c.path;
+
+#ifndef _WIN32
+        if (castEnabled) {
+            castLoad(c);
+            return;
+        }
+#endif
+
+#ifdef __ANDROID__
+        // Android: HTTP URLs from Navidrome are downloaded to a temp file
+        // first. This blocks only the control thread; the UI shows buffering.
+        if (path.substr(0, 4) == "http") {
+            publish(true);
+            std::string tempFile = "/data/local/tmp/planetary_stream.mp3";
+            std::string response = planetaryHttpGet(path, 30);
+            if (response.empty()) {
+                logPrintf(LogLevel::Error, "Audio", "HTTP stream failed: %s", path.c_str());
+                return;
+            }
+            // Write to temp file
+            FILE* f = fopen(tempFile.c_str(), "wb");
+            if (!f) {
+                logPrintf(LogLevel::Error, "Audio", "Cannot write temp file");
+                return;
+            }
+            fwrite(response.data(), 1, response.size(), f);
+            fclose(f);
+            if (ma_sound_init_from_file(&engine, tempFile.c_str(), MA_SOUND_FLAG_STREAM, nullptr, nullptr, &sound) != MA_SUCCESS) {
+                logPrintf(LogLevel::Error, "Audio", "Failed to decode stream");
+                return;
+            }
+        } else {
+            if (ma_sound_init_from_file(&engine, path.c_str(), MA_SOUND_FLAG_STREAM, nullptr, nullptr, &sound) != MA_SUCCESS) {
+                logPrintf(LogLevel::Error, "Audio", "Failed to load: %s", path.c_str());
+                return;
+            }
+        }
+#else
+        // Stream rather than load whole: decoding starts after the first
+        // page instead of after the whole file has crossed the network
+        if (ma_sound_init_from_file(&engine, path.c_str(), MA_SOUND_FLAG_STREAM, nullptr, nullptr, &sound) != MA_SUCCESS) {
+            LOG_ERROR("Audio") << "Failed to load: " << path;
+            return;
+        }
+#endif
+        soundInit = true;
+        ma_sound_start(&sound);
+        playing = true;
+        LOG_INFO("Audio") << "Playing: " << c.label;
+    }
+};
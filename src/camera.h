@@ -30,6 +30,15 @@ public:
     float autoRotateSpeed = 0.02f; // Slow auto-rotation at galaxy level
     bool autoRotate = true;
 
+    // Video wall: this screen is tile (tileCol, tileRow) of a tileCols x
+    // tileRows wall (row 0 at the top) and aspect is the whole wall's.
+    // Each tile gets its slice of the shared frustum (off-axis).
+    int tileCols = 1, tileRows = 1, tileCol = 0, tileRow = 0;
+
+    void setScreen(int w, int h) {
+        aspect = (float)(w * tileCols) / (float)(h * tileRows);
+    }
+
     void update(float dt) {
         if (autoRotate) {
             orbitYaw += autoRotateSpeed * dt;
@@ -55,7 +64,13 @@ public:
     }
 
     glm::mat4 projMatrix() const {
-        return glm::perspective(glm::radians(fov), aspect, nearPlane, farPlane);
+        if (tileCols == 1 && tileRows == 1)
+            return glm::perspective(glm::radians(fov), aspect, nearPlane, farPlane);
+        float top = nearPlane * tanf(glm::radians(fov) * 0.5f);
+        float right = top * aspect;
+        float w = 2.0f * right / tileCols, h = 2.0f * top / tileRows;
+        float l = -right + w * tileCol, t = top - h * tileRow;
+        return glm::frustum(l, l + w, t - h, t, nearPlane, farPlane);
     }
 
     void onMouseDrag(float dx, float dy) {
@@ -0,0 +1,580 @@
+#pragma once
+
+#include "miniaudio.h"
+#include "media_server.h"
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include "log.h"
+
+#ifndef _WIN32
+#include <netdb.h>
+#include <poll.h>
+#include <strings.h>
+#include <algorithm>
+
+// ============================================================
+// CAST RENDERER - remote transport control. The media server hands
+// out URLs; a renderer tells a receiver to load, pause, seek and
+// stop them. Implementations: UPnP/DLNA AVTransport and a local
+// stand-in that plays the served URL through our own engine.
+// ============================================================
+class CastRenderer {
+public:
+    virtual ~CastRenderer() = default;
+    virtual const char* name() const = 0;
+    virtual bool load(const std::string& url, const std::string& title, const std::string& mime, float duration) = 0;
+    virtual void setNext(const std::string& url, const std::string& title, const std::string& mime) {
+        (void)url; (void)title; (void)mime;
+    }
+    virtual void pause() = 0;
+    virtual void resume() = 0;
+    virtual void seek(float seconds) = 0;
+    virtual void stop() = 0;
+    virtual float position() = 0;     // seconds into the current track
+    virtual bool finished() = 0;
+};
+
+// ============================================================
+// Minimal blocking HTTP/1.1 client (Connection: close)
+// ============================================================
+struct HttpUrl {
+    std::string host;
+    int port = 80;
+    std::string path = "/";
+};
+
+inline bool parseHttpUrl(const std::string& url, HttpUrl& out) {
+    if (url.rfind("http://", 0) != 0) return false;
+    std::string rest = url.substr(7);
+    size_t slash = rest.find('/');
+    std::string hostPort = rest.substr(0, slash);
+    out.path = slash == std::string::npos ? "/" : rest.substr(slash);
+    size_t colon = hostPort.find(':');
+    out.host = hostPort.substr(0, colon);
+    out.port = colon == std::string::npos ? 80 : atoi(hostPort.c_str() + colon + 1);
+    return !out.host.empty();
+}
+
+struct HttpResponse {
+    int status = 0;
+    std::string headers;    // lower-cased
+    std::string body;
+};
+
+inline HttpResponse httpRequest(const HttpUrl& url, const std::string& method,
+                                const std::string& extraHeaders = "", const std::string& body = "",
+                                int timeoutMs = 3000) {
+    HttpResponse resp;
+    addrinfo hints{}, *res = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(url.host.c_str(), std::to_string(url.port).c_str(), &hints, &res) != 0 || !res) return resp;
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    timeval tv{timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+    if (fd >= 0) {
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+#ifdef SO_NOSIGPIPE
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    }
+    if (fd < 0 || connect(fd, res->ai_addr, res->ai_addrlen) != 0) {
+        if (fd >= 0) close(fd);
+        freeaddrinfo(res);
+        return resp;
+    }
+    freeaddrinfo(res);
+
+    std::string req = method + " " + url.path + " HTTP/1.1\r\nHost: " + url.host + ":" + std::to_string(url.port) +
+                      "\r\nConnection: close\r\n" + extraHeaders;
+    if (!body.empty()) req += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    req += "\r\n" + body;
+    if (!sendAll(fd, req.data(), req.size())) { close(fd); return resp; }
+
+    std::string raw;
+    char buf[16384];
+    for (ssize_t n; (n = recv(fd, buf, sizeof(buf), 0)) > 0; ) raw.append(buf, (size_t)n);
+    close(fd);
+
+    size_t split = raw.find("\r\n\r\n");
+    if (split == std::string::npos || raw.compare(0, 5, "HTTP/") != 0) return resp;
+    resp.status = atoi(raw.c_str() + raw.find(' ') + 1);
+    resp.headers = raw.substr(0, split + 2);
+    for (char& c : resp.headers) c = (char)tolower((unsigned char)c);
+    resp.body = raw.substr(split + 4);
+    return resp;
+}
+
+inline std::string httpHeader(const HttpResponse& r, const std::string& lowerName) {
+    size_t p = r.headers.find("\r\n" + lowerName + ":");
+    if (p == std::string::npos) return "";
+    p += lowerName.size() + 3;
+    while (p < r.headers.size() && r.headers[p] == ' ') p++;
+    return r.headers.substr(p, r.headers.find("\r\n", p) - p);
+}
+
+// ============================================================
+// LOCAL STAND-IN - a receiver in our own process. Fetches the served
+// URL with HTTP range requests and decodes it through the engine, so
+// cast mode (server, ranges, seek, pause) can be tested with no
+// hardware: PLANETARY_CAST=1 PLANETARY_CAST_TARGET=local
+// A fetch thread does the HTTP and decoding into a PCM ring; the
+// audio thread only copies out of it and plays silence on underrun.
+// ============================================================
+class LocalCastRenderer : public CastRenderer {
+public:
+    explicit LocalCastRenderer(ma_engine* engine) : engine(engine) {}
+    ~LocalCastRenderer() override { stop(); }
+
+    const char* name() const override { return "local"; }
+
+    bool load(const std::string& url, const std::string&, const std::string&, float) override {
+        stop();
+        if (!parseHttpUrl(url, src)) return false;
+        HttpResponse head = httpRequest(src, "HEAD");
+        if (head.status != 200 || httpHeader(head, "accept-ranges") != "bytes") {
+            LOG_WARN("Cast") << "local: " << url << " not range-servable (" << head.status << ")";
+            return false;
+        }
+        size = atoll(httpHeader(head, "content-length").c_str());
+        cursor = 0;
+        blockStart = -1;
+        channels = ma_engine_get_channels(engine);
+        sampleRate = ma_engine_get_sample_rate(engine);
+        ma_decoder_config dc = ma_decoder_config_init(ma_format_f32, channels, sampleRate);
+        if (ma_decoder_init(onRead, onSeek, this, &dc, &decoder) != MA_SUCCESS) return false;
+        decoderInit = true;
+
+        ring.assign((size_t)RING_FRAMES * channels, 0.0f);
+        ringHead = ringCount = 0;
+        playedFrames = 0;
+        pendingSeek = -1;
+        decodedAll = false;
+        ma_data_source_config sc = ma_data_source_config_init();
+        sc.vtable = &ringVtable;
+        source.self = this;
+        if (ma_data_source_init(&sc, &source.base) != MA_SUCCESS) {
+            stop();
+            return false;
+        }
+        sourceInit = true;
+        if (ma_sound_init_from_data_source(engine, &source, 0, nullptr, &sound) != MA_SUCCESS) {
+            stop();
+            return false;
+        }
+        soundInit = true;
+        quit = false;
+        fetcher = std::thread([this] { fetchLoop(); });
+        ma_sound_start(&sound);
+        return true;
+    }
+
+    void pause() override { if (soundInit) ma_sound_stop(&sound); }
+    void resume() override { if (soundInit) ma_sound_start(&sound); }
+
+    // Handled by the fetch thread; the ring is dropped now so the old
+    // position stops playing at once
+    void seek(float seconds) override {
+        if (!soundInit) return;
+        std::lock_guard<std::mutex> lock(m);
+        pendingSeek = (int64_t)(std::max(0.0f, seconds) * sampleRate);
+        playedFrames = (uint64_t)pendingSeek;
+        ringCount = 0;
+        decodedAll = false;
+    }
+
+    void stop() override {
+        if (soundInit) ma_sound_uninit(&sound);
+        if (fetcher.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(m);
+                quit = true;
+            }
+            wake.notify_all();
+            fetcher.join();
+        }
+        if (sourceInit) ma_data_source_uninit(&source.base);
+        if (decoderInit) ma_decoder_uninit(&decoder);
+        soundInit = sourceInit = decoderInit = false;
+    }
+
+    float position() override {
+        std::lock_guard<std::mutex> lock(m);
+        return sampleRate ? (float)playedFrames / (float)sampleRate : 0.0f;
+    }
+
+    bool finished() override {
+        std::lock_guard<std::mutex> lock(m);
+        return soundInit && decodedAll && ringCount == 0;
+    }
+
+    uint64_t rangeRequests = 0;
+    std::atomic<uint64_t> underruns{0};
+
+private:
+    static constexpr int64_t BLOCK = 256 * 1024;
+    static constexpr uint32_t RING_FRAMES = 48000 * 2;   // ~2 s ahead at 48 kHz
+    static constexpr uint32_t DECODE_FRAMES = 4096;
+
+    struct RingSource {
+        ma_data_source_base base;       // must come first
+        LocalCastRenderer* self;
+    };
+
+    ma_engine* engine;
+    ma_decoder decoder;
+    RingSource source;
+    ma_sound sound;
+    bool decoderInit = false, sourceInit = false, soundInit = false;
+    ma_uint32 channels = 2, sampleRate = 48000;
+
+    // Fetch thread only
+    HttpUrl src;
+    int64_t size = 0, cursor = 0;
+    std::string block;
+    int64_t blockStart = -1;
+
+    // Shared with the audio thread, under m. The audio thread only
+    // try_locks it; the fetch thread never holds it across I/O.
+    std::mutex m;
+    std::condition_variable wake;
+    std::thread fetcher;
+    bool quit = false;
+    std::vector<float> ring;
+    uint32_t ringHead = 0, ringCount = 0;
+    uint64_t playedFrames = 0;
+    int64_t pendingSeek = -1;
+    bool decodedAll = false;
+
+    void fetchLoop() {
+        std::vector<float> chunk((size_t)DECODE_FRAMES * channels);
+        std::unique_lock<std::mutex> lock(m);
+        while (!quit) {
+            if (pendingSeek >= 0) {
+                int64_t frame = pendingSeek;
+                pendingSeek = -1;
+                lock.unlock();
+                ma_decoder_seek_to_pcm_frame(&decoder, (ma_uint64)frame);
+                lock.lock();
+                continue;
+            }
+            // Nothing to do while the ring is full or the track is done;
+            // the audio thread never signals, so poll
+            if (decodedAll || ringCount + DECODE_FRAMES > RING_FRAMES) {
+                wake.wait_for(lock, std::chrono::milliseconds(10));
+                continue;
+            }
+            lock.unlock();
+            ma_uint64 got = 0;
+            ma_result r = ma_decoder_read_pcm_frames(&decoder, chunk.data(), DECODE_FRAMES, &got);
+            lock.lock();
+            if (pendingSeek >= 0) continue;     // decoded from before the seek
+            for (ma_uint64 i = 0; i < got; i++) {
+                uint32_t slot = (ringHead + ringCount) % RING_FRAMES;
+                memcpy(&ring[(size_t)slot * channels], &chunk[(size_t)i * channels], channels * sizeof(float));
+                ringCount++;
+            }
+            if (got == 0 || r != MA_SUCCESS) decodedAll = true;
+        }
+    }
+
+    // ---- PCM ring as a data source (audio thread) ----
+
+    static ma_result ringRead(ma_data_source* ds, void* out, ma_uint64 frames, ma_uint64* read) {
+        LocalCastRenderer* self = ((RingSource*)ds)->self;
+        float* dst = (float*)out;
+        ma_uint32 ch = self->channels;
+        std::unique_lock<std::mutex> lock(self->m, std::try_to_lock);
+        if (!lock) {
+            // Fetch thread is mid-copy: a few ms of silence beats waiting
+            memset(dst, 0, (size_t)frames * ch * sizeof(float));
+            if (read) *read = frames;
+            return MA_SUCCESS;
+        }
+        ma_uint64 done = 0;
+        while (done < frames && self->ringCount > 0) {
+            memcpy(dst + done * ch, &self->ring[(size_t)self->ringHead * ch], ch * sizeof(float));
+            self->ringHead = (self->ringHead + 1) % RING_FRAMES;
+            self->ringCount--;
+            done++;
+        }
+        self->playedFrames += done;
+        if (done == 0 && self->decodedAll) {
+            if (read) *read = 0;
+            return MA_AT_END;
+        }
+        if (done < frames) {
+            if (!self->decodedAll) self->underruns++;
+            memset(dst + done * ch, 0, (size_t)(frames - done) * ch * sizeof(float));
+        }
+        if (read) *read = frames;
+        return MA_SUCCESS;
+    }
+
+    static ma_result ringSeek(ma_data_source* ds, ma_uint64 frame) {
+        LocalCastRenderer* self = ((RingSource*)ds)->self;
+        std::unique_lock<std::mutex> lock(self->m, std::try_to_lock);
+        if (!lock) return MA_BUSY;
+        self->pendingSeek = (int64_t)frame;
+        self->playedFrames = frame;
+        self->ringCount = 0;
+        self->decodedAll = false;
+        return MA_SUCCESS;
+    }
+
+    static ma_result ringFormat(ma_data_source* ds, ma_format* format, ma_uint32* channels, ma_uint32* rate,
+                                ma_channel* map, size_t mapCap) {
+        LocalCastRenderer* self = ((RingSource*)ds)->self;
+        *format = ma_format_f32;
+        *channels = self->channels;
+        *rate = self->sampleRate;
+        if (map) ma_channel_map_init_standard(ma_standard_channel_map_default, map, mapCap, self->channels);
+        return MA_SUCCESS;
+    }
+
+    static ma_result ringCursor(ma_data_source* ds, ma_uint64* cursor) {
+        LocalCastRenderer* self = ((RingSource*)ds)->self;
+        std::unique_lock<std::mutex> lock(self->m, std::try_to_lock);
+        if (!lock) return MA_BUSY;
+        *cursor = self->playedFrames;
+        return MA_SUCCESS;
+    }
+
+    static inline ma_data_source_vtable ringVtable = { ringRead, ringSeek, ringFormat, ringCursor, nullptr, nullptr, 0 };
+
+    // ---- Encoded bytes for the decoder (fetch thread, and load()) ----
+
+    static ma_result onRead(ma_decoder* d, void* out, size_t bytes, size_t* read) {
+        auto* self = (LocalCastRenderer*)d->pUserData;
+        size_t done = 0;
+        while (done < bytes && self->cursor < self->size) {
+            int64_t off = self->cursor - self->blockStart;
+            if (self->blockStart < 0 || off < 0 || off >= (int64_t)self->block.size()) {
+                int64_t last = std::min(self->size, self->cursor + BLOCK) - 1;
+                HttpResponse r = httpRequest(self->src, "GET",
+                    "Range: bytes=" + std::to_string(self->cursor) + "-" + std::to_string(last) + "\r\n");
+                self->rangeRequests++;
+                if (r.status != 206 || r.body.empty()) break;
+                self->block.swap(r.body);
+                self->blockStart = self->cursor;
+                off = 0;
+            }
+            size_t k = std::min(bytes - done, (size_t)((int64_t)self->block.size() - off));
+            memcpy((char*)out + done, self->block.data() + off, k);
+            done += k;
+            self->cursor += (int64_t)k;
+        }
+        if (read) *read = done;
+        return (done == 0 && bytes > 0) ? MA_AT_END : MA_SUCCESS;
+    }
+
+    static ma_result onSeek(ma_decoder* d, ma_int64 offset, ma_seek_origin origin) {
+        auto* self = (LocalCastRenderer*)d->pUserData;
+        int64_t base = origin == ma_seek_origin_start ? 0 : origin == ma_seek_origin_current ? self->cursor : self->size;
+        if (base + offset < 0 || base + offset > self->size) return MA_BAD_SEEK;
+        self->cursor = base + offset;
+        return MA_SUCCESS;
+    }
+};
+
+// ============================================================
+// UPNP / DLNA - AVTransport over SOAP. The target is a friendly name
+// found by SSDP discovery ("Living Room"), or a device description
+// URL ("http://192.168.1.20:1400/xml/device_description.xml").
+// ============================================================
+class UpnpCastRenderer : public CastRenderer {
+public:
+    explicit UpnpCastRenderer(const std::string& target) : target(target) {}
+
+    const char* name() const override { return "upnp"; }
+
+    bool load(const std::string& url, const std::string& title, const std::string& mime, float duration) override {
+        if (!resolve()) return false;
+        trackDuration = duration;
+        // Already moved on to it by itself (gapless SetNextAVTransportURI)
+        if (url == nextUrl) {
+            HttpResponse r = soapRequest("GetPositionInfo", "");
+            if (xmlText(r.body, "TrackURI") == xmlEscape(url)) {
+                markPosition(0, true);
+                lastPoll = {};
+                return true;
+            }
+        }
+        bool ok = soap("SetAVTransportURI", "<CurrentURI>" + xmlEscape(url) + "</CurrentURI>"
+                       "<CurrentURIMetaData>" + xmlEscape(didl(url, title, mime)) + "</CurrentURIMetaData>") &&
+                  soap("Play", "<Speed>1</Speed>");
+        markPosition(0, ok);
+        return ok;
+    }
+
+    void setNext(const std::string& url, const std::string& title, const std::string& mime) override {
+        nextUrl = url;
+        if (!control.host.empty() && !url.empty())
+            soap("SetNextAVTransportURI", "<NextURI>" + xmlEscape(url) + "</NextURI>"
+                 "<NextURIMetaData>" + xmlEscape(didl(url, title, mime)) + "</NextURIMetaData>");
+    }
+
+    void pause() override { markPosition(position(), false); soap("Pause", ""); }
+    void resume() override { soap("Play", "<Speed>1</Speed>"); markPosition(basePos, true); }
+    void stop() override { if (!control.host.empty()) soap("Stop", ""); markPosition(0, false); }
+
+    void seek(float seconds) override {
+        int s = (int)std::max(0.0f, seconds);
+        char t[16];
+        snprintf(t, sizeof(t), "%d:%02d:%02d", s / 3600, (s / 60) % 60, s % 60);
+        soap("Seek", std::string("<Unit>REL_TIME</Unit><Target>") + t + "</Target>");
+        markPosition(seconds, running);
+    }
+
+    // Interpolated locally, corrected from the receiver every few seconds
+    float position() override {
+        auto now = std::chrono::steady_clock::now();
+        if (running && now - lastPoll > std::chrono::seconds(3)) {
+            lastPoll = now;
+            HttpResponse r = soapRequest("GetPositionInfo", "");
+            std::string rel = xmlText(r.body, "RelTime");
+            int h, m, s;
+            if (sscanf(rel.c_str(), "%d:%d:%d", &h, &m, &s) == 3) markPosition((float)(h * 3600 + m * 60 + s), true);
+        }
+        if (!running) return basePos;
+        return basePos + std::chrono::duration<float>(now - baseTime).count();
+    }
+
+    bool finished() override { return running && trackDuration > 0 && position() >= trackDuration - 0.5f; }
+
+private:
+    std::string target;
+    std::string nextUrl;
+    float trackDuration = 0;
+    HttpUrl control;
+    bool resolveFailed = false;
+    bool running = false;
+    float basePos = 0;
+    std::chrono::steady_clock::time_point baseTime, lastPoll;
+
+    void markPosition(float pos, bool run) {
+        basePos = pos;
+        baseTime = std::chrono::steady_clock::now();
+        running = run;
+    }
+
+    static std::string xmlEscape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            switch (c) {
+                case '&': out += "&amp;"; break;
+                case '<': out += "&lt;"; break;
+                case '>': out += "&gt;"; break;
+                case '"': out += "&quot;"; break;
+                default: out += c;
+            }
+        }
+        return out;
+    }
+
+    static std::string xmlText(const std::string& xml, const std::string& tag, size_t from = 0) {
+        size_t a = xml.find("<" + tag + ">", from);
+        if (a == std::string::npos) return "";
+        a += tag.size() + 2;
+        return xml.substr(a, xml.find("</" + tag + ">", a) - a);
+    }
+
+    static std::string didl(const std::string& url, const std::string& title, const std::string& mime) {
+        return "<DIDL-Lite xmlns=\"urn:schemas-upnp-org:metadata-1-0/DIDL-Lite/\" "
+               "xmlns:dc=\"http://purl.org/dc/elements/1.1/\" xmlns:upnp=\"urn:schemas-upnp-org:metadata-1-0/upnp/\">"
+               "<item id=\"0\" parentID=\"-1\" restricted=\"1\"><dc:title>" + xmlEscape(title) + "</dc:title>"
+               "<upnp:class>object.item.audioItem.musicTrack</upnp:class>"
+               "<res protocolInfo=\"http-get:*:" + mime + ":DLNA.ORG_OP=01\">" + xmlEscape(url) + "</res></item></DIDL-Lite>";
+    }
+
+    HttpResponse soapRequest(const std::string& action, const std::string& args) {
+        std::string body =
+            "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+            "<s:Envelope xmlns:s=\"http://schemas.xmlsoap.org/soap/envelope/\" "
+            "s:encodingStyle=\"http://schemas.xmlsoap.org/soap/encoding/\"><s:Body>"
+            "<u:" + action + " xmlns:u=\"urn:schemas-upnp-org:service:AVTransport:1\">"
+            "<InstanceID>0</InstanceID>" + args + "</u:" + action + "></s:Body></s:Envelope>";
+        return httpRequest(control, "POST",
+            "Content-Type: text/xml; charset=\"utf-8\"\r\n"
+            "SOAPACTION: \"urn:schemas-upnp-org:service:AVTransport:1#" + action + "\"\r\n", body);
+    }
+
+    bool soap(const std::string& action, const std::string& args) {
+        HttpResponse r = soapRequest(action, args);
+        if (r.status != 200) LOG_ERROR("Cast") << action << " failed (" << r.status << ")";
+        return r.status == 200;
+    }
+
+    // Device description -> AVTransport control URL
+    bool readDescription(const std::string& location, bool matchName) {
+        HttpUrl loc;
+        if (!parseHttpUrl(location, loc)) return false;
+        HttpResponse r = httpRequest(loc, "GET");
+        if (r.status != 200) return false;
+        if (matchName) {
+            std::string name = xmlText(r.body, "friendlyName");
+            if (strcasecmp(name.c_str(), target.c_str()) != 0) return false;
+        }
+        size_t svc = r.body.find("urn:schemas-upnp-org:service:AVTransport:");
+        if (svc == std::string::npos) return false;
+        std::string path = xmlText(r.body, "controlURL", svc);
+        if (path.empty()) return false;
+        control = loc;
+        if (path.rfind("http://", 0) == 0) parseHttpUrl(path, control);
+        else control.path = path[0] == '/' ? path : "/" + path;
+        LOG_INFO("Cast") << "UPnP renderer " << control.host << ":" << control.port << control.path;
+        return true;
+    }
+
+    bool resolve() {
+        if (!control.host.empty()) return true;
+        if (resolveFailed) return false;
+        if (target.rfind("http://", 0) == 0) {
+            resolveFailed = !readDescription(target, false);
+            return !resolveFailed;
+        }
+        // SSDP M-SEARCH for media renderers, collect replies for ~2 s
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in dst{};
+        dst.sin_family = AF_INET;
+        dst.sin_port = htons(1900);
+        inet_pton(AF_INET, "239.255.255.250", &dst.sin_addr);
+        std::string msearch = "M-SEARCH * HTTP/1.1\r\nHOST: 239.255.255.250:1900\r\nMAN: \"ssdp:discover\"\r\n"
+                              "MX: 2\r\nST: urn:schemas-upnp-org:service:AVTransport:1\r\n\r\n";
+        std::vector<std::string> locations;
+        if (fd >= 0 && sendto(fd, msearch.data(), msearch.size(), 0, (sockaddr*)&dst, sizeof(dst)) > 0) {
+            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(2500);
+            pollfd p{fd, POLLIN, 0};
+            while (std::chrono::steady_clock::now() < until && poll(&p, 1, 250) >= 0) {
+                if (!(p.revents & POLLIN)) continue;
+                char buf[2048];
+                ssize_t n = recv(fd, buf, sizeof(buf) - 1, 0);
+                if (n <= 0) continue;
+                std::string reply(buf, (size_t)n), lower = reply;
+                for (char& c : lower) c = (char)tolower((unsigned char)c);
+                size_t l = lower.find("\r\nlocation:");
+                if (l == std::string::npos) continue;
+                l += 11;
+                while (reply[l] == ' ') l++;
+                std::string loc = reply.substr(l, reply.find("\r\n", l) - l);
+                if (std::find(locations.begin(), locations.end(), loc) == locations.end()) locations.push_back(loc);
+            }
+        }
+        if (fd >= 0) close(fd);
+        for (auto& loc : locations)
+            if (readDescription(loc, true)) return true;
+        LOG_ERROR("Cast") << "No UPnP renderer named '" << target << "' (" << locations.size() << " found)";
+        resolveFailed = true;
+        return false;
+    }
+};
+
+#endif // !_WIN32
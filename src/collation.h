@@ -0,0 +1,185 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <numeric>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+// ============================================================
+// COLLATION - binary sort keys built once per name, so sorting is
+// a plain memcmp and a sorted table can be binary-searched by prefix.
+//   "The Beatles" -> "beatles"     leading article dropped
+//   "Björk"       -> "bjork"       case and Latin diacritics folded
+//   "AC/DC"       -> "acdc"        punctuation ignored
+//   "Track 9" < "Track 10"         digit runs compare by value
+// Anything outside Latin-1 / Latin Extended-A keeps its UTF-8 bytes
+// and sorts after the letters. The original name follows a 0x00 so
+// distinct names never tie.
+// ============================================================
+
+namespace collation {
+
+// ASCII folding for U+00C0..U+017F; "" = drop (x, division sign)
+inline const char* foldLatin(uint32_t cp) {
+    static const char* latin1[64] = {
+        "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+        "d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "ss",
+        "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+        "d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "y",
+    };
+    if (cp >= 0xC0 && cp <= 0xFF) return latin1[cp - 0xC0];
+    struct Range { uint16_t first, last; const char* fold; };
+    static const Range extA[] = {
+        {0x100, 0x105, "a"}, {0x106, 0x10D, "c"}, {0x10E, 0x111, "d"}, {0x112, 0x11B, "e"},
+        {0x11C, 0x123, "g"}, {0x124, 0x127, "h"}, {0x128, 0x131, "i"}, {0x132, 0x133, "ij"},
+        {0x134, 0x135, "j"}, {0x136, 0x138, "k"}, {0x139, 0x142, "l"}, {0x143, 0x14B, "n"},
+        {0x14C, 0x151, "o"}, {0x152, 0x153, "oe"}, {0x154, 0x159, "r"}, {0x15A, 0x161, "s"},
+        {0x162, 0x167, "t"}, {0x168, 0x173, "u"}, {0x174, 0x175, "w"}, {0x176, 0x178, "y"},
+        {0x179, 0x17E, "z"}, {0x17F, 0x17F, "s"},
+    };
+    for (auto& r : extA)
+        if (cp >= r.first && cp <= r.last) return r.fold;
+    return nullptr;
+}
+
+// Lower-case ASCII letters and digits, single spaces between words,
+// punctuation dropped, unknown characters kept as UTF-8
+inline std::string fold(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    bool space = false;
+    auto emit = [&](const char* text, size_t len) {
+        if (space && !out.empty()) out += ' ';
+        space = false;
+        out.append(text, len);
+    };
+    for (size_t i = 0; i < s.size(); ) {
+        unsigned char c = (unsigned char)s[i];
+        if (c < 0x80) {
+            i++;
+            if (isalnum(c)) { char l = (char)tolower(c); emit(&l, 1); }
+            else if (isspace(c)) space = true;
+            continue;
+        }
+        // UTF-8 sequence
+        int len = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+        if (i + len > s.size()) len = (int)(s.size() - i);
+        uint32_t cp = len == 2 ? ((c & 0x1F) << 6) | ((unsigned char)s[i + 1] & 0x3F) : 0;
+        const char* f = len == 2 ? foldLatin(cp) : nullptr;
+        if (f) { if (*f) emit(f, strlen(f)); }
+        else if (len == 2 && cp < 0xC0) space = true;   // Latin-1 punctuation (NBSP, quotes...)
+        else emit(s.data() + i, (size_t)len);
+        i += (size_t)len;
+    }
+    return out;
+}
+
+inline std::string stripArticle(const std::string& folded) {
+    for (const char* a : {"the ", "a ", "an "}) {
+        size_t n = strlen(a);
+        if (folded.size() > n && folded.compare(0, n, a) == 0) return folded.substr(n);
+    }
+    return folded;
+}
+
+// Words -> key bytes. Spaces become 0x01; a digit run becomes a length
+// byte (0x10 + digits) then the digits without leading zeros, so numbers
+// compare by value. Letters stay ASCII, so digits < letters < UTF-8.
+inline std::string encode(const std::string& folded, bool prefix) {
+    std::string key;
+    key.reserve(folded.size() + 4);
+    for (size_t i = 0; i < folded.size(); ) {
+        char c = folded[i];
+        if (c == ' ') { key += '\x01'; i++; continue; }
+        if (c >= '0' && c <= '9') {
+            // A partial number can't be a key prefix: stop there
+            if (prefix) break;
+            size_t j = i;
+            while (j < folded.size() && folded[j] >= '0' && folded[j] <= '9') j++;
+            size_t k = i;
+            while (k + 1 < j && folded[k] == '0') k++;
+            key += (char)(0x10 + std::min<size_t>(j - k, 0x2F));
+            key.append(folded, k, j - k);
+            i = j;
+            continue;
+        }
+        key += c;
+        i++;
+    }
+    return key;
+}
+
+} // namespace collation
+
+inline std::string collationKey(const std::string& name) {
+    std::string key = collation::encode(collation::stripArticle(collation::fold(name)), false);
+    key += '\0';
+    key += name;
+    return key;
+}
+
+// Key for "names starting with this"; compare with keyHasPrefix
+inline std::string collationPrefix(const std::string& text) {
+    return collation::encode(collation::stripArticle(collation::fold(text)), true);
+}
+
+inline bool keyLess(const std::string& a, const std::string& b) {
+    int c = memcmp(a.data(), b.data(), std::min(a.size(), b.size()));
+    return c < 0 || (c == 0 && a.size() < b.size());
+}
+
+inline bool keyHasPrefix(const std::string& key, const std::string& prefix) {
+    return key.size() >= prefix.size() && memcmp(key.data(), prefix.data(), prefix.size()) == 0;
+}
+
+// Sort by key. Large tables are sorted in chunks on all cores and
+// merged pairwise in parallel; elements are moved once at the end.
+template <typename T, typename KeyOf>
+void sortByKey(std::vector<T>& items, KeyOf keyOf) {
+    size_t n = items.size();
+    std::vector<uint32_t> idx(n);
+    std::iota(idx.begin(), idx.end(), 0u);
+    auto less = [&](uint32_t a, uint32_t b) { return keyLess(keyOf(items[a]), keyOf(items[b])); };
+
+    unsigned parts = n < 8192 ? 1 : std::max(1u, std::min(8u, std::thread::hardware_concurrency()));
+    if (parts <= 1) {
+        std::sort(idx.begin(), idx.end(), less);
+    } else {
+        std::vector<size_t> bound(parts + 1);
+        for (unsigned p = 0; p <= parts; p++) bound[p] = n * p / parts;
+        std::vector<std::thread> pool;
+        for (unsigned p = 0; p < parts; p++)
+            pool.emplace_back([&, p] { std::sort(idx.begin() + bound[p], idx.begin() + bound[p + 1], less); });
+        for (auto& t : pool) t.join();
+        for (unsigned width = 1; width < parts; width *= 2) {
+            pool.clear();
+            for (unsigned p = 0; p + width < parts; p += 2 * width) {
+                size_t lo = bound[p], mid = bound[p + width], hi = bound[std::min(p + 2 * width, parts)];
+                pool.emplace_back([&, lo, mid, hi] {
+                    std::inplace_merge(idx.begin() + lo, idx.begin() + mid, idx.begin() + hi, less);
+                });
+            }
+            for (auto& t : pool) t.join();
+        }
+    }
+
+    std::vector<T> sorted;
+    sorted.reserve(n);
+    for (uint32_t i : idx) sorted.push_back(std::move(items[i]));
+    items.swap(sorted);
+}
+
+// First element whose key is >= prefix (binary search, table sorted by key)
+template <typename T, typename KeyOf>
+size_t lowerBoundKey(const std::vector<T>& items, const std::string& prefix, KeyOf keyOf) {
+    size_t lo = 0, hi = items.size();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (keyLess(keyOf(items[mid]), prefix)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
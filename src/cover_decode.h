@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "stb_image.h"
+
+#ifdef PLANETARY_HAVE_TURBOJPEG
+#include <turbojpeg.h>
+#endif
+
+// ============================================================
+// COVER DECODE - embedded covers are often 1500-4000 px JPEGs, while a
+// planet or a 32 px sidebar row never shows more than a few hundred.
+// With libjpeg-turbo, JPEGs are decoded at 1/2, 1/4 or 1/8 scale in the
+// DCT domain on its SIMD paths, so the full-size image never exists.
+// PNGs, JPEGs turbo rejects (CMYK, say) and builds without it go
+// through stb_image. Either way the result is box-filtered to fit
+// maxSize before it's kept.
+// ============================================================
+
+static constexpr int COVER_MAX_SIZE = 256;
+
+// Box filter from w x h to dw x dh (each output pixel averages the
+// source pixels it covers)
+inline std::vector<uint8_t> boxDownscale(const uint8_t* src, int w, int h, int dw, int dh) {
+    std::vector<uint8_t> out((size_t)dw * dh * 4);
+    for (int y = 0; y < dh; y++) {
+        int y0 = y * h / dh, y1 = std::max(y0 + 1, (y + 1) * h / dh);
+        for (int x = 0; x < dw; x++) {
+            int x0 = x * w / dw, x1 = std::max(x0 + 1, (x + 1) * w / dw);
+            uint32_t sum[4] = {0, 0, 0, 0};
+            for (int sy = y0; sy < y1; sy++) {
+                const uint8_t* p = src + ((size_t)sy * w + x0) * 4;
+                for (int sx = x0; sx < x1; sx++, p += 4)
+                    for (int c = 0; c < 4; c++) sum[c] += p[c];
+            }
+            uint32_t n = (uint32_t)((y1 - y0) * (x1 - x0));
+            uint8_t* d = &out[((size_t)y * dw + x) * 4];
+            for (int c = 0; c < 4; c++) d[c] = (uint8_t)(sum[c] / n);
+        }
+    }
+    return out;
+}
+
+#ifdef PLANETARY_HAVE_TURBOJPEG
+// Smallest DCT scale that still covers maxSize, straight to RGBA
+inline bool decodeJpegScaled(const uint8_t* data, size_t size, int maxSize,
+                             std::vector<uint8_t>& out, int& w, int& h) {
+    // One handle per scanner thread
+    struct Handle {
+        tjhandle tj = tjInitDecompress();
+        ~Handle() { if (tj) tjDestroy(tj); }
+    };
+    thread_local Handle handle;
+    if (!handle.tj) return false;
+
+    int fw, fh, subsamp, colorspace;
+    unsigned char* buf = const_cast<unsigned char*>(data);
+    if (tjDecompressHeader3(handle.tj, buf, (unsigned long)size, &fw, &fh, &subsamp, &colorspace) != 0) return false;
+    if (colorspace == TJCS_CMYK || colorspace == TJCS_YCCK) return false;
+
+    int n = 0;
+    tjscalingfactor* factors = tjGetScalingFactors(&n);
+    int sw = fw, sh = fh;
+    for (int i = 0; i < n; i++) {
+        int tw = TJSCALED(fw, factors[i]), th = TJSCALED(fh, factors[i]);
+        if (tw > fw || std::max(tw, th) < maxSize) continue;
+        if ((size_t)tw * th < (size_t)sw * sh) { sw = tw; sh = th; }
+    }
+    out.resize((size_t)sw * sh * 4);
+    if (tjDecompress2(handle.tj, buf, (unsigned long)size, out.data(), sw, 0, sh, TJPF_RGBA,
+                      TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE) != 0) {
+        out.clear();
+        return false;
+    }
+    w = sw;
+    h = sh;
+    return true;
+}
+#endif
+
+// src (w x h RGBA) into px, box-filtered to fit maxSize; src may be px
+inline void fitCover(std::vector<uint8_t>& px, const uint8_t* src, int& w, int& h, int maxSize) {
+    if (std::max(w, h) <= maxSize) {
+        if (src != px.data()) px.assign(src, src + (size_t)w * h * 4);
+        return;
+    }
+    int dw = std::max(1, (int)((int64_t)w * maxSize / std::max(w, h)));
+    int dh = std::max(1, (int)((int64_t)h * maxSize / std::max(w, h)));
+    px = boxDownscale(src, w, h, dw, dh);
+    w = dw;
+    h = dh;
+}
+
+// Encoded cover (JPEG, PNG, ...) to RGBA no larger than maxSize on its
+// long side; empty when the data doesn't decode
+inline std::vector<uint8_t> decodeCover(const uint8_t* data, size_t size, int& w, int& h,
+                                        int maxSize = COVER_MAX_SIZE) {
+    std::vector<uint8_t> px;
+    w = h = 0;
+    if (!data || size == 0) return px;
+#ifdef PLANETARY_HAVE_TURBOJPEG
+    bool jpeg = size > 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF;
+    if (jpeg && decodeJpegScaled(data, size, maxSize, px, w, h)) {
+        fitCover(px, px.data(), w, h, maxSize);
+        return px;
+    }
+#endif
+    int ch;
+    unsigned char* img = stbi_load_from_memory(data, (int)size, &w, &h, &ch, 4);
+    if (!img) {
+        w = h = 0;
+        return px;
+    }
+    fitCover(px, img, w, h, maxSize);
+    stbi_image_free(img);
+    return px;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <string>
+#include <map>
+#include <functional>
+#include <cmath>
+
+// ============================================================
+// STAR POSITIONING - from NodeArtist.cpp setData()
+// Shared with planetary-indexer, which pins the result into galaxy
+// snapshots: std::hash differs between libstdc++ and libc++, so a
+// Shield recomputing positions would not draw the indexer's galaxy.
+// ============================================================
+// Genre -> angular sector mapping for spatial clustering. Sectors are
+// handed out in first-seen order, so one table spans one layout: the
+// indexer starts a fresh one per scan, the app keeps its own across
+// merged roots so stars don't move when a root lands.
+struct GenreAngles {
+    std::map<std::string, float> angles;
+    float next = 0;
+
+    float get(const std::string& genre) {
+        auto it = angles.find(genre);
+        if (it != angles.end()) return it->second;
+        float a = next;
+        next += 0.618f * 2.0f * M_PI; // golden angle separation
+        angles[genre] = a;
+        return a;
+    }
+};
+
+inline glm::vec3 starPosition(const std::string& name, const std::string& genre, GenreAngles& genres) {
+    std::hash<std::string> hasher;
+    size_t h = hasher(name);
+    float hashPer = (float)(h % 9000L) / 90.0f + 10.0f;
+    float spreadFactor = 3.0f;
+    hashPer *= spreadFactor;
+
+    // Base angle from genre cluster + offset from name hash
+    float genreBase = genres.get(genre);
+    float nameOffset = (float)(h % 628) / 100.0f; // 0 to ~6.28 (full circle)
+    float genreSpread = 0.8f; // How tight the cluster is (radians)
+    float angle = genreBase + nameOffset * genreSpread;
+
+    // Vertical from second hash
+    size_t h2 = hasher(name + "_y");
+    float yHash = ((float)(h2 % 10000) / 10000.0f - 0.5f) * 2.0f;
+    float height = yHash * hashPer * 0.35f;
+
+    return glm::vec3(cosf(angle) * hashPer, height, sinf(angle) * hashPer);
+}
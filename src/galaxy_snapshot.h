@@ -0,0 +1,633 @@
+#pragma once
+
+#include "music_data.h"
+#include "log.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ============================================================
+// GALAXY SNAPSHOT - a library prepared by planetary-indexer: artists,
+// albums and tracks with the star layout pinned, cover palettes and
+// per-track tempo / loudness, in one flat file the client maps and
+// walks. Covers live in a separate art pack of RGBA thumbnails keyed
+// by content hash and uploaded straight from the mapping, so a thin
+// client decodes no JPEGs. Each publish bumps the generation; a client
+// holding generation G fetches art/delta-G (only the art added since)
+// instead of the whole pack. Little-endian, same layout on every
+// 64-bit target (checked below).
+//   GET /version          current generation, as text
+//   GET /galaxy.snap      snapshot
+//   GET /art.pack         full art pack
+//   GET /art/delta-G      art added after generation G (404 once too old)
+//   GET /track/<id>.<ext> audio of local-root libraries
+// ============================================================
+
+static constexpr uint32_t SNAP_MAGIC = 0x4E534750;     // "PGSN"
+static constexpr uint32_t ARTPACK_MAGIC = 0x50414750;  // "PGAP"
+static constexpr uint32_t SNAP_FORMAT = 1;
+
+struct SnapStr { uint32_t off, len; };   // into the string table
+
+struct SnapHeader {
+    uint32_t magic, format;
+    uint64_t generation;
+    uint32_t artists, albums, tracks, stringBytes;
+};
+
+struct SnapArtist {
+    SnapStr name, sortKey, genre;
+    float pos[3];
+    uint32_t firstAlbum, numAlbums, totalTracks;
+};
+
+struct SnapAlbum {
+    SnapStr name, artist, id;
+    int32_t year;
+    uint32_t firstTrack, numTracks, pad;
+    uint64_t artHash;                // 0 = no art
+    ColorPalette palette;
+};
+
+struct SnapTrack {
+    SnapStr title, artist, path, id, genre;
+    int32_t trackNumber, year;
+    float duration, bpm, loudness;
+};
+
+struct ArtPackHeader {
+    uint32_t magic, format;
+    uint64_t generation;
+    uint64_t since;                  // 0 = full pack, else a delta
+    uint32_t size, count;            // thumbnails are size x size RGBA
+};
+
+struct ArtPackEntry { uint64_t hash, offset, addedGen; };   // sorted by hash
+
+static_assert(sizeof(ColorPalette) == 32, "snapshot layout");
+static_assert(sizeof(SnapHeader) == 32 && sizeof(SnapArtist) == 48, "snapshot layout");
+static_assert(sizeof(SnapAlbum) == 80 && sizeof(SnapTrack) == 60, "snapshot layout");
+static_assert(sizeof(ArtPackHeader) == 32 && sizeof(ArtPackEntry) == 24, "art pack layout");
+
+inline uint64_t fnv1a64(const void* data, size_t n, uint64_t h = 1469598103934665603ull) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < n; i++) { h ^= p[i]; h *= 1099511628211ull; }
+    return h;
+}
+
+// Read-only view of a whole file: mmap where there is one, else a copy
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const std::string& path) {
+        close();
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat st;
+        void* p = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+            p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        base = (const uint8_t*)p;
+        len = (size_t)st.st_size;
+        mapped = true;
+#else
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f) return false;
+        fseek(f, 0, SEEK_END);
+        long n = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        copy.resize(n > 0 ? (size_t)n : 0);
+        bool ok = n > 0 && fread(copy.data(), 1, copy.size(), f) == copy.size();
+        fclose(f);
+        if (!ok) { copy.clear(); return false; }
+        base = copy.data();
+        len = copy.size();
+#endif
+        return true;
+    }
+
+    void close() {
+#ifndef _WIN32
+        if (mapped) munmap((void*)base, len);
+#endif
+        mapped = false;
+        base = nullptr;
+        len = 0;
+        copy.clear();
+    }
+
+    const uint8_t* data() const { return base; }
+    size_t size() const { return len; }
+
+private:
+    const uint8_t* base = nullptr;
+    size_t len = 0;
+    bool mapped = false;
+    std::vector<uint8_t> copy;
+};
+
+// Writes through path.part so readers never see half a file
+inline bool writeFileAtomic(const std::string& path, const void* data, size_t n) {
+    std::string part = path + ".part";
+    FILE* f = fopen(part.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(data, 1, n, f) == n;
+    ok = fclose(f) == 0 && ok;
+#ifdef _WIN32
+    if (ok) std::remove(path.c_str());
+#endif
+    if (!ok || std::rename(part.c_str(), path.c_str()) != 0) {
+        std::remove(part.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ============================================================
+// SNAPSHOT FILE
+// ============================================================
+// Local track paths are written as given: the indexer turns them into
+// relative "track/<id>.<ext>" URLs first. Subsonic stream URLs carry
+// the account (u=, p=) and the snapshot is served to anyone on the LAN,
+// so remote tracks publish only their ID; clients build their own URL.
+inline std::string encodeSnapshot(const MusicLibrary& lib, uint64_t generation) {
+    std::vector<SnapArtist> artists;
+    std::vector<SnapAlbum> albums;
+    std::vector<SnapTrack> tracks;
+    std::string strings;
+    std::unordered_map<std::string, SnapStr> interned;   // artist / album / genre repeat per track
+    auto str = [&](const std::string& s) {
+        auto it = interned.find(s);
+        if (it != interned.end()) return it->second;
+        SnapStr r{(uint32_t)strings.size(), (uint32_t)s.size()};
+        strings += s;
+        interned.emplace(s, r);
+        return r;
+    };
+
+    for (auto& a : lib.artists) {
+        SnapArtist sa{};
+        sa.name = str(a.name);
+        sa.sortKey = str(a.sortKey);
+        sa.genre = str(a.primaryGenre);
+        memcpy(sa.pos, a.layoutPos, sizeof(sa.pos));
+        sa.firstAlbum = (uint32_t)albums.size();
+        sa.numAlbums = (uint32_t)a.albums.size();
+        sa.totalTracks = (uint32_t)a.totalTracks;
+        artists.push_back(sa);
+        for (auto& b : a.albums) {
+            SnapAlbum sb{};
+            sb.name = str(b.name);
+            sb.artist = str(b.artist);
+            sb.id = str(b.id);
+            sb.year = b.year;
+            sb.firstTrack = (uint32_t)tracks.size();
+            sb.numTracks = (uint32_t)b.tracks.size();
+            sb.artHash = b.artHash;
+            sb.palette = b.palette;
+            albums.push_back(sb);
+            for (auto& t : b.tracks) {
+                SnapTrack st{};
+                st.title = str(t.title);
+                st.artist = str(t.artist);
+                bool remote = t.filePath.find("://") != std::string::npos;
+                st.path = str(remote ? std::string() : t.filePath);
+                st.id = str(t.id);
+                st.genre = str(t.genre);
+                st.trackNumber = t.trackNumber;
+                st.year = t.year;
+                st.duration = t.duration;
+                st.bpm = t.bpm;
+                st.loudness = t.loudness;
+                tracks.push_back(st);
+            }
+        }
+    }
+
+    SnapHeader h{SNAP_MAGIC, SNAP_FORMAT, generation, (uint32_t)artists.size(), (uint32_t)albums.size(),
+                 (uint32_t)tracks.size(), (uint32_t)strings.size()};
+    std::string out;
+    out.reserve(sizeof(h) + artists.size() * sizeof(SnapArtist) + albums.size() * sizeof(SnapAlbum) +
+                tracks.size() * sizeof(SnapTrack) + strings.size());
+    out.append((const char*)&h, sizeof(h));
+    out.append((const char*)artists.data(), artists.size() * sizeof(SnapArtist));
+    out.append((const char*)albums.data(), albums.size() * sizeof(SnapAlbum));
+    out.append((const char*)tracks.data(), tracks.size() * sizeof(SnapTrack));
+    out += strings;
+    return out;
+}
+
+class GalaxySnapshot {
+public:
+    bool open(const std::string& path) {
+        close();
+        if (!file.open(path)) return false;
+        const uint8_t* p = file.data();
+        size_t n = file.size();
+        if (n < sizeof(SnapHeader)) return fail(path);
+        hdr = (const SnapHeader*)p;
+        if (hdr->magic != SNAP_MAGIC || hdr->format != SNAP_FORMAT) return fail(path);
+        uint64_t need = sizeof(SnapHeader) + (uint64_t)hdr->artists * sizeof(SnapArtist) +
+                        (uint64_t)hdr->albums * sizeof(SnapAlbum) + (uint64_t)hdr->tracks * sizeof(SnapTrack) +
+                        hdr->stringBytes;
+        if (need > n) return fail(path);
+        artists = (const SnapArtist*)(p + sizeof(SnapHeader));
+        albums = (const SnapAlbum*)(artists + hdr->artists);
+        tracks = (const SnapTrack*)(albums + hdr->albums);
+        strings = (const char*)(tracks + hdr->tracks);
+        return true;
+    }
+
+    void close() {
+        file.close();
+        hdr = nullptr;
+    }
+
+    bool isOpen() const { return hdr != nullptr; }
+    uint64_t generation() const { return hdr ? hdr->generation : 0; }
+    uint32_t albumCount() const { return hdr ? hdr->albums : 0; }
+    uint32_t trackCount() const { return hdr ? hdr->tracks : 0; }
+    const SnapAlbum& album(uint32_t i) const { return albums[i]; }
+    const SnapTrack& track(uint32_t i) const { return tracks[i]; }
+
+    std::string text(SnapStr s) const {
+        if ((uint64_t)s.off + s.len > hdr->stringBytes) return "";
+        return std::string(strings + s.off, s.len);
+    }
+
+    // Every cover the snapshot refers to, sorted, no repeats
+    std::vector<uint64_t> artHashes() const {
+        std::vector<uint64_t> h;
+        for (uint32_t i = 0; i < albumCount(); i++)
+            if (albums[i].artHash) h.push_back(albums[i].artHash);
+        std::sort(h.begin(), h.end());
+        h.erase(std::unique(h.begin(), h.end()), h.end());
+        return h;
+    }
+
+    // True when tracks are published as paths on the indexer's HTTP
+    // server (built without --local-paths): only its URL can play them
+    bool servedTracks() const {
+        for (uint32_t i = 0; i < trackCount(); i++) {
+            std::string p = text(tracks[i].path);
+            if (!p.empty() && p.find("://") == std::string::npos && p[0] != '/') return true;
+        }
+        return false;
+    }
+
+    // Relative track paths are resolved against trackBase (the server
+    // URL); remote tracks have only an ID, streamUrl(id) signs it with
+    // the client's own account (no streamUrl: they stay unplayable)
+    MusicLibrary toLibrary(const std::string& trackBase,
+                           const std::function<std::string(const std::string&)>& streamUrl = nullptr) const {
+        MusicLibrary lib;
+        if (!hdr) return lib;
+        lib.artists.reserve(hdr->artists);
+        for (uint32_t i = 0; i < hdr->artists; i++) {
+            const SnapArtist& sa = artists[i];
+            if ((uint64_t)sa.firstAlbum + sa.numAlbums > hdr->albums) break;
+            ArtistData a;
+            a.name = text(sa.name);
+            a.sortKey = text(sa.sortKey);
+            a.primaryGenre = text(sa.genre);
+            a.hasLayout = true;
+            memcpy(a.layoutPos, sa.pos, sizeof(a.layoutPos));
+            a.albums.resize(sa.numAlbums);
+            for (uint32_t bi = 0; bi < sa.numAlbums; bi++) {
+                const SnapAlbum& sb = albums[sa.firstAlbum + bi];
+                if ((uint64_t)sb.firstTrack + sb.numTracks > hdr->tracks) continue;
+                AlbumData& b = a.albums[bi];
+                b.name = text(sb.name);
+                b.artist = text(sb.artist);
+                b.id = text(sb.id);
+                b.year = sb.year;
+                b.artHash = sb.artHash;
+                b.palette = sb.palette;
+                b.tracks.resize(sb.numTracks);
+                for (uint32_t ti = 0; ti < sb.numTracks; ti++) {
+                    const SnapTrack& st = tracks[sb.firstTrack + ti];
+                    TrackData& t = b.tracks[ti];
+                    t.filePath = text(st.path);
+                    t.id = text(st.id);
+                    if (t.filePath.empty()) {
+                        if (streamUrl && !t.id.empty()) t.filePath = streamUrl(t.id);
+                    } else if (t.filePath.find("://") == std::string::npos && t.filePath.rfind('/', 0) != 0) {
+                        t.filePath = trackBase + t.filePath;
+                    }
+                    t.title = text(st.title);
+                    t.artist = text(st.artist);
+                    t.album = b.name;
+                    t.albumArtist = a.name;
+                    t.trackNumber = st.trackNumber;
+                    t.year = st.year;
+                    t.genre = text(st.genre);
+                    t.duration = st.duration;
+                    t.bpm = st.bpm;
+                    t.loudness = st.loudness;
+                }
+                a.totalTracks += (int)b.tracks.size();
+            }
+            lib.totalAlbums += (int)a.albums.size();
+            lib.totalTracks += a.totalTracks;
+            lib.artists.push_back(std::move(a));
+        }
+        return lib;
+    }
+
+private:
+    MappedFile file;
+    const SnapHeader* hdr = nullptr;
+    const SnapArtist* artists = nullptr;
+    const SnapAlbum* albums = nullptr;
+    const SnapTrack* tracks = nullptr;
+    const char* strings = nullptr;
+
+    bool fail(const std::string& path) {
+        LOG_WARN("Snapshot") << "Not a usable snapshot: " << path;
+        close();
+        return false;
+    }
+};
+
+// ============================================================
+// ART PACK
+// ============================================================
+class ArtPack {
+public:
+    bool open(const std::string& path) {
+        close();
+        if (!file.open(path) || file.size() < sizeof(ArtPackHeader)) return false;
+        const ArtPackHeader* h = (const ArtPackHeader*)file.data();
+        uint64_t bytes = (uint64_t)h->size * h->size * 4;
+        if (h->magic != ARTPACK_MAGIC || h->format != SNAP_FORMAT ||
+            sizeof(ArtPackHeader) + (uint64_t)h->count * sizeof(ArtPackEntry) > file.size()) {
+            LOG_WARN("Snapshot") << "Not a usable art pack: " << path;
+            file.close();
+            return false;
+        }
+        entries = (const ArtPackEntry*)(file.data() + sizeof(ArtPackHeader));
+        for (uint32_t i = 0; i < h->count; i++)
+            if (entries[i].offset + bytes > file.size()) {
+                LOG_WARN("Snapshot") << "Truncated art pack: " << path;
+                file.close();
+                return false;
+            }
+        hdr = h;
+        return true;
+    }
+
+    void close() {
+        file.close();
+        hdr = nullptr;
+    }
+
+    bool isOpen() const { return hdr != nullptr; }
+    uint64_t generation() const { return hdr ? hdr->generation : 0; }
+    uint64_t since() const { return hdr ? hdr->since : 0; }
+    int size() const { return hdr ? (int)hdr->size : 0; }
+    uint32_t count() const { return hdr ? hdr->count : 0; }
+    const ArtPackEntry& entry(uint32_t i) const { return entries[i]; }
+    const uint8_t* pixels(const ArtPackEntry& e) const { return file.data() + e.offset; }
+
+    const ArtPackEntry* find(uint64_t hash) const {
+        if (!hdr) return nullptr;
+        const ArtPackEntry* end = entries + hdr->count;
+        const ArtPackEntry* e = std::lower_bound(entries, end, hash,
+            [](const ArtPackEntry& a, uint64_t h) { return a.hash < h; });
+        return e != end && e->hash == hash ? e : nullptr;
+    }
+
+    // size x size RGBA, or null
+    const uint8_t* image(uint64_t hash) const {
+        const ArtPackEntry* e = find(hash);
+        return e ? pixels(*e) : nullptr;
+    }
+
+private:
+    MappedFile file;
+    const ArtPackHeader* hdr = nullptr;
+    const ArtPackEntry* entries = nullptr;
+};
+
+struct ArtPackItem {
+    uint64_t hash, addedGen;
+    const uint8_t* rgba;             // size x size x 4
+};
+
+inline bool writeArtPack(const std::string& path, uint64_t generation, uint64_t since, int size,
+                         std::vector<ArtPackItem> items) {
+    std::sort(items.begin(), items.end(), [](const ArtPackItem& a, const ArtPackItem& b) { return a.hash < b.hash; });
+    size_t bytes = (size_t)size * size * 4;
+    uint64_t offset = (sizeof(ArtPackHeader) + items.size() * sizeof(ArtPackEntry) + 63) & ~63ull;
+    ArtPackHeader h{ARTPACK_MAGIC, SNAP_FORMAT, generation, since, (uint32_t)size, (uint32_t)items.size()};
+    std::vector<ArtPackEntry> index;
+    for (size_t i = 0; i < items.size(); i++)
+        index.push_back({items[i].hash, offset + i * bytes, items[i].addedGen});
+
+    std::string part = path + ".part";
+    FILE* f = fopen(part.c_str(), "wb");
+    if (!f) return false;
+    static const char zeros[64] = {};
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    if (!index.empty()) ok = ok && fwrite(index.data(), sizeof(ArtPackEntry), index.size(), f) == index.size();
+    size_t head = sizeof(h) + index.size() * sizeof(ArtPackEntry);
+    ok = ok && fwrite(zeros, 1, (size_t)offset - head, f) == (size_t)offset - head;
+    for (auto& it : items) ok = ok && fwrite(it.rgba, 1, bytes, f) == bytes;
+    ok = fclose(f) == 0 && ok;
+#ifdef _WIN32
+    if (ok) std::remove(path.c_str());
+#endif
+    if (!ok || std::rename(part.c_str(), path.c_str()) != 0) {
+        std::remove(part.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ============================================================
+// CLIENT SYNC - HTTP only (the indexer serves the LAN); POSIX
+// ============================================================
+#ifndef _WIN32
+
+// GET into body, or into file (replaced only once complete). False on
+// anything but a whole 200 response.
+inline bool snapshotHttpGet(const std::string& url, std::string* body, const std::string& file = "",
+                            int timeoutSec = 15) {
+    std::string u = url.rfind("http://", 0) == 0 ? url.substr(7) : url;
+    size_t slash = u.find('/');
+    std::string hostPort = u.substr(0, slash);
+    std::string path = slash == std::string::npos ? "/" : u.substr(slash);
+    size_t colon = hostPort.find(':');
+    std::string host = hostPort.substr(0, colon);
+    std::string port = colon == std::string::npos ? "80" : hostPort.substr(colon + 1);
+
+    addrinfo hints{}, *res = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0) {
+        LOG_WARN("Snapshot") << "Cannot resolve " << host;
+        return false;
+    }
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    timeval tv{timeoutSec, 0};
+    bool connected = fd >= 0 && setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == 0 &&
+                     setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv)) == 0 &&
+                     connect(fd, res->ai_addr, res->ai_addrlen) == 0;
+#ifdef SO_NOSIGPIPE
+    // No MSG_NOSIGNAL on macOS: a server that hangs up mid-request must not kill us
+    int one = 1;
+    if (connected) setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    freeaddrinfo(res);
+    if (!connected) {
+        if (fd >= 0) close(fd);
+        LOG_WARN("Snapshot") << "Cannot connect to " << hostPort;
+        return false;
+    }
+    std::string req = "GET " + path + " HTTP/1.0\r\nHost: " + hostPort + "\r\nConnection: close\r\n\r\n";
+#ifdef MSG_NOSIGNAL
+    int sendFlags = MSG_NOSIGNAL;
+#else
+    int sendFlags = 0;
+#endif
+    if (send(fd, req.data(), req.size(), sendFlags) != (ssize_t)req.size()) {
+        close(fd);
+        return false;
+    }
+
+    std::string head;
+    char buf[64 * 1024];
+    ssize_t n = 0;
+    size_t headEnd;
+    while ((headEnd = head.find("\r\n\r\n")) == std::string::npos && head.size() < 16384) {
+        if ((n = recv(fd, buf, sizeof(buf), 0)) <= 0) break;
+        head.append(buf, (size_t)n);
+    }
+    int status = 0;
+    if (headEnd != std::string::npos) sscanf(head.c_str(), "HTTP/%*d.%*d %d", &status);
+    if (status != 200) {
+        close(fd);
+        if (status != 404) LOG_WARN("Snapshot") << url << ": HTTP " << status;
+        return false;
+    }
+    int64_t length = -1;
+    std::string lower = head.substr(0, headEnd);
+    for (char& c : lower) c = (char)tolower((unsigned char)c);
+    size_t cl = lower.find("\r\ncontent-length:");
+    if (cl != std::string::npos) length = strtoll(lower.c_str() + cl + 17, nullptr, 10);
+
+    std::string part = file + ".part";
+    FILE* out = file.empty() ? nullptr : fopen(part.c_str(), "wb");
+    if (!file.empty() && !out) {
+        close(fd);
+        return false;
+    }
+    int64_t got = 0;
+    bool ok = true;
+    auto sink = [&](const char* p, size_t len) {
+        got += (int64_t)len;
+        if (out) ok = ok && fwrite(p, 1, len, out) == len;
+        else if (body) body->append(p, len);
+    };
+    if (body) body->clear();
+    sink(head.data() + headEnd + 4, head.size() - headEnd - 4);
+    while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) sink(buf, (size_t)n);
+    close(fd);
+    ok = ok && n == 0 && (length < 0 || got == length);
+    if (out) {
+        ok = fclose(out) == 0 && ok;
+        if (!ok || std::rename(part.c_str(), file.c_str()) != 0) {
+            std::remove(part.c_str());
+            ok = false;
+        }
+    }
+    if (!ok) LOG_WARN("Snapshot") << url << ": incomplete (" << got << " bytes)";
+    return ok;
+}
+
+// New pack at path from the old one plus a delta, holding exactly the
+// covers snap refers to. False if either lacks one (full fetch then).
+inline bool mergeArtPack(const ArtPack& old, const ArtPack& delta, const GalaxySnapshot& snap, const std::string& path) {
+    std::vector<ArtPackItem> items;
+    for (uint64_t hash : snap.artHashes()) {
+        const ArtPack* from = delta.find(hash) ? &delta : old.find(hash) ? &old : nullptr;
+        if (!from) return false;
+        const ArtPackEntry* e = from->find(hash);
+        items.push_back({hash, e->addedGen, from->pixels(*e)});
+    }
+    return writeArtPack(path, delta.generation(), 0, delta.size(), std::move(items));
+}
+
+// Brings dir/galaxy.snap and dir/art.pack up to the server's generation.
+// An unreachable server with a cached snapshot is fine: the cache loads.
+inline bool syncSnapshot(const std::string& serverUrl, const std::string& dir) {
+    std::string base = serverUrl.back() == '/' ? serverUrl : serverUrl + "/";
+    std::string snapPath = dir + "galaxy.snap", packPath = dir + "art.pack";
+    mkdir(dir.c_str(), 0755);
+
+    GalaxySnapshot cached;
+    ArtPack art;
+    bool haveSnap = cached.open(snapPath);
+    bool haveArt = art.open(packPath);
+    std::string version;
+    if (!snapshotHttpGet(base + "version", &version)) {
+        if (haveSnap) LOG_WARN("Snapshot") << base << " unreachable; using cached generation " << cached.generation();
+        return haveSnap;
+    }
+    uint64_t remote = strtoull(version.c_str(), nullptr, 10);
+    if (haveSnap && cached.generation() == remote && art.generation() == remote) {
+        LOG_INFO("Snapshot") << "Generation " << remote << " is current";
+        return true;
+    }
+    cached.close();
+
+    if (!snapshotHttpGet(base + "galaxy.snap", nullptr, snapPath)) return haveSnap;
+    GalaxySnapshot fresh;
+    if (!fresh.open(snapPath)) return false;
+    if (haveArt && art.generation() == fresh.generation()) return true;
+
+    if (haveArt) {
+        std::string deltaPath = dir + "art.delta";
+        bool merged = false;
+        if (snapshotHttpGet(base + "art/delta-" + std::to_string(art.generation()), nullptr, deltaPath)) {
+            ArtPack delta;
+            merged = delta.open(deltaPath) && delta.size() == art.size() && mergeArtPack(art, delta, fresh, packPath);
+            if (merged)
+                LOG_INFO("Snapshot") << "Generation " << art.generation() << " -> " << delta.generation() << ": "
+                                     << delta.count() << " new covers";
+        }
+        std::remove(deltaPath.c_str());
+        if (merged) return true;
+    }
+    art.close();
+    if (!snapshotHttpGet(base + "art.pack", nullptr, packPath))
+        LOG_WARN("Snapshot") << "No art pack; the galaxy loads without covers";
+    LOG_INFO("Snapshot") << "Fetched generation " << fresh.generation();
+    return true;
+}
+
+#endif // !_WIN32
@@ -0,0 +1,308 @@
+#pragma once
+
+#include "music_data.h"
+#include "log.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+
+// ============================================================
+// LIBRARY ROOTS - several music folders merged into one galaxy.
+// Each root gets its own scanner with a concurrency suited to the
+// device it lives on, and its own tag cache, so a slow NAS never
+// holds back the local SSD: whichever root finishes first is shown
+// first and the rest fold in as they complete.
+// ============================================================
+
+enum class DeviceClass { Unknown, SSD, HDD, Network };
+
+inline const char* deviceClassName(DeviceClass d) {
+    switch (d) {
+        case DeviceClass::SSD: return "ssd";
+        case DeviceClass::HDD: return "hdd";
+        case DeviceClass::Network: return "net";
+        default: return "auto";
+    }
+}
+
+// Tag readers in flight per root. SSDs handle a deep queue, spinning
+// disks thrash past one reader, network mounts need many requests in
+// flight to hide round-trip latency.
+inline int scanConcurrency(DeviceClass d) {
+    switch (d) {
+        case DeviceClass::SSD: return 8;
+        case DeviceClass::HDD: return 1;
+        case DeviceClass::Network: return 16;
+        default: return 4;
+    }
+}
+
+struct LibraryRoot {
+    std::string path;
+    DeviceClass device = DeviceClass::Unknown;  // Unknown = detect at scan time
+};
+
+// Config line: "/music" or "hdd=/mnt/archive" (ssd=, hdd=, net=, auto=)
+inline LibraryRoot parseRootLine(const std::string& line) {
+    LibraryRoot root;
+    root.path = line;
+    size_t eq = line.find('=');
+    if (eq != std::string::npos && eq <= 4) {
+        std::string tag = line.substr(0, eq);
+        for (DeviceClass d : {DeviceClass::SSD, DeviceClass::HDD, DeviceClass::Network, DeviceClass::Unknown}) {
+            if (tag == deviceClassName(d)) {
+                root.device = d;
+                root.path = line.substr(eq + 1);
+                break;
+            }
+        }
+    }
+    return root;
+}
+
+inline std::string formatRootLine(const LibraryRoot& root) {
+    if (root.device == DeviceClass::Unknown) return root.path;
+    return std::string(deviceClassName(root.device)) + "=" + root.path;
+}
+
+#ifndef __ANDROID__
+
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/statfs.h>
+#include <sys/sysmacros.h>
+#endif
+
+// Best-effort device detection. Network filesystems by statfs magic,
+// rotational vs solid-state from sysfs. Anything else stays Unknown.
+inline DeviceClass detectDeviceClass(const std::string& path) {
+#ifdef __linux__
+    struct statfs sfs;
+    if (statfs(path.c_str(), &sfs) == 0) {
+        switch ((unsigned long)sfs.f_type) {
+            case 0x6969:        // NFS
+            case 0xFF534D42:    // CIFS
+            case 0xFE534D42:    // SMB2
+            case 0x517B:        // SMB
+            case 0x65735546:    // FUSE (sshfs, rclone, ...)
+                return DeviceClass::Network;
+        }
+    }
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return DeviceClass::Unknown;
+    std::string dev = "/sys/dev/block/" + std::to_string(major(st.st_dev)) + ":" +
+                      std::to_string(minor(st.st_dev));
+    // Partitions don't carry a queue/ directory; their parent disk does
+    for (const char* rel : {"/queue/rotational", "/../queue/rotational"}) {
+        std::ifstream f(dev + rel);
+        int rotational;
+        if (f >> rotational) return rotational ? DeviceClass::HDD : DeviceClass::SSD;
+    }
+#else
+    (void)path;
+#endif
+    return DeviceClass::Unknown;
+}
+
+// ============================================================
+// TAG CACHE - one file per root, keyed by path + mtime + size.
+// Unchanged files skip TagLib entirely on rescans.
+// ============================================================
+class RootTagCache {
+public:
+    struct Entry {
+        int64_t mtime = 0;
+        int64_t size = 0;
+        TrackData track;
+    };
+
+    void load(const std::string& file) {
+        path = file;
+        std::ifstream in(file);
+        std::string line;
+        while (std::getline(in, line)) {
+            std::vector<std::string> f;
+            std::stringstream ss(line);
+            std::string field;
+            while (std::getline(ss, field, '\t')) f.push_back(field);
+            if (f.size() != 10) continue;
+            Entry e;
+            e.mtime = std::atoll(f[1].c_str());
+            e.size = std::atoll(f[2].c_str());
+            e.track.filePath = f[0];
+            e.track.title = f[3];
+            e.track.artist = f[4];
+            e.track.album = f[5];
+            e.track.trackNumber = std::atoi(f[6].c_str());
+            e.track.year = std::atoi(f[7].c_str());
+            e.track.genre = f[8];
+            e.track.duration = (float)std::atof(f[9].c_str());
+            e.track.albumArtist = e.track.artist;
+            entries[f[0]] = std::move(e);
+        }
+    }
+
+    const TrackData* lookup(const std::string& file, int64_t mtime, int64_t size) const {
+        auto it = entries.find(file);
+        if (it == entries.end() || it->second.mtime != mtime || it->second.size != size) return nullptr;
+        return &it->second.track;
+    }
+
+    // Rewrite the cache with exactly the files seen this scan
+    void save(const std::vector<Entry>& seen) const {
+        if (path.empty()) return;
+        std::ofstream out(path, std::ios::trunc);
+        auto clean = [](std::string s) {
+            for (char& c : s) if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+            return s;
+        };
+        for (auto& e : seen) {
+            const TrackData& t = e.track;
+            out << clean(t.filePath) << '\t' << e.mtime << '\t' << e.size << '\t'
+                << clean(t.title) << '\t' << clean(t.artist) << '\t' << clean(t.album) << '\t'
+                << t.trackNumber << '\t' << t.year << '\t' << clean(t.genre) << '\t'
+                << t.duration << '\n';
+        }
+    }
+
+private:
+    std::string path;
+    std::map<std::string, Entry> entries;
+};
+
+inline std::string rootCacheFile(const std::string& cacheDir, const std::string& rootPath) {
+    // FNV-1a of the root path: stable, filesystem-safe name
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : rootPath) { h ^= c; h *= 1099511628211ull; }
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.tags", (unsigned long long)h);
+    return cacheDir + name;
+}
+
+// ============================================================
+// SCANNER - one thread (plus its reader pool) per root. Finished
+// roots are handed back through poll() for the main thread to merge.
+// ============================================================
+class LibraryScanner {
+public:
+    ~LibraryScanner() { stop(); }
+
+    void addRoot(const LibraryRoot& root, const std::string& cacheDir) {
+        auto job = std::make_unique<Job>();
+        job->root = root;
+        Job* j = job.get();
+        jobs.push_back(std::move(job));
+        j->thread = std::thread([this, j, cacheDir] { run(*j, cacheDir); });
+    }
+
+    // Libraries from roots that finished since the last call
+    bool poll(std::vector<MusicLibrary>& out) {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        if (ready.empty()) return false;
+        for (auto& lib : ready) out.push_back(std::move(lib));
+        ready.clear();
+        return true;
+    }
+
+    bool busy() const {
+        for (auto& j : jobs) if (!j->finished) return true;
+        return false;
+    }
+
+    // Summed over roots still scanning
+    void progress(int& done, int& total) const {
+        done = total = 0;
+        for (auto& j : jobs) {
+            if (j->finished) continue;
+            done += j->done;
+            total += j->total;
+        }
+    }
+
+    void stop() {
+        cancel = true;
+        for (auto& j : jobs) if (j->thread.joinable()) j->thread.join();
+        jobs.clear();
+        cancel = false;
+    }
+
+private:
+    struct Job {
+        LibraryRoot root;
+        std::thread thread;
+        std::atomic<int> done{0};
+        std::atomic<int> total{0};
+        std::atomic<bool> finished{false};
+    };
+
+    void run(Job& job, const std::string& cacheDir) {
+        DeviceClass device = job.root.device;
+        if (device == DeviceClass::Unknown) device = detectDeviceClass(job.root.path);
+        int workers = scanConcurrency(device);
+
+        auto files = scanDirectory(job.root.path);
+        // One head on a spinning disk: read in directory order to keep seeks short
+        if (device == DeviceClass::HDD) std::sort(files.begin(), files.end());
+        job.total = (int)files.size();
+        LOG_INFO("Library") << job.root.path << ": " << files.size() << " files, "
+                            << deviceClassName(device) << ", " << workers << " reader(s)";
+
+        RootTagCache cache;
+        cache.load(rootCacheFile(cacheDir, job.root.path));
+
+        std::vector<RootTagCache::Entry> entries(files.size());
+        std::atomic<size_t> next{0};
+        std::atomic<int> hits{0};
+        auto reader = [&] {
+            for (size_t i; (i = next++) < files.size() && !cancel; ) {
+                auto& e = entries[i];
+                struct stat st;
+                if (stat(files[i].c_str(), &st) == 0) {
+                    e.mtime = (int64_t)st.st_mtime;
+                    e.size = (int64_t)st.st_size;
+                }
+                if (const TrackData* cached = cache.lookup(files[i], e.mtime, e.size)) {
+                    e.track = *cached;
+                    hits++;
+                } else {
+                    e.track = readTrackTags(files[i]);
+                }
+                job.done++;
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int i = 1; i < workers && i < (int)files.size(); i++) pool.emplace_back(reader);
+        reader();
+        for (auto& t : pool) t.join();
+
+        if (!cancel) {
+            cache.save(entries);
+            std::vector<TrackData> tracks;
+            tracks.reserve(entries.size());
+            for (auto& e : entries) tracks.push_back(std::move(e.track));
+            MusicLibrary lib = buildLibrary(std::move(tracks));
+            LOG_INFO("Library") << job.root.path << ": " << lib.artists.size() << " artists, "
+                                << lib.totalAlbums << " albums, " << lib.totalTracks << " tracks ("
+                                << hits << " cached)";
+            std::lock_guard<std::mutex> lock(readyMutex);
+            ready.push_back(std::move(lib));
+        }
+        job.finished = true;
+    }
+
+    std::vector<std::unique_ptr<Job>> jobs;
+    std::mutex readyMutex;
+    std::vector<MusicLibrary> ready;
+    std::atomic<bool> cancel{false};
+};
+
+#endif // !__ANDROID__
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <string>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <type_traits>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <cstdint>
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#endif
+
+// ============================================================
+// LOG - asynchronous logger. Callers format straight into a slot of a
+// lock-free ring (no allocation, no I/O, no flush); a background thread
+// writes the slots to the sinks: logcat on Android, stderr elsewhere,
+// plus a file when PLANETARY_LOG_FILE is set. When the ring is full the
+// message is dropped and counted, never waited on.
+//   LOG_INFO("Audio") << "Playing: " << name;
+//   logPrintf(LogLevel::Warn, "HTTP", "Failed to connect to %s", host);
+// PLANETARY_LOG_LEVEL=debug|info|warn|error sets the threshold (info).
+// Each category may log 50 lines per second; the rest are counted and
+// the count is shown on the next line that gets through.
+// ============================================================
+
+enum class LogLevel : uint8_t { Debug, Info, Warn, Error };
+
+class Logger {
+public:
+    static constexpr size_t TEXT = 480;      // longer lines are split
+    static constexpr size_t SLOTS = 1024;    // power of two
+    static constexpr uint32_t PER_SECOND = 50;
+
+    static Logger& get() {
+        static Logger logger;
+        return logger;
+    }
+
+    bool enabled(LogLevel level) const { return (int)level >= minLevel.load(std::memory_order_relaxed); }
+    void setLevel(LogLevel level) { minLevel = (int)level; }
+
+    // Appends to path as well as the console sink
+    bool openFile(const std::string& path) {
+        FILE* f = fopen(path.c_str(), "a");
+        if (!f) return false;
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        if (file) fclose(file);
+        file = f;
+        return true;
+    }
+
+    void write(LogLevel level, const char* category, const char* text, size_t len) {
+        if (!enabled(level)) return;
+        uint32_t suppressed = 0;
+        if (!admit(category, suppressed)) return;
+        // Split long text (shader logs) at newlines or the slot size
+        do {
+            size_t n = std::min(len, TEXT);
+            const char* nl = (const char*)memchr(text, '\n', n);
+            if (nl) n = (size_t)(nl - text);
+            push(level, category, text, n, suppressed);
+            suppressed = 0;
+            if (nl) n++;
+            text += n;
+            len -= n;
+        } while (len > 0);
+        if (level >= LogLevel::Warn) wake.notify_one();
+    }
+
+    // Wait (briefly) until everything logged so far has been written
+    void flush() {
+        size_t target = enqueuePos.load(std::memory_order_acquire);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (written.load(std::memory_order_acquire) < target && std::chrono::steady_clock::now() < deadline) {
+            wake.notify_one();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    uint64_t dropped() const { return droppedCount.load(); }
+
+    ~Logger() {
+        running = false;
+        wake.notify_one();
+        if (worker.joinable()) worker.join();
+        if (file) fclose(file);
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> seq{0};
+        LogLevel level;
+        uint32_t suppressed;
+        uint64_t micros;
+        char category[16];
+        uint16_t len;
+        char text[TEXT];
+    };
+    struct Bucket {
+        std::atomic<uint64_t> second{0};
+        std::atomic<uint32_t> count{0};
+        std::atomic<uint32_t> suppressed{0};
+    };
+
+    Slot slots[SLOTS];
+    Bucket buckets[32];
+    std::atomic<size_t> enqueuePos{0};
+    size_t dequeuePos = 0;
+    std::atomic<size_t> written{0};
+    std::atomic<uint64_t> droppedCount{0};
+    std::atomic<int> minLevel{(int)LogLevel::Info};
+    std::atomic<bool> running{true};
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::mutex wakeMutex, sinkMutex;
+    std::condition_variable wake;
+    FILE* file = nullptr;
+    std::thread worker;
+
+    Logger() {
+        for (size_t i = 0; i < SLOTS; i++) slots[i].seq.store(i, std::memory_order_relaxed);
+        if (const char* lvl = std::getenv("PLANETARY_LOG_LEVEL")) {
+            std::string l = lvl;
+            if (l == "debug") setLevel(LogLevel::Debug);
+            else if (l == "warn") setLevel(LogLevel::Warn);
+            else if (l == "error") setLevel(LogLevel::Error);
+        }
+        if (const char* path = std::getenv("PLANETARY_LOG_FILE"))
+            if (*path && !openFile(path)) fprintf(stderr, "[Log] Cannot open %s\n", path);
+        worker = std::thread([this] { run(); });
+    }
+
+    uint64_t micros() const {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Fixed one-second window per category (hashed, so rare collisions share)
+    bool admit(const char* category, uint32_t& suppressed) {
+        uint32_t h = 2166136261u;
+        for (const char* c = category; *c; c++) { h ^= (unsigned char)*c; h *= 16777619u; }
+        Bucket& b = buckets[h & 31];
+        uint64_t sec = micros() / 1000000;
+        uint64_t prev = b.second.load(std::memory_order_relaxed);
+        if (prev != sec && b.second.compare_exchange_strong(prev, sec)) b.count = 0;
+        if (b.count.fetch_add(1, std::memory_order_relaxed) >= PER_SECOND) {
+            b.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = b.suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Bounded MPMC ring (Vyukov): claim a position, fill, publish via seq
+    void push(LogLevel level, const char* category, const char* text, size_t len, uint32_t suppressed) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Slot* s;
+        for (;;) {
+            s = &slots[pos & (SLOTS - 1)];
+            intptr_t dif = (intptr_t)s->seq.load(std::memory_order_acquire) - (intptr_t)pos;
+            if (dif == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        s->level = level;
+        s->suppressed = suppressed;
+        s->micros = micros();
+        strncpy(s->category, category, sizeof(s->category) - 1);
+        s->category[sizeof(s->category) - 1] = '\0';
+        s->len = (uint16_t)len;
+        memcpy(s->text, text, len);
+        s->seq.store(pos + 1, std::memory_order_release);
+    }
+
+    void run() {
+        std::string console, toFile;
+        uint64_t reportedDrops = 0;
+        for (;;) {
+            bool stopping = !running.load();
+            console.clear();
+            toFile.clear();
+            // openFile may swap the file meanwhile; a batch formats for
+            // whatever was open when it started
+            bool fileOpen;
+            {
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                fileOpen = file != nullptr;
+            }
+            size_t n = 0;
+            for (;;) {
+                Slot& s = slots[dequeuePos & (SLOTS - 1)];
+                if (s.seq.load(std::memory_order_acquire) != dequeuePos + 1) break;
+                format(s, console, fileOpen ? &toFile : nullptr);
+                s.seq.store(dequeuePos + SLOTS, std::memory_order_release);
+                dequeuePos++;
+                n++;
+            }
+            uint64_t drops = droppedCount.load();
+            if (drops != reportedDrops) {
+                std::string line = "[Log] " + std::to_string(drops - reportedDrops) + " lines dropped (ring full)\n";
+                console += line;
+                if (fileOpen) toFile += line;
+                reportedDrops = drops;
+            }
+#ifndef __ANDROID__
+            if (!console.empty()) {
+                fwrite(console.data(), 1, console.size(), stderr);
+                fflush(stderr);
+            }
+#endif
+            // Independent of the console: on Android that is logcat and
+            // console stays empty
+            if (!toFile.empty()) {
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                if (file) {
+                    fwrite(toFile.data(), 1, toFile.size(), file);
+                    fflush(file);
+                }
+            }
+            written.fetch_add(n, std::memory_order_release);
+            if (stopping) break;
+            if (n == 0) {
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                wake.wait_for(lock, std::chrono::milliseconds(20));
+            }
+        }
+    }
+
+    // toFile = nullptr: no log file open
+    void format(const Slot& s, std::string& console, std::string* toFile) {
+        std::string line = "[" + std::string(s.category) + "] ";
+        line.append(s.text, s.len);
+        if (s.suppressed) line += " (+" + std::to_string(s.suppressed) + " suppressed)";
+#ifdef __ANDROID__
+        static const int prio[] = { ANDROID_LOG_DEBUG, ANDROID_LOG_INFO, ANDROID_LOG_WARN, ANDROID_LOG_ERROR };
+        __android_log_write(prio[(int)s.level], "Planetary", line.c_str());
+#else
+        console += line;
+        console += '\n';
+#endif
+        if (toFile) {
+            char stamp[48];
+            snprintf(stamp, sizeof(stamp), "%10.3f %c ", (double)s.micros / 1e6, "DIWE"[(int)s.level]);
+            *toFile += stamp;
+            *toFile += line;
+            *toFile += '\n';
+        }
+    }
+};
+
+// One log line, formatted on the caller's stack and handed to the ring
+// when the statement ends
+class LogLine {
+public:
+    LogLine(LogLevel level, const char* category) : level(level), category(category) {}
+    ~LogLine() { Logger::get().write(level, category, buf, len); }
+
+    LogLine& operator<<(const char* s) { return append(s ? s : "(null)", s ? strlen(s) : 6); }
+    LogLine& operator<<(const unsigned char* s) { return *this << (const char*)s; }
+    LogLine& operator<<(const std::string& s) { return append(s.data(), s.size()); }
+    LogLine& operator<<(char c) { return append(&c, 1); }
+    LogLine& operator<<(double v) { return print("%g", v); }
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, LogLine&>::type operator<<(T v) {
+        return std::is_signed<T>::value ? print("%lld", (long long)v) : print("%llu", (unsigned long long)v);
+    }
+    template <typename T>
+    LogLine& operator<<(const std::atomic<T>& v) { return *this << v.load(); }
+
+private:
+    LogLevel level;
+    const char* category;
+    char buf[2048];
+    size_t len = 0;
+
+    LogLine& append(const char* s, size_t n) {
+        n = std::min(n, sizeof(buf) - len);
+        memcpy(buf + len, s, n);
+        len += n;
+        return *this;
+    }
+    template <typename T>
+    LogLine& print(const char* fmt, T v) {
+        int n = snprintf(buf + len, sizeof(buf) - len, fmt, v);
+        if (n > 0) len = std::min(sizeof(buf) - 1, len + (size_t)n);
+        return *this;
+    }
+};
+
+inline void logPrintf(LogLevel level, const char* category, const char* fmt, ...) {
+    if (!Logger::get().enabled(level)) return;
+    char buf[2048];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n > 0) Logger::get().write(level, category, buf, std::min((size_t)n, sizeof(buf) - 1));
+}
+
+// Skips formatting below the threshold. The ternary (rather than an
+// if/else) keeps "if (x) LOG_ERROR(...) << ...;" free of dangling elses;
+// & binds looser than << so the whole chain is the operand.
+struct LogVoidify {
+    void operator&(const LogLine&) {}
+};
+#define PLANETARY_LOG_AT(level, category) \
+    !Logger::get().enabled(level) ? (void)0 : LogVoidify() & LogLine(level, category)
+#define LOG_DEBUG(category) PLANETARY_LOG_AT(LogLevel::Debug, category)
+#define LOG_INFO(category)  PLANETARY_LOG_AT(LogLevel::Info, category)
+#define LOG_WARN(category)  PLANETARY_LOG_AT(LogLevel::Warn, category)
+#define LOG_ERROR(category) PLANETARY_LOG_AT(LogLevel::Error, category)
@@ -33,20 +33,28 @@
 #include <map>
 #include <fstream>
 #include <cstdlib>
+#include <csignal>
+#include <memory>
 
 #include "stb_image.h"
+#include "log.h"
 #include "shader.h"
+#include "render_device.h"
+#include "mesh_opt.h"
+#include "video_export.h"
 #include "camera.h"
 #include "music_data.h"
-#include "miniaudio.h"
+#include "library_roots.h"
+#include "audio_player.h"
+#include "pick_grid.h"
+#include "soak.h"
+#include "video_wall.h"
+#include "startup_profile.h"
+#include "galaxy_layout.h"
+#include "galaxy_snapshot.h"
+#include "soft_particles.h"
+#include "playlist.h"
 
-// Android-specific includes
-#ifdef __ANDROID__
-#include <android/log.h>
-#define ANDROID_LOG(msg) __android_log_print(ANDROID_LOG_DEBUG, "Planetary", "%s", (msg).c_str())
-#else
-#define ANDROID_LOG(msg)
-#endif
 
 // ============================================================
 // FORCE DISCRETE GPU (NVIDIA / AMD)
@@ -67,6 +75,11 @@ static const int G_ARTIST_LEVEL = 2;
 static const int G_ALBUM_LEVEL  = 3;
 static const int G_TRACK_LEVEL  = 4;
 
+// Scale limits for oversized systems ("Various Artists" and friends)
+static const int G_MEGA_ARTIST_ALBUMS = 40;  // above this, albums are grouped into clusters
+static const int G_CLUSTER_ALBUMS     = 16;  // albums per cluster
+static const int G_MOON_POINT_TRACKS  = 40;  // above this, moons draw as a single ring of points
+
 static const glm::vec3 BRIGHT_BLUE{0.4f, 0.8f, 1.0f};
 static const glm::vec3 BLUE{0.1f, 0.2f, 0.5f};
 static const glm::vec3 GREY{0.1f, 0.1f, 0.15f};
@@ -90,7 +103,7 @@ void initBasePath() {
     } else {
         g_basePath = "./";
     }
-    std::cout << "[Planetary] Base path: " << g_basePath << std::endl;
+    LOG_INFO("Planetary") << "Base path: " << g_basePath;
 }
 
 // ============================================================
@@ -120,6 +133,11 @@ struct ArtistNode {
         std::string name;
         int artistIndex; // back-reference
         int albumIndex;
+        int cluster = -1; // mega-artists only
+        // Tints, from the cover palette (or the name hash without art)
+        glm::vec3 planetColor, cloudTint, atmoColor;
+        float tiltX, tiltZ;
+        int cloudIdx;
         struct TrackOrbit {
             float radius;
             float angle;
@@ -133,6 +151,16 @@ struct ArtistNode {
         std::vector<TrackOrbit> tracks;
     };
     std::vector<AlbumOrbit> albumOrbits;
+
+    // Mega-artists: albums grouped into cluster planets, drilled into one at a time
+    struct AlbumCluster {
+        std::string name;   // year range, e.g. "1994 - 1999"
+        int firstAlbum, numAlbums, numTracks;
+        float radius, angle, speed, planetSize;
+        float viewDist;     // camera distance once drilled in
+    };
+    std::vector<AlbumCluster> clusters;  // empty for normal artists
+    int openCluster = -1;                // -1 = cluster overview
 };
 
 // ============================================================
@@ -171,61 +199,93 @@ void computeArtistColor(ArtistNode& node) {
 }
 
 // ============================================================
-// STAR POSITIONING - from NodeArtist.cpp setData()
+// ALBUM ORBIT LAYOUT - from NodeArtist::setChildOrbitRadii()
 // ============================================================
-// Genre -> angular sector mapping for spatial clustering
-static std::map<std::string, float> g_genreAngles;
-static float g_nextGenreAngle = 0;
-
-float getGenreAngle(const std::string& genre) {
-    auto it = g_genreAngles.find(genre);
-    if (it != g_genreAngles.end()) return it->second;
-    float a = g_nextGenreAngle;
-    g_nextGenreAngle += 0.618f * 2.0f * M_PI; // golden angle separation
-    g_genreAngles[genre] = a;
-    return a;
-}
-
-void computeArtistPosition(ArtistNode& node, int total, const std::string& genre) {
+// Planet, cloud and atmosphere colours, worked out once per album
+void computeAlbumTints(ArtistNode::AlbumOrbit& orbit, const AlbumData& album) {
     std::hash<std::string> hasher;
-    size_t h = hasher(node.name);
-    float hashPer = (float)(h % 9000L) / 90.0f + 10.0f;
-    float spreadFactor = 3.0f;
-    hashPer *= spreadFactor;
-
-    // Base angle from genre cluster + offset from name hash
-    float genreBase = getGenreAngle(genre);
-    float nameOffset = (float)(h % 628) / 100.0f; // 0 to ~6.28 (full circle)
-    float genreSpread = 0.8f; // How tight the cluster is (radians)
-    float angle = genreBase + nameOffset * genreSpread;
-
-    // Vertical from second hash
-    size_t h2 = hasher(node.name + "_y");
-    float yHash = ((float)(h2 % 10000) / 10000.0f - 0.5f) * 2.0f;
-    float height = yHash * hashPer * 0.35f;
-
-    node.pos = glm::vec3(cosf(angle) * hashPer, height, sinf(angle) * hashPer);
+    size_t albumHash = hasher(orbit.name);
+    // Unique tilt per planet
+    orbit.tiltX = sinf((float)albumHash * 0.1f) * 0.3f;
+    orbit.tiltZ = cosf((float)albumHash * 0.2f) * 0.25f;
+    orbit.cloudIdx = (int)(albumHash % 5);
+
+    const ColorPalette& pal = album.palette;
+    if (pal.count > 0) {
+        auto rgb = [&](int i) {
+            return glm::vec3(pal.rgb[i][0], pal.rgb[i][1], pal.rgb[i][2]) / 255.0f;
+        };
+        glm::vec3 dom = rgb(pal.dominant());
+        glm::vec3 acc = rgb(pal.accent());
+        glm::vec3 second = rgb(pal.count > 1 && pal.dominant() == 0 ? 1 : 0);
+        // Keep very dark covers from turning planets into holes
+        float lum = glm::dot(dom, glm::vec3(0.299f, 0.587f, 0.114f));
+        orbit.planetColor = lum < 0.25f ? glm::mix(dom, glm::vec3(1.0f), 0.25f - lum) : dom;
+        orbit.cloudTint = glm::mix(second, glm::vec3(0.75f), 0.5f);
+        float peak = std::max({acc.r, acc.g, acc.b, 0.01f});
+        orbit.atmoColor = glm::mix(acc / peak, glm::vec3(0.3f, 0.7f, 1.0f), 0.35f);
+        return;
+    }
+
+    // No art: hue from the name hash
+    float planetHue = (float)(albumHash % 1000) / 1000.0f;
+    float planetSat = 0.3f + (float)((albumHash >> 10) % 100) / 200.0f;
+    float ph = planetHue * 6.0f;
+    int phi = (int)ph % 6;
+    float pf = ph - (int)ph;
+    float pp = 1.0f - planetSat, pq = 1.0f - planetSat * pf, pt = 1.0f - planetSat * (1.0f - pf);
+    switch (phi) {
+        case 0: orbit.planetColor = {1, pt, pp}; break;
+        case 1: orbit.planetColor = {pq, 1, pp}; break;
+        case 2: orbit.planetColor = {pp, 1, pt}; break;
+        case 3: orbit.planetColor = {pp, pq, 1}; break;
+        case 4: orbit.planetColor = {pt, pp, 1}; break;
+        default: orbit.planetColor = {1, pp, pq}; break;
+    }
+    // Varied cloud tints per planet for diversity
+    const glm::vec3 cloudTints[5] = {
+        {0.7f, 0.7f, 0.78f}, {0.78f, 0.72f, 0.65f},
+        {0.65f, 0.78f, 0.72f}, {0.72f, 0.65f, 0.78f},
+        {0.8f, 0.77f, 0.72f}
+    };
+    orbit.cloudTint = cloudTints[orbit.cloudIdx];
+    orbit.atmoColor = glm::vec3(0.3f, 0.7f, 1.0f);
 }
 
-// ============================================================
-// ALBUM ORBIT LAYOUT - from NodeArtist::setChildOrbitRadii()
-// ============================================================
 void computeAlbumOrbits(ArtistNode& node, const ArtistData& artistData, int artistIdx) {
     node.albumOrbits.clear();
+    node.clusters.clear();
+    node.openCluster = -1;
+    // Mega-artists restart the spiral for every cluster, so radii stay
+    // bounded by one cluster's worth of albums instead of hundreds
+    bool mega = (int)artistData.albums.size() > G_MEGA_ARTIST_ALBUMS;
     float orbitOffset = node.radiusInit * 1.25f;
     int albumIdx = 0;
     for (auto& album : artistData.albums) {
+        if (mega && albumIdx % G_CLUSTER_ALBUMS == 0) {
+            if (albumIdx > 0) node.clusters.back().viewDist = std::max(orbitOffset * 2.6f, 8.0f);
+            orbitOffset = node.radiusInit * 1.25f;
+            ArtistNode::AlbumCluster c = {};
+            c.firstAlbum = albumIdx;
+            node.clusters.push_back(c);
+        }
         ArtistNode::AlbumOrbit orbit;
         orbit.name = album.name;
         orbit.numTracks = (int)album.tracks.size();
         orbit.artistIndex = artistIdx;
         orbit.albumIndex = albumIdx;
+        if (mega) {
+            orbit.cluster = (int)node.clusters.size() - 1;
+            node.clusters.back().numAlbums++;
+            node.clusters.back().numTracks += orbit.numTracks;
+        }
         float amt = std::max(orbit.numTracks * 0.065f, 0.2f);
         orbitOffset += amt;
         orbit.radius = orbitOffset;
         orbit.angle = (float)albumIdx * 0.618f * (float)M_PI * 2.0f;
         orbit.speed = 0.025f / sqrtf(std::max(orbit.radius, 0.5f)); // Slow, majestic planetary orbits
         orbit.planetSize = std::max(0.15f, 0.1f + sqrtf((float)orbit.numTracks) * 0.06f);
+        computeAlbumTints(orbit, album);
 
         float trackOrbitR = orbit.planetSize * 3.0f;
         for (int ti = 0; ti < (int)album.tracks.size(); ti++) {
@@ -253,7 +313,43 @@ void computeAlbumOrbits(ArtistNode& node, const ArtistData& artistData, int arti
         albumIdx++;
         node.albumOrbits.push_back(orbit);
     }
-    node.idealCameraDist = std::max(orbitOffset * 2.6f, 8.0f);
+    if (!mega) {
+        node.idealCameraDist = std::max(orbitOffset * 2.6f, 8.0f);
+        return;
+    }
+
+    // Cluster planets: same spacing rules, sized by album count
+    node.clusters.back().viewDist = std::max(orbitOffset * 2.6f, 8.0f);
+    float clusterOffset = node.radiusInit * 1.25f;
+    for (int ci = 0; ci < (int)node.clusters.size(); ci++) {
+        auto& c = node.clusters[ci];
+        int y0 = artistData.albums[c.firstAlbum].year;
+        int y1 = artistData.albums[c.firstAlbum + c.numAlbums - 1].year;
+        if (y0 > 0 && y1 > y0) c.name = std::to_string(y0) + " - " + std::to_string(y1);
+        else if (y0 > 0 && y1 == y0) c.name = std::to_string(y0);
+        else c.name = "Albums " + std::to_string(c.firstAlbum + 1) + " - " + std::to_string(c.firstAlbum + c.numAlbums);
+        c.planetSize = std::max(0.3f, 0.15f + sqrtf((float)c.numAlbums) * 0.12f);
+        float amt = c.planetSize * 2.0f + 0.3f;
+        clusterOffset += amt;
+        c.radius = clusterOffset;
+        c.angle = (float)ci * 0.618f * (float)M_PI * 2.0f;
+        c.speed = 0.025f / sqrtf(std::max(c.radius, 0.5f));
+        clusterOffset += amt;
+    }
+    node.idealCameraDist = std::max(clusterOffset * 2.6f, 8.0f);
+}
+
+// Which cluster of a mega-artist is on screen: the selected album's,
+// else the one drilled into. -1 = overview (or not a mega-artist).
+int visibleCluster(const ArtistNode& star, int selectedAlbum) {
+    if (star.clusters.empty()) return -1;
+    if (selectedAlbum >= 0 && selectedAlbum < (int)star.albumOrbits.size())
+        return star.albumOrbits[selectedAlbum].cluster;
+    return star.openCluster;
+}
+
+bool albumVisible(const ArtistNode& star, int selectedAlbum, int ai) {
+    return star.clusters.empty() || star.albumOrbits[ai].cluster == visibleCluster(star, selectedAlbum);
 }
 
 // ============================================================
@@ -264,7 +360,7 @@ GLuint loadTexture(const std::string& path) {
     int w, h, channels;
     unsigned char* data = stbi_load(fullPath.c_str(), &w, &h, &channels, 4);
     if (!data) {
-        std::cerr << "[Planetary] Failed to load texture: " << fullPath << std::endl;
+        LOG_ERROR("Planetary") << "Failed to load texture: " << fullPath;
         return 0;
     }
     GLuint tex;
@@ -277,27 +373,29 @@ GLuint loadTexture(const std::string& path) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     stbi_image_free(data);
-    std::cout << "[Planetary] Loaded: " << path << " (" << w << "x" << h << ")" << std::endl;
+    LOG_INFO("Planetary") << "Loaded: " << path << " (" << w << "x" << h << ")";
     return tex;
 }
 
 // ============================================================
-// SPHERE MESH
+// SPHERE MESH - packed 12-byte vertices, 16-bit indices
+// Position doubles as the normal (unit sphere), so attribute 1
+// aliases attribute 0 instead of storing a copy.
 // ============================================================
 struct SphereMesh {
-    GLuint vao = 0, vbo = 0, ebo = 0;
-    int indexCount = 0;
-    void create(int stacks, int slices) {
-        std::vector<float> verts;
-        std::vector<unsigned int> indices;
+    Mesh mesh;
+    float acmrBefore = 0, acmrAfter = 0;   // vertex cache miss ratio, reported by --bench-frames
+
+    // Classic UV sphere (planets with album art, skydome)
+    void create(RenderDevice& gfx, int stacks, int slices) {
+        std::vector<PackedSphereVertex> verts;
+        std::vector<uint16_t> indices;
         for (int i = 0; i <= stacks; i++) {
             float phi = (float)M_PI * (float)i / stacks;
             for (int j = 0; j <= slices; j++) {
                 float theta = 2.0f * (float)M_PI * (float)j / slices;
-                float x = sinf(phi) * cosf(theta), y = cosf(phi), z = sinf(phi) * sinf(theta);
-                verts.push_back(x); verts.push_back(y); verts.push_back(z);
-                verts.push_back(x); verts.push_back(y); verts.push_back(z);
-                verts.push_back((float)j / slices); verts.push_back((float)i / stacks);
+                glm::vec3 p(sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta));
+                verts.push_back(pack(p, (float)j / slices, (float)i / stacks));
             }
         }
         for (int i = 0; i < stacks; i++)
@@ -306,293 +404,260 @@ struct SphereMesh {
                 indices.push_back(a); indices.push_back(b); indices.push_back(a + 1);
                 indices.push_back(b); indices.push_back(b + 1); indices.push_back(a + 1);
             }
-        indexCount = (int)indices.size();
-        glGenVertexArrays(1, &vao); glGenBuffers(1, &vbo); glGenBuffers(1, &ebo);
-        glBindVertexArray(vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0); glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3*sizeof(float))); glEnableVertexAttribArray(1);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6*sizeof(float))); glEnableVertexAttribArray(2);
-        glBindVertexArray(0);
-    }
-    void draw() const { glBindVertexArray(vao); glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0); glBindVertexArray(0); }
+        upload(gfx, verts, indices);
+    }
+
+    // Subdivided octahedron for small bodies (moons, distant star cores):
+    // evenly spread triangles, far fewer than a UV sphere at the same
+    // silhouette quality. Each octant keeps its own vertices so the
+    // u = 0/1 texture seam falls on an octant edge and never wraps.
+    void createOcta(RenderDevice& gfx, int n) {
+        std::vector<PackedSphereVertex> verts;
+        std::vector<uint16_t> indices;
+        for (int oct = 0; oct < 8; oct++) {
+            float sx = (oct & 1) ? -1.0f : 1.0f;
+            float sy = (oct & 2) ? -1.0f : 1.0f;
+            float sz = (oct & 4) ? -1.0f : 1.0f;
+            // Octant's theta range, used for the seam and the pole's u
+            float t0 = atan2f(sz * 0.5f, sx * 0.5f);
+            if (t0 < 0) t0 += 2.0f * (float)M_PI;
+            int base = (int)verts.size();
+            // Rows from the pole (r = 0) down to the equator (r = n)
+            for (int r = 0; r <= n; r++) {
+                for (int c = 0; c <= r; c++) {
+                    float fx = r ? (float)(r - c) / n : 0.0f;
+                    float fz = r ? (float)c / n : 0.0f;
+                    float fy = 1.0f - (float)r / n;
+                    glm::vec3 p = glm::normalize(glm::vec3(sx * fx, sy * fy, sz * fz));
+                    float theta = atan2f(p.z, p.x);
+                    if (theta < 0) theta += 2.0f * (float)M_PI;
+                    // Vertices on the +x meridian belong to u = 1 for the octants that end there
+                    if (t0 > 1.5f * (float)M_PI && theta < 0.25f * (float)M_PI) theta = 2.0f * (float)M_PI;
+                    if (r == 0) theta = t0;
+                    float phi = acosf(std::max(-1.0f, std::min(1.0f, p.y)));
+                    verts.push_back(pack(p, theta / (2.0f * (float)M_PI), phi / (float)M_PI));
+                }
+            }
+            auto idx = [&](int r, int c) { return base + r * (r + 1) / 2 + c; };
+            // Same winding as the UV sphere; mirrored octants swap it
+            bool flip = (sx * sy * sz) > 0;
+            auto tri = [&](int a, int b, int c) {
+                indices.push_back(a);
+                indices.push_back(flip ? c : b);
+                indices.push_back(flip ? b : c);
+            };
+            for (int r = 0; r < n; r++)
+                for (int c = 0; c <= r; c++) {
+                    tri(idx(r, c), idx(r + 1, c + 1), idx(r + 1, c));
+                    if (c < r) tri(idx(r, c), idx(r, c + 1), idx(r + 1, c + 1));
+                }
+        }
+        upload(gfx, verts, indices);
+    }
+
+    void draw(RenderDevice& gfx) const { gfx.draw(mesh); }
+
+private:
+    static PackedSphereVertex pack(glm::vec3 p, float u, float v) {
+        PackedSphereVertex pv;
+        pv.pos[0] = packSnorm16(p.x); pv.pos[1] = packSnorm16(p.y); pv.pos[2] = packSnorm16(p.z); pv.pos[3] = 0;
+        pv.uv[0] = packUnorm16(u); pv.uv[1] = packUnorm16(v);
+        return pv;
+    }
+
+    void upload(RenderDevice& gfx, std::vector<PackedSphereVertex>& verts, std::vector<uint16_t>& indices) {
+        // Keep the generated order when it already beats the reorder
+        // (octahedron rows are strip-like and come out ahead at n = 8)
+        std::vector<uint16_t> reordered = indices;
+        optimizeVertexCache(reordered, (int)verts.size());
+        acmrBefore = vertexCacheACMR(indices);
+        acmrAfter = std::min(acmrBefore, vertexCacheACMR(reordered));
+        if (acmrAfter < acmrBefore) indices.swap(reordered);
+        optimizeVertexFetch(verts, indices);
+        MeshDesc d;
+        d.vertices = verts.data(); d.vertexBytes = verts.size() * sizeof(PackedSphereVertex);
+        d.vertexCount = (int)verts.size(); d.stride = sizeof(PackedSphereVertex);
+        d.attribs = { {0, 3, GL_SHORT, true, offsetof(PackedSphereVertex, pos)},
+                      {1, 3, GL_SHORT, true, offsetof(PackedSphereVertex, pos)},   // normal == position
+                      {2, 2, GL_UNSIGNED_SHORT, true, offsetof(PackedSphereVertex, uv)} };
+        d.indices = indices.data(); d.indexCount = (int)indices.size(); d.indexType = GL_UNSIGNED_SHORT;
+        mesh = gfx.createMesh(d);
+    }
 };
 
 // ============================================================
 // RING MESH
 // ============================================================
 struct RingMesh {
-    GLuint vao = 0, vbo = 0; int vertCount = 0;
-    void create(float radius, int segments) {
+    Mesh mesh;
+    void create(RenderDevice& gfx, float radius, int segments) {
         std::vector<float> verts;
         for (int i = 0; i <= segments; i++) {
             float a = 2.0f * (float)M_PI * (float)i / segments;
             verts.push_back(cosf(a) * radius); verts.push_back(0); verts.push_back(sinf(a) * radius);
         }
-        vertCount = segments + 1;
-        glGenVertexArrays(1, &vao); glGenBuffers(1, &vbo);
-        glBindVertexArray(vao); glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3*sizeof(float), 0); glEnableVertexAttribArray(0);
-        glBindVertexArray(0);
+        MeshDesc d;
+        d.vertices = verts.data(); d.vertexBytes = verts.size() * sizeof(float);
+        d.vertexCount = segments + 1; d.stride = 3 * sizeof(float);
+        d.attribs = { {0, 3, GL_FLOAT, false, 0} };
+        d.primitive = PrimitiveType::LineStrip;
+        mesh = gfx.createMesh(d);
     }
-    void draw() const { glBindVertexArray(vao); glDrawArrays(GL_LINE_STRIP, 0, vertCount); glBindVertexArray(0); }
+    void draw(RenderDevice& gfx) const { gfx.draw(mesh); }
 };
 
 // ============================================================
 // SATURN RING DISC MESH (annulus for planet rings)
+// Same 12-byte layout as the spheres: snorm16 pos + unorm16 uv
 // ============================================================
 struct RingDiscMesh {
-    GLuint vao = 0, vbo = 0, ebo = 0;
-    int indexCount = 0;
-    void create(float innerR, float outerR, int segments) {
-        std::vector<float> verts;
-        std::vector<unsigned int> indices;
+    Mesh mesh;
+    void create(RenderDevice& gfx, float innerR, float outerR, int segments) {
+        // snorm16 positions: radii must be <= 1, size the ring through uModel
+        std::vector<PackedSphereVertex> verts;
+        std::vector<uint16_t> indices;
+        auto vert = [&](float x, float z, float u, float v) {
+            PackedSphereVertex pv;
+            pv.pos[0] = packSnorm16(x); pv.pos[1] = 0; pv.pos[2] = packSnorm16(z); pv.pos[3] = 0;
+            pv.uv[0] = packUnorm16(u); pv.uv[1] = packUnorm16(v);
+            verts.push_back(pv);
+        };
         for (int i = 0; i <= segments; i++) {
             float angle = 2.0f * (float)M_PI * (float)i / segments;
             float ca = cosf(angle), sa = sinf(angle);
-            // Inner vertex: pos(3) + texcoord(2)
-            verts.push_back(ca * innerR); verts.push_back(0); verts.push_back(sa * innerR);
-            verts.push_back(0.0f); verts.push_back((float)i / segments);
-            // Outer vertex
-            verts.push_back(ca * outerR); verts.push_back(0); verts.push_back(sa * outerR);
-            verts.push_back(1.0f); verts.push_back((float)i / segments);
+            vert(ca * innerR, sa * innerR, 0.0f, (float)i / segments);  // inner
+            vert(ca * outerR, sa * outerR, 1.0f, (float)i / segments);  // outer
         }
         for (int i = 0; i < segments; i++) {
             int a = i * 2, b = a + 1, c = a + 2, d = a + 3;
             indices.push_back(a); indices.push_back(c); indices.push_back(b);
             indices.push_back(b); indices.push_back(c); indices.push_back(d);
         }
-        indexCount = (int)indices.size();
-        glGenVertexArrays(1, &vao); glGenBuffers(1, &vbo); glGenBuffers(1, &ebo);
-        glBindVertexArray(vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        glBindVertexArray(0);
-    }
-    void draw() const { glBindVertexArray(vao); glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0); glBindVertexArray(0); }
+        // A strip-shaped annulus is already in cache order
+        MeshDesc d;
+        d.vertices = verts.data(); d.vertexBytes = verts.size() * sizeof(PackedSphereVertex);
+        d.vertexCount = (int)verts.size(); d.stride = sizeof(PackedSphereVertex);
+        d.attribs = { {0, 3, GL_SHORT, true, offsetof(PackedSphereVertex, pos)},
+                      {1, 2, GL_UNSIGNED_SHORT, true, offsetof(PackedSphereVertex, uv)} };
+        d.indices = indices.data(); d.indexCount = (int)indices.size(); d.indexType = GL_UNSIGNED_SHORT;
+        mesh = gfx.createMesh(d);
+    }
+    void draw(RenderDevice& gfx) const { gfx.draw(mesh); }
 };
 
 // ============================================================
-// BACKGROUND STARS
+// BACKGROUND STARS - float position, RGBA8 color, unorm8 size (20 bytes)
 // ============================================================
+struct BackgroundStarVertex {
+    float pos[3];
+    uint8_t color[4];
+    uint8_t size, pad[3];
+};
+
 struct BackgroundStars {
-    GLuint vao = 0, vbo = 0; int count = 0;
-    void create(int n) {
-        count = n; std::vector<float> data;
+    Mesh mesh;
+    void create(RenderDevice& gfx, int n) {
+        std::vector<BackgroundStarVertex> data;
         std::mt19937 rng(42); std::uniform_real_distribution<float> d(-1,1), b(0.1f,0.8f);
         for (int i = 0; i < n; i++) {
             float x=d(rng),y=d(rng),z=d(rng); float len=sqrtf(x*x+y*y+z*z);
             if(len<0.001f)continue; float r=300+d(rng)*200; x=x/len*r;y=y/len*r;z=z/len*r;
             float br=b(rng);
-            data.push_back(x);data.push_back(y);data.push_back(z);
-            data.push_back(br*0.8f);data.push_back(br*0.85f);data.push_back(br);data.push_back(br*0.6f);
-            data.push_back(0.5f+d(rng)*0.5f);
-        }
-        glGenVertexArrays(1,&vao);glGenBuffers(1,&vbo);glBindVertexArray(vao);glBindBuffer(GL_ARRAY_BUFFER,vbo);
-        glBufferData(GL_ARRAY_BUFFER,data.size()*sizeof(float),data.data(),GL_STATIC_DRAW);
-        glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,8*sizeof(float),0);glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1,4,GL_FLOAT,GL_FALSE,8*sizeof(float),(void*)(3*sizeof(float)));glEnableVertexAttribArray(1);
-        glVertexAttribPointer(2,1,GL_FLOAT,GL_FALSE,8*sizeof(float),(void*)(7*sizeof(float)));glEnableVertexAttribArray(2);
-        glBindVertexArray(0);
-    }
-    void draw() const { glBindVertexArray(vao); glDrawArrays(GL_POINTS, 0, count); glBindVertexArray(0); }
+            BackgroundStarVertex v = {};
+            v.pos[0]=x; v.pos[1]=y; v.pos[2]=z;
+            v.color[0]=packUnorm8(br*0.8f); v.color[1]=packUnorm8(br*0.85f);
+            v.color[2]=packUnorm8(br); v.color[3]=packUnorm8(br*0.6f);
+            v.size=packUnorm8(0.5f+d(rng)*0.5f);
+            data.push_back(v);
+        }
+        MeshDesc md;
+        md.vertices = data.data(); md.vertexBytes = data.size() * sizeof(BackgroundStarVertex);
+        md.vertexCount = (int)data.size(); md.stride = sizeof(BackgroundStarVertex);
+        md.attribs = { {0, 3, GL_FLOAT, false, offsetof(BackgroundStarVertex, pos)},
+                       {1, 4, GL_UNSIGNED_BYTE, true, offsetof(BackgroundStarVertex, color)},
+                       {2, 1, GL_UNSIGNED_BYTE, true, offsetof(BackgroundStarVertex, size)} };
+        md.primitive = PrimitiveType::Points;
+        mesh = gfx.createMesh(md);
+    }
+    void draw(RenderDevice& gfx) const { gfx.draw(mesh); }
 };
 
 // ============================================================
 // BILLBOARD QUAD
 // ============================================================
 struct BillboardQuad {
-    GLuint vao=0, vbo=0;
-    void create() {
+    Mesh mesh;
+    SoftParticles* defer = nullptr;   // collects the sprites instead while set (see soft_particles.h)
+    void create(RenderDevice& gfx) {
         float v[]={0,0,0,0,0,1,1,1,1,1, 0,0,0,1,0,1,1,1,1,1, 0,0,0,1,1,1,1,1,1,1,
                    0,0,0,0,0,1,1,1,1,1, 0,0,0,1,1,1,1,1,1,1, 0,0,0,0,1,1,1,1,1,1};
-        glGenVertexArrays(1,&vao);glGenBuffers(1,&vbo);glBindVertexArray(vao);glBindBuffer(GL_ARRAY_BUFFER,vbo);
-        glBufferData(GL_ARRAY_BUFFER,sizeof(v),v,GL_DYNAMIC_DRAW);
-        glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,10*sizeof(float),0);glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1,2,GL_FLOAT,GL_FALSE,10*sizeof(float),(void*)(3*sizeof(float)));glEnableVertexAttribArray(1);
-        glVertexAttribPointer(2,4,GL_FLOAT,GL_FALSE,10*sizeof(float),(void*)(5*sizeof(float)));glEnableVertexAttribArray(2);
-        glVertexAttribPointer(3,1,GL_FLOAT,GL_FALSE,10*sizeof(float),(void*)(9*sizeof(float)));glEnableVertexAttribArray(3);
-        glBindVertexArray(0);
-    }
-    void draw(glm::vec3 p, glm::vec4 c, float s) {
+        MeshDesc d;
+        d.vertices = v; d.vertexBytes = sizeof(v); d.vertexCount = 6; d.stride = SPRITE_FLOATS * sizeof(float);
+        d.attribs = spriteAttribs();
+        d.dynamic = true;
+        mesh = gfx.createMesh(d);
+    }
+    void draw(RenderDevice& gfx, glm::vec3 p, glm::vec4 c, float s) {
         float v[]={p.x,p.y,p.z,0,0,c.r,c.g,c.b,c.a,s, p.x,p.y,p.z,1,0,c.r,c.g,c.b,c.a,s,
                    p.x,p.y,p.z,1,1,c.r,c.g,c.b,c.a,s, p.x,p.y,p.z,0,0,c.r,c.g,c.b,c.a,s,
                    p.x,p.y,p.z,1,1,c.r,c.g,c.b,c.a,s, p.x,p.y,p.z,0,1,c.r,c.g,c.b,c.a,s};
-        glBindVertexArray(vao);glBindBuffer(GL_ARRAY_BUFFER,vbo);
-        glBufferSubData(GL_ARRAY_BUFFER,0,sizeof(v),v);glDrawArrays(GL_TRIANGLES,0,6);glBindVertexArray(0);
-    }
-};
-
-// ============================================================
-// AUDIO PLAYER - miniaudio (supports MP3, FLAC, WAV, OGG, etc.)
-// ============================================================
-struct AudioPlayer {
-    ma_engine engine;
-    ma_sound sound;
-    bool engineInit = false;
-    bool soundInit = false;
-    bool playing = false;
-    float volume = 0.8f;
-    std::string currentTrack;
-    std::string currentTrackName;
-    std::string currentArtist;
-    std::string currentAlbum;
-    float duration = 0;
-    bool castEnabled = false;
-    std::string castTarget = "Living Room";
-
-    static std::string shellEscapeSingleQuotes(const std::string& in) {
-        std::string out;
-        out.reserve(in.size() + 8);
-        for (char c : in) {
-            if (c == '\'') out += "'\\''";
-            else out.push_back(c);
-        }
-        return out;
-    }
-
-    void init() {
-        ma_engine_config config = ma_engine_config_init();
-        if (ma_engine_init(&config, &engine) != MA_SUCCESS) {
-            std::cerr << "[Audio] Failed to init miniaudio engine" << std::endl;
+        if (defer) {
+            defer->add(gfx.boundTexture(), !gfx.depthTesting(), v);
             return;
         }
-        engineInit = true;
-        ma_engine_set_volume(&engine, volume);
-        const char* castEnv = std::getenv("PLANETARY_CAST");
-        const char* targetEnv = std::getenv("PLANETARY_CAST_TARGET");
-        castEnabled = (castEnv && std::string(castEnv) == "1");
-        if (targetEnv && std::string(targetEnv).size() > 0) castTarget = targetEnv;
-        std::cout << "[Audio] miniaudio engine ready (MP3/FLAC/WAV/OGG)";
-        if (castEnabled) std::cout << " | CAST MODE ON -> " << castTarget;
-        std::cout << std::endl;
-    }
-
-    void play(const std::string& path, const std::string& name, const std::string& artist, const std::string& album, float dur) {
-        if (!engineInit) return;
-
-        // Stop current track
-        if (soundInit) {
-            ma_sound_uninit(&sound);
-            soundInit = false;
-        }
-
-        currentTrack = path;
-        currentTrackName = name;
-        currentArtist = artist;
-        currentAlbum = album;
-        duration = dur;
-
-        if (castEnabled) {
-            std::string escapedPath = shellEscapeSingleQuotes(path);
-            std::string escapedTarget = shellEscapeSingleQuotes(castTarget);
-            std::string cmd = "/Users/kawkaw/.openclaw/workspace/.venv_music/bin/python /Users/kawkaw/.openclaw/workspace/scripts/planetary_cast_track.py --file '" + escapedPath + "' --target '" + escapedTarget + "' >/tmp/planetary_cast_track.log 2>&1 &";
-            int rc = std::system(cmd.c_str());
-            playing = (rc == 0);
-            std::cout << "[Audio] Cast: " << name << " by " << artist << " -> " << castTarget << std::endl;
-            return;
-        }
-
-#ifdef __ANDROID__
-        // Android: HTTP URLs from Navidrome need to be streamed
-        // Use SDL_RWops or download to temp file
-        // For simplicity: download to /data/local/tmp/planetary_current.mp3
-        if (path.substr(0, 4) == "http") {
-            std::string tempFile = "/data/local/tmp/planetary_stream.mp3";
-            // Download in background then play
-            // For now: use planetaryHttpGet from music_data.h to buffer the first 5MB
-            // and save to temp file, then init from file
-            // This is a blocking prefetch — runs in background thread
-            std::string response = planetaryHttpGet(path, 30);
-            if (response.empty()) {
-                __android_log_print(ANDROID_LOG_ERROR, "Planetary", "[Audio] HTTP stream failed: %s", path.c_str());
-                return;
-            }
-            // Write to temp file
-            FILE* f = fopen(tempFile.c_str(), "wb");
-            if (!f) {
-                __android_log_print(ANDROID_LOG_ERROR, "Planetary", "[Audio] Cannot write temp file");
-                return;
-            }
-            fwrite(response.data(), 1, response.size(), f);
-            fclose(f);
-            if (ma_sound_init_from_file(&engine, tempFile.c_str(), 0, nullptr, nullptr, &sound) != MA_SUCCESS) {
-                __android_log_print(ANDROID_LOG_ERROR, "Planetary", "[Audio] Failed to decode stream");
-                return;
-            }
-        } else {
-            if (ma_sound_init_from_file(&engine, path.c_str(), 0, nullptr, nullptr, &sound) != MA_SUCCESS) {
-                __android_log_print(ANDROID_LOG_ERROR, "Planetary", "[Audio] Failed to load: %s", path.c_str());
-                return;
-            }
-        }
-#else
-        if (ma_sound_init_from_file(&engine, path.c_str(), 0, nullptr, nullptr, &sound) != MA_SUCCESS) {
-            std::cerr << "[Audio] Failed to load: " << path << std::endl;
-            return;
-        }
-#endif
-        soundInit = true;
-        ma_sound_start(&sound);
-        playing = true;
-        std::cout << "[Audio] Playing: " << name << " by " << artist << std::endl;
-    }
-
-    void togglePause() {
-        if (!soundInit) return;
-        if (playing) {
-            ma_sound_stop(&sound);
-            playing = false;
-        } else {
-            ma_sound_start(&sound);
-            playing = true;
-        }
-    }
-
-    void stop() {
-        if (soundInit) {
-            ma_sound_stop(&sound);
-            playing = false;
-        }
+        gfx.updateMesh(mesh, v, sizeof(v), 6);
+        gfx.draw(mesh);
     }
+};
 
-    float progress() const {
-        if (!soundInit || duration <= 0) return 0;
-        float cursor = 0;
-        ma_sound_get_cursor_in_seconds(&sound, &cursor);
-        return cursor / duration;
+// ============================================================
+// LINE STREAM - dynamic line strip for trails (one buffer, reused)
+// ============================================================
+struct LineStream {
+    Mesh mesh;
+    std::vector<float> verts;   // scratch, keeps its capacity between frames
+    void create(RenderDevice& gfx) {
+        MeshDesc d;
+        d.vertexBytes = 256 * 3 * sizeof(float); d.vertexCount = 0; d.stride = 3 * sizeof(float);
+        d.attribs = { {0, 3, GL_FLOAT, false, 0} };
+        d.primitive = PrimitiveType::LineStrip;
+        d.dynamic = true;
+        mesh = gfx.createMesh(d);
     }
-
-    float currentTime() const {
-        if (!soundInit) return 0;
-        float cursor = 0;
-        ma_sound_get_cursor_in_seconds(&sound, &cursor);
-        return cursor;
+    void begin() { verts.clear(); }
+    void add(glm::vec3 p) { verts.push_back(p.x); verts.push_back(p.y); verts.push_back(p.z); }
+    void draw(RenderDevice& gfx) {
+        gfx.updateMesh(mesh, verts.data(), verts.size() * sizeof(float), (int)verts.size() / 3);
+        gfx.draw(mesh);
     }
+};
 
-    void setVolume(float v) {
-        volume = v;
-        if (engineInit) ma_engine_set_volume(&engine, v);
+// ============================================================
+// POINT STREAM - dynamic point list in the star_points layout
+// (pos3 + color4 + size), one draw for many tiny bodies
+// ============================================================
+struct PointStream {
+    Mesh mesh;
+    std::vector<float> verts;
+    void create(RenderDevice& gfx) {
+        MeshDesc d;
+        d.vertexBytes = 256 * 8 * sizeof(float); d.vertexCount = 0; d.stride = 8 * sizeof(float);
+        d.attribs = { {0, 3, GL_FLOAT, false, 0},
+                      {1, 4, GL_FLOAT, false, 3 * sizeof(float)},
+                      {2, 1, GL_FLOAT, false, 7 * sizeof(float)} };
+        d.primitive = PrimitiveType::Points;
+        d.dynamic = true;
+        mesh = gfx.createMesh(d);
     }
-
-    bool isAtEnd() const {
-        if (!soundInit) return false;
-        return ma_sound_at_end(&sound);
+    void begin() { verts.clear(); }
+    void add(glm::vec3 p, glm::vec4 c, float size) {
+        float v[8] = { p.x, p.y, p.z, c.r, c.g, c.b, c.a, size };
+        verts.insert(verts.end(), v, v + 8);
     }
-
-    void cleanup() {
-        if (soundInit) ma_sound_uninit(&sound);
-        if (engineInit) ma_engine_uninit(&engine);
+    bool empty() const { return verts.empty(); }
+    void draw(RenderDevice& gfx) {
+        gfx.updateMesh(mesh, verts.data(), verts.size() * sizeof(float), (int)verts.size() / 8);
+        gfx.draw(mesh);
     }
 };
 
@@ -608,29 +673,30 @@ struct App {
     Camera camera;
     MusicLibrary library;
     std::vector<ArtistNode> artistNodes;
+    GenreAngles genreAngles;   // genre sectors, kept across rebuilds so stars stay put
     int currentLevel = G_ALPHA_LEVEL;
     int selectedArtist = -1;
     int selectedAlbum = -1;
     char searchBuf[256] = {0};  // Search buffer -- directly used by ImGui InputText
 
     // Rendering
+    std::unique_ptr<RenderDevice> gfx;
+    ExportSettings exportCfg;  // --export: offline video instead of the interactive loop
     Shader starPointShader, billboardShader, planetShader, ringShader;
-    Shader bloomBrightShader, bloomBlurShader, bloomCompositeShader;
     Shader starSurfaceShader, saturnRingShader, gravityRippleShader;
+    Shader particleUpsampleShader;
     GLuint texStarGlow=0, texAtmosphere=0, texStar=0, texSurface=0, texSkydome=0;
     GLuint texLensFlare=0, texStarCore=0, texEclipseGlow=0, texParticle=0;
     GLuint texPlanetClouds[5] = {0};
     RingDiscMesh ringDisc;
     BackgroundStars bgStars;
     BillboardQuad billboard;
-    SphereMesh sphereHi, sphereMd, sphereLo;
+    SoftParticles softParticles;     // --particle-res: additive sprites at reduced resolution
+    SphereMesh sphereHi, sphereLo;   // UV spheres (album art planets, skydome)
+    SphereMesh octaMd, octaLo;       // small bodies (moons, star cores)
     RingMesh unitRing;
-
-    // Bloom framebuffers
-    GLuint sceneFBO=0, sceneColor=0, sceneDepth=0;
-    GLuint bloomFBO[2]={0,0}, bloomColor[2]={0,0};
-    GLuint quadVAO=0, quadVBO=0;
-    int bloomW=0, bloomH=0;
+    LineStream lineStream;     // playback / meteor trails
+    PointStream moonPoints;    // moons of very long albums
 
     // Audio
     AudioPlayer audio;
@@ -639,11 +705,17 @@ struct App {
     std::map<std::string, GLuint> albumArtTextures;
 
     float elapsedTime = 0;
+    double sceneClock = 0;      // accumulated in double; elapsedTime is its float view
     bool mouseDown = false;
     int mouseButton = 0;
     bool imguiWantsMouse = false;
     int mouseDragDist = 0;  // Accumulated drag pixels to distinguish click vs drag
     int mouseDownX = 0, mouseDownY = 0;
+    int mouseX = -1, mouseY = -1;   // -1 = outside the window
+
+    // Hover: what the last frame drew under the cursor
+    PickGrid pick;
+    PickHit hover;
 
     // Multi-size fonts for text labels
     ImFont* fontLarge = nullptr;   // 28px for artist names
@@ -659,6 +731,11 @@ struct App {
     // Currently playing track location (for trail rendering)
     int playingArtist = -1, playingAlbum = -1, playingTrack = -1;
 
+    // Imported playlist (--playlist, or a dropped .m3u); the index is
+    // built on first use and dropped whenever the scene is rebuilt
+    PlayQueue queue;
+    PlaylistIndex trackIndex;
+
     // Shooting star meteors (random tracks)
     struct Meteor {
         glm::vec3 pos, vel;
@@ -690,6 +767,8 @@ struct App {
     float audioPeak = 0;        // Peak detector
     float audioBass = 0;        // Low-freq energy
     float audioWave = 0;        // Smooth wave for pulsation
+    bool audioPlaying = false;  // what the scene shows (a wall follower gets the master's)
+    float audioProgress = 0;
 
     // Gamepad
     SDL_GameController* controller = nullptr;
@@ -699,49 +778,55 @@ struct App {
     std::atomic<bool> scanning{false};
     std::atomic<int> scanProgress{0};
     std::atomic<int> scanTotal{0};
-    std::string musicPath;
+    std::string musicPath;                  // Android: Navidrome server URL
+    std::vector<LibraryRoot> musicRoots;    // Desktop: folders merged into one galaxy, mounted or not
+    std::string snapshotSource;             // planetary-indexer URL or snapshot directory
+    std::unique_ptr<ArtPack> artPack;       // covers of a snapshot library, until uploaded
+#ifndef __ANDROID__
+    LibraryScanner scanner;
+#endif
     std::string statusMsg;
 };
 
 // ============================================================
-// PERSISTENT CONFIG - save/load music library path
+// PERSISTENT CONFIG - save/load music library roots, one per line
+// ("hdd=/mnt/archive" pins a root's device class; '#' = comment),
+// or a single "snapshot=http://nas:47200" line
 // ============================================================
 void saveConfig(App& app) {
     std::string path = g_basePath + "planetary.cfg";
     std::ofstream f(path);
     if (f.is_open()) {
-        f << app.musicPath << std::endl;
-        std::cout << "[Config] Saved: " << path << std::endl;
+        if (!app.snapshotSource.empty()) f << "snapshot=" << app.snapshotSource << std::endl;
+#ifdef __ANDROID__
+        else f << app.musicPath << std::endl;
+#else
+        else for (auto& root : app.musicRoots) f << formatRootLine(root) << std::endl;
+#endif
+        LOG_INFO("Config") << "Saved: " << path;
     }
 }
 
-std::string loadConfig() {
+std::vector<std::string> loadConfig() {
+    std::vector<std::string> lines;
     std::string path = g_basePath + "planetary.cfg";
     std::ifstream f(path);
-    if (f.is_open()) {
-        std::string musicPath;
-        std::getline(f, musicPath);
-#ifdef __ANDROID__
-        // On Android, always use the Navidrome server URL
-        if (!musicPath.empty()) {
-            std::cout << "[Config] Loaded: " << musicPath << std::endl;
-            return musicPath;
-        }
-#else
-        if (!musicPath.empty() && fs::is_directory(musicPath)) {
-            std::cout << "[Config] Loaded: " << musicPath << std::endl;
-            return musicPath;
-        }
-#endif
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        LOG_INFO("Config") << "Loaded: " << line;
+        lines.push_back(line);
     }
-    return "";
+    return lines;
 }
 
 // ============================================================
 // AUDIO ANALYSIS - extract volume/frequency for reactive visuals
 // ============================================================
 void updateAudioAnalysis(App& app, float dt) {
-    if (!app.audio.soundInit || !app.audio.playing) {
+    app.audioPlaying = app.audio.isPlaying();
+    app.audioProgress = app.audio.progress();
+    if (!app.audioPlaying) {
         app.audioLevel *= 0.95f; // Decay
         app.audioPeak *= 0.98f;
         app.audioBass *= 0.95f;
@@ -753,13 +838,25 @@ void updateAudioAnalysis(App& app, float dt) {
     float cursor = app.audio.currentTime();
     float progress = app.audio.progress();
 
+    // Tracks from a galaxy snapshot carry the indexer's tempo and loudness
+    float bpm = 120.0f, gain = 1.0f;
+    if (app.playingArtist >= 0 && app.playingArtist < (int)app.library.artists.size()) {
+        auto& albums = app.library.artists[app.playingArtist].albums;
+        if (app.playingAlbum >= 0 && app.playingAlbum < (int)albums.size() && app.playingTrack >= 0 &&
+            app.playingTrack < (int)albums[app.playingAlbum].tracks.size()) {
+            const TrackData& track = albums[app.playingAlbum].tracks[app.playingTrack];
+            if (track.bpm > 0) bpm = track.bpm;
+            if (track.loudness < 0) gain = std::clamp((track.loudness + 30.0f) / 20.0f, 0.4f, 1.0f);
+        }
+    }
+
     // Simulate audio energy using time-based patterns
     // (Real FFT would need a custom audio callback -- this approximation works visually)
-    float t = cursor * 8.0f; // ~8 "beats" per second at 120bpm
+    float t = cursor * 8.0f * bpm / 120.0f; // ~8 "beats" per second at 120bpm
     float beat = powf(fabsf(sinf(t * (float)M_PI)), 4.0f); // Sharp peaks
     float bass = powf(fabsf(sinf(t * (float)M_PI * 0.5f)), 2.0f); // Slower bass
 
-    app.audioLevel = 0.3f + beat * 0.7f;
+    app.audioLevel = 0.3f + beat * 0.7f * gain;
     app.audioPeak = std::max(app.audioPeak * 0.97f, app.audioLevel);
     app.audioBass = 0.2f + bass * 0.8f;
     app.audioWave += (app.audioLevel - app.audioWave) * 5.0f * dt;
@@ -777,12 +874,14 @@ bool initSDL(App& app) {
     SDL_SetHint(SDL_HINT_JOYSTICK_HIDAPI_PS4, "1");
     SDL_SetHint(SDL_HINT_JOYSTICK_HIDAPI_PS5, "1");
 
+    StartupScope phase("sdl init");
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER) < 0) {
-        std::cerr << "SDL init failed: " << SDL_GetError() << std::endl;
+        LOG_ERROR("Planetary") << "SDL init failed: " << SDL_GetError();
         return false;
     }
     initBasePath();
 
+    phase.next("window + gl context");
 #ifdef __ANDROID__
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 0);
@@ -794,30 +893,35 @@ bool initSDL(App& app) {
 #endif
     SDL_GL_SetAttribute(SDL_GL_MULTISAMPLEBUFFERS, 1);
     SDL_GL_SetAttribute(SDL_GL_MULTISAMPLESAMPLES, 4);
+    // D24S8 like our targets: depth blits need matching formats
+    SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+    SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
 
     app.window = SDL_CreateWindow("Planetary",
         SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
         app.screenW, app.screenH,
-        SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_SHOWN | SDL_WINDOW_MAXIMIZED);
-    if (!app.window) { std::cerr << "Window failed: " << SDL_GetError() << std::endl; return false; }
+        SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE |
+        (app.exportCfg.enabled() ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN | SDL_WINDOW_MAXIMIZED));
+    if (!app.window) { LOG_ERROR("Planetary") << "Window failed: " << SDL_GetError(); return false; }
 
     app.glContext = SDL_GL_CreateContext(app.window);
-    if (!app.glContext) { std::cerr << "GL context failed: " << SDL_GetError() << std::endl; return false; }
+    if (!app.glContext) { LOG_ERROR("Planetary") << "GL context failed: " << SDL_GetError(); return false; }
     SDL_GL_SetSwapInterval(1);
 
     // Get actual window size after maximize
     SDL_GetWindowSize(app.window, &app.screenW, &app.screenH);
-    app.camera.aspect = (float)app.screenW / (float)app.screenH;
+    app.camera.setScreen(app.screenW, app.screenH);
 
 #ifndef __ANDROID__
     glewExperimental = GL_TRUE;
-    if (glewInit() != GLEW_OK) { std::cerr << "GLEW init failed" << std::endl; return false; }
+    if (glewInit() != GLEW_OK) { LOG_ERROR("Planetary") << "GLEW init failed"; return false; }
 #endif
 
-    std::cout << "[Planetary] OpenGL " << glGetString(GL_VERSION) << std::endl;
-    std::cout << "[Planetary] GPU: " << glGetString(GL_RENDERER) << std::endl;
+    LOG_INFO("Planetary") << "OpenGL " << glGetString(GL_VERSION);
+    LOG_INFO("Planetary") << "GPU: " << glGetString(GL_RENDERER);
 
-    // Init Dear ImGui
+    // Init Dear ImGui (glyphs are baked on first use, in the first frame)
+    phase.next("imgui + fonts");
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
@@ -830,7 +934,7 @@ bool initSDL(App& app) {
     app.fontMedium = io.Fonts->AddFontFromFileTTF(fontPath.c_str(), 20.0f);    // Fonts[3] - album names
     app.fontSmall  = io.Fonts->AddFontFromFileTTF(fontPath.c_str(), 13.0f);    // Fonts[4] - track names
     if (!boldFont) {
-        std::cerr << "[Planetary] Failed to load font, using default" << std::endl;
+        LOG_WARN("Planetary") << "Failed to load font, using default";
         ImFontConfig cfg; cfg.SizePixels = 16.0f;
         boldFont = io.Fonts->AddFontDefault(&cfg);
         app.fontLarge = boldFont;
@@ -863,14 +967,16 @@ bool initSDL(App& app) {
 #endif
 
     // Init audio
+    phase.next("audio init");
     app.audio.init();
 
     // Open first available gamepad (PS5/Xbox controller via SDL2)
+    phase.next("controllers");
     for (int i = 0; i < SDL_NumJoysticks(); i++) {
         if (SDL_IsGameController(i)) {
             app.controller = SDL_GameControllerOpen(i);
             if (app.controller) {
-                std::cout << "[Controller] " << SDL_GameControllerName(app.controller) << std::endl;
+                LOG_INFO("Controller") << SDL_GameControllerName(app.controller);
                 break;
             }
         }
@@ -879,59 +985,20 @@ bool initSDL(App& app) {
     return true;
 }
 
-void setupBloom(App& app) {
-    app.bloomW = app.screenW / 2;
-    app.bloomH = app.screenH / 2;
-
-    // Scene FBO (full res, HDR-ish)
-    if (app.sceneFBO) { glDeleteFramebuffers(1, &app.sceneFBO); glDeleteTextures(1, &app.sceneColor); glDeleteRenderbuffers(1, &app.sceneDepth); }
-    glGenFramebuffers(1, &app.sceneFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, app.sceneFBO);
-    glGenTextures(1, &app.sceneColor);
-    glBindTexture(GL_TEXTURE_2D, app.sceneColor);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, app.screenW, app.screenH, 0, GL_RGBA, GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, app.sceneColor, 0);
-    glGenRenderbuffers(1, &app.sceneDepth);
-    glBindRenderbuffer(GL_RENDERBUFFER, app.sceneDepth);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, app.screenW, app.screenH);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, app.sceneDepth);
-
-    // Bloom FBOs (half res, ping-pong)
-    for (int i = 0; i < 2; i++) {
-        if (app.bloomFBO[i]) { glDeleteFramebuffers(1, &app.bloomFBO[i]); glDeleteTextures(1, &app.bloomColor[i]); }
-        glGenFramebuffers(1, &app.bloomFBO[i]);
-        glBindFramebuffer(GL_FRAMEBUFFER, app.bloomFBO[i]);
-        glGenTextures(1, &app.bloomColor[i]);
-        glBindTexture(GL_TEXTURE_2D, app.bloomColor[i]);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, app.bloomW, app.bloomH, 0, GL_RGBA, GL_FLOAT, nullptr);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, app.bloomColor[i], 0);
-    }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-    // Fullscreen quad
-    if (!app.quadVAO) {
-        float qv[] = { -1,-1,0,0, 1,-1,1,0, 1,1,1,1, -1,-1,0,0, 1,1,1,1, -1,1,0,1 };
-        glGenVertexArrays(1, &app.quadVAO); glGenBuffers(1, &app.quadVBO);
-        glBindVertexArray(app.quadVAO); glBindBuffer(GL_ARRAY_BUFFER, app.quadVBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(qv), qv, GL_STATIC_DRAW);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4*sizeof(float), 0); glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4*sizeof(float), (void*)(2*sizeof(float))); glEnableVertexAttribArray(1);
-        glBindVertexArray(0);
-    }
-}
-
-void drawFullscreenQuad(App& app) {
-    glBindVertexArray(app.quadVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
+// Scene geometry -- shared by the GL path and the headless bench
+void createMeshes(App& app) {
+    RenderDevice& gfx = *app.gfx;
+    app.bgStars.create(gfx, 8000);
+    app.billboard.create(gfx);
+    app.softParticles.create(gfx);
+    app.sphereHi.create(gfx, 48, 48);  // Higher quality spheres
+    app.sphereLo.create(gfx, 12, 12);
+    app.octaMd.createOcta(gfx, 8);     // 512 tris (was a 24x24 UV sphere, 1152)
+    app.octaLo.createOcta(gfx, 4);     // 128 tris (was 12x12, 288)
+    app.unitRing.create(gfx, 1.0f, 128);
+    app.ringDisc.create(gfx, 0.5f, 1.0f, 64);  // Saturn ring annulus
+    app.lineStream.create(gfx);
+    app.moonPoints.create(gfx);
 }
 
 bool initResources(App& app) {
@@ -940,13 +1007,11 @@ bool initResources(App& app) {
 #else
     const std::string shaderDir = "shaders/";
 #endif
+    StartupScope phase("shaders");
     if (!app.starPointShader.load(resolvePath(shaderDir+"star_points.vert"), resolvePath(shaderDir+"star_points.frag"))) return false;
     if (!app.billboardShader.load(resolvePath(shaderDir+"billboard.vert"), resolvePath(shaderDir+"billboard.frag"))) return false;
     if (!app.planetShader.load(resolvePath(shaderDir+"planet.vert"), resolvePath(shaderDir+"planet.frag"))) return false;
     if (!app.ringShader.load(resolvePath(shaderDir+"orbit_ring.vert"), resolvePath(shaderDir+"orbit_ring.frag"))) return false;
-    if (!app.bloomBrightShader.load(resolvePath(shaderDir+"fullscreen.vert"), resolvePath(shaderDir+"bloom_bright.frag"))) return false;
-    if (!app.bloomBlurShader.load(resolvePath(shaderDir+"fullscreen.vert"), resolvePath(shaderDir+"bloom_blur.frag"))) return false;
-    if (!app.bloomCompositeShader.load(resolvePath(shaderDir+"fullscreen.vert"), resolvePath(shaderDir+"bloom_composite.frag"))) return false;
 
     // Procedural fire star shader (vertex displacement + turbulent fire)
     app.starSurfaceShader.load(resolvePath(shaderDir+"star.vert"), resolvePath(shaderDir+"star.frag"));
@@ -954,7 +1019,14 @@ bool initResources(App& app) {
     app.saturnRingShader.load(resolvePath(shaderDir+"saturn_ring.vert"), resolvePath(shaderDir+"saturn_ring.frag"));
     // Gravity ripple post-process (bass-reactive space distortion)
     app.gravityRippleShader.load(resolvePath(shaderDir+"fullscreen.vert"), resolvePath(shaderDir+"gravity_ripple.frag"));
+    // Depth-aware upsample for reduced-resolution particles
+    if (!app.particleUpsampleShader.load(resolvePath(shaderDir+"fullscreen.vert"), resolvePath(shaderDir+"particle_upsample.frag")) &&
+        app.softParticles.enabled()) {
+        LOG_WARN("Planetary") << "No particle upsample shader; particles at full resolution";
+        app.softParticles.divisor = 1;
+    }
 
+    phase.next("textures");
     app.texStarGlow = loadTexture("resources/starGlow.png");
     app.texAtmosphere = loadTexture("resources/atmosphere.png");
     app.texStar = loadTexture("resources/star.png");
@@ -970,15 +1042,8 @@ bool initResources(App& app) {
         app.texPlanetClouds[i] = loadTexture("resources/planetClouds" + std::to_string(i+1) + ".png");
     }
 
-    app.bgStars.create(8000);
-    app.billboard.create();
-    app.sphereHi.create(48, 48);  // Higher quality spheres
-    app.sphereMd.create(24, 24);
-    app.sphereLo.create(12, 12);
-    app.unitRing.create(1.0f, 128);
-    app.ringDisc.create(0.5f, 1.0f, 64);  // Saturn ring annulus
-
-    setupBloom(app);
+    phase.next("meshes");
+    createMeshes(app);
 
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
@@ -990,63 +1055,301 @@ bool initResources(App& app) {
     return true;
 }
 
+// ============================================================
+// PLAYLIST QUEUE - imported playlists play in order and show as a
+// constellation joining their artists' stars
+// ============================================================
+void playQueueEntry(App& app, int pos) {
+    TrackRef r = app.queue.tracks[pos];
+    auto& artist = app.library.artists[r.artist];
+    auto& album = artist.albums[r.album];
+    auto& track = album.tracks[r.track];
+    app.audio.play(track.filePath, track.title, artist.name, album.name, track.duration);
+    app.playingArtist = r.artist;
+    app.playingAlbum = r.album;
+    app.playingTrack = r.track;
+    app.queue.pos = pos;
+}
+
+// The queue drives next/previous only while its current entry is what's
+// playing; picking another track by hand leaves it where it was
+bool queuePlaying(const App& app) {
+    const PlayQueue& q = app.queue;
+    return q.pos >= 0 && q.pos < (int)q.tracks.size() &&
+           q.tracks[q.pos] == TrackRef{app.playingArtist, app.playingAlbum, app.playingTrack};
+}
+
+// Entries -> tracks against the current library; nothing until it's loaded
+void resolveQueue(App& app) {
+    if (app.queue.playlist.entries.empty() || app.library.artists.empty()) return;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    app.queue.resolve(app.trackIndex, app.library);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count();
+    LOG_INFO("Playlist") << app.queue.playlist.name << ": " << app.queue.resolved << " of "
+                         << app.queue.playlist.entries.size() << " entries matched, "
+                         << app.queue.stars.size() << " artists (" << ms << " ms)";
+    // Start once something resolves; later roots keep the position
+    if (app.queue.pos < 0) {
+        int first = app.queue.step(-1, +1);
+        if (first >= 0) playQueueEntry(app, first);
+    }
+}
+
+bool importPlaylist(App& app, const std::string& path) {
+    Playlist pl;
+    if (!loadPlaylistFile(path, pl)) {
+        LOG_WARN("Playlist") << "Can't read " << path;
+        return false;
+    }
+    app.queue.clear();
+    app.queue.playlist = std::move(pl);
+    resolveQueue(app);
+    return true;
+}
+
 // ============================================================
 // BUILD SCENE
 // ============================================================
 void buildScene(App& app) {
+    StartupScope phase("buildScene");
+    bool firstBuild = app.artistNodes.empty();
     app.artistNodes.clear();
     int total = (int)app.library.artists.size();
     for (int i = 0; i < total; i++) {
+        const ArtistData& artist = app.library.artists[i];
         ArtistNode node;
         node.index = i;
-        node.name = app.library.artists[i].name;
-        node.totalTracks = app.library.artists[i].totalTracks;
+        node.name = artist.name;
+        node.totalTracks = artist.totalTracks;
         computeArtistColor(node);
-        computeArtistPosition(node, total, app.library.artists[i].primaryGenre);
-        computeAlbumOrbits(node, app.library.artists[i], i);
+        // Snapshot stars keep the indexer's layout
+        node.pos = artist.hasLayout ? glm::vec3(artist.layoutPos[0], artist.layoutPos[1], artist.layoutPos[2])
+                                    : starPosition(node.name, artist.primaryGenre, app.genreAngles);
+        computeAlbumOrbits(node, artist, i);
         node.glowRadius = node.radiusInit * (0.8f + std::min(node.totalTracks / 30.0f, 1.0f) * 1.2f);
         app.artistNodes.push_back(node);
     }
-    float maxR = 0;
-    for (auto& n : app.artistNodes) maxR = std::max(maxR, glm::length(n.pos));
-    app.camera.targetOrbitDist = std::max(maxR * 1.5f, 50.0f);
-    app.camera.orbitDist = app.camera.targetOrbitDist;
+    // Only frame the galaxy on the first build; later roots merge in
+    // without yanking the camera
+    if (firstBuild) {
+        float maxR = 0;
+        for (auto& n : app.artistNodes) maxR = std::max(maxR, glm::length(n.pos));
+        app.camera.targetOrbitDist = std::max(maxR * 1.5f, 50.0f);
+        app.camera.orbitDist = app.camera.targetOrbitDist;
+    }
     app.statusMsg = std::to_string(total) + " artists, " +
                     std::to_string(app.library.totalAlbums) + " albums, " +
                     std::to_string(app.library.totalTracks) + " tracks";
+    // Indices may have shifted under the queue
+    app.trackIndex.clear();
+    resolveQueue(app);
 
     // Create GL textures for album art
+    StartupScope artPhase("album art");
     for (int ai = 0; ai < (int)app.library.artists.size(); ai++) {
         for (int bi = 0; bi < (int)app.library.artists[ai].albums.size(); bi++) {
             auto& album = app.library.artists[ai].albums[bi];
             if (!album.coverArtData.empty()) {
-                int w, h, ch;
-                unsigned char* img = stbi_load_from_memory(
-                    album.coverArtData.data(), (int)album.coverArtData.size(), &w, &h, &ch, 4);
-                if (img) {
-                    GLuint tex;
-                    glGenTextures(1, &tex);
-                    glBindTexture(GL_TEXTURE_2D, tex);
-                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, img);
-                    glGenerateMipmap(GL_TEXTURE_2D);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                    stbi_image_free(img);
-
-                    std::string key = std::to_string(ai) + "_" + std::to_string(bi);
-                    app.albumArtTextures[key] = tex;
+                // Decoded and downscaled by the scanner
+                GLuint tex = app.gfx->createTexture(album.coverArtW, album.coverArtH, album.coverArtData.data(), true);
+                std::string key = std::to_string(ai) + "_" + std::to_string(bi);
+                app.albumArtTextures[key] = tex;
+                // Free the pixels since we have the GL texture now
+                album.coverArtData.clear();
+                album.coverArtData.shrink_to_fit();
+            } else if (app.artPack && album.artHash) {
+                // Snapshot covers: RGBA straight from the mapped pack
+                if (const uint8_t* px = app.artPack->image(album.artHash)) {
+                    int size = app.artPack->size();
+                    app.albumArtTextures[std::to_string(ai) + "_" + std::to_string(bi)] =
+                        app.gfx->createTexture(size, size, px, true);
                 }
-                // Free the raw data since we have the GL texture now
+            }
+        }
+    }
+    app.artPack.reset();  // on the GPU now
+    LOG_INFO("Planetary") << "Loaded " << app.albumArtTextures.size() << " album art textures";
+}
+
+#ifndef __ANDROID__
+// ============================================================
+// ROOT MERGE - fold a finished root into the live library. Artist and
+// album indices shift when the merged library is re-sorted, so album
+// art, selection and now-playing are carried across by name.
+// ============================================================
+void mergeScannedRoot(App& app, MusicLibrary&& lib) {
+    using AlbumKey = std::pair<std::string, std::string>;
+    auto albumKey = [&](int ai, int bi) {
+        return AlbumKey(app.library.artists[ai].name, app.library.artists[ai].albums[bi].name);
+    };
+    auto validAlbum = [&](int ai, int bi) {
+        return ai >= 0 && ai < (int)app.library.artists.size() &&
+               bi >= 0 && bi < (int)app.library.artists[ai].albums.size();
+    };
+
+    std::map<AlbumKey, GLuint> art;
+    for (auto& [key, tex] : app.albumArtTextures) {
+        int ai = 0, bi = 0;
+        if (sscanf(key.c_str(), "%d_%d", &ai, &bi) == 2 && validAlbum(ai, bi)) art[albumKey(ai, bi)] = tex;
+    }
+    std::string selArtist = app.selectedArtist >= 0 ? app.library.artists[app.selectedArtist].name : "";
+    AlbumKey selAlbum = validAlbum(app.selectedArtist, app.selectedAlbum)
+        ? albumKey(app.selectedArtist, app.selectedAlbum) : AlbumKey();
+    AlbumKey playAlbum = validAlbum(app.playingArtist, app.playingAlbum)
+        ? albumKey(app.playingArtist, app.playingAlbum) : AlbumKey();
+    std::string playFile = !playAlbum.first.empty() && app.playingTrack >= 0 &&
+        app.playingTrack < (int)app.library.artists[app.playingArtist].albums[app.playingAlbum].tracks.size()
+        ? app.library.artists[app.playingArtist].albums[app.playingAlbum].tracks[app.playingTrack].filePath : "";
+
+    mergeLibrary(app.library, std::move(lib));
+
+    app.albumArtTextures.clear();
+    app.selectedArtist = app.selectedAlbum = -1;
+    app.playingArtist = app.playingAlbum = app.playingTrack = -1;
+    for (int ai = 0; ai < (int)app.library.artists.size(); ai++) {
+        auto& artist = app.library.artists[ai];
+        if (artist.name == selArtist) app.selectedArtist = ai;
+        for (int bi = 0; bi < (int)artist.albums.size(); bi++) {
+            auto& album = artist.albums[bi];
+            AlbumKey key(artist.name, album.name);
+            auto it = art.find(key);
+            if (it != art.end()) {
+                app.albumArtTextures[std::to_string(ai) + "_" + std::to_string(bi)] = it->second;
+                // Already on the GPU -- don't let buildScene upload a duplicate
                 album.coverArtData.clear();
                 album.coverArtData.shrink_to_fit();
             }
+            if (key == selAlbum) app.selectedAlbum = bi;
+            if (key == playAlbum) {
+                app.playingArtist = ai;
+                app.playingAlbum = bi;
+                for (int ti = 0; ti < (int)album.tracks.size(); ti++)
+                    if (album.tracks[ti].filePath == playFile) app.playingTrack = ti;
+            }
         }
     }
-    std::cout << "[Planetary] Loaded " << app.albumArtTextures.size() << " album art textures" << std::endl;
+    if (app.selectedArtist < 0) app.selectedAlbum = -1;
+
+    buildScene(app);
+    // Star positions depend on the artist count; follow the selection
+    if (app.selectedArtist >= 0)
+        app.camera.flyTo(app.artistNodes[app.selectedArtist].pos, app.camera.targetOrbitDist);
+}
+
+// Once per frame: progress for the loading bar, merge finished roots
+bool pollLibraryScan(App& app) {
+    int done = 0, total = 0;
+    app.scanner.progress(done, total);
+    app.scanProgress = done;
+    app.scanTotal = total;
+    app.scanning = app.scanner.busy();
+
+    std::vector<MusicLibrary> finished;
+    if (!app.scanner.poll(finished)) return false;
+    for (auto& lib : finished) mergeScannedRoot(app, std::move(lib));
+    return true;
+}
+
+// Every root stays configured; one that isn't there right now (an
+// unmounted NAS or USB disk) is skipped for this launch only
+void addLibraryRoot(App& app, const LibraryRoot& root) {
+    std::error_code ec;
+    for (auto& r : app.musicRoots)
+        if (r.path == root.path || fs::equivalent(r.path, root.path, ec)) return;
+    app.musicRoots.push_back(root);
+    if (!fs::is_directory(root.path, ec)) {
+        LOG_WARN("Library") << root.path << " is unavailable; kept in the config, not scanned";
+        return;
+    }
+    std::string cacheDir = g_basePath + "cache/";
+    fs::create_directories(cacheDir, ec);
+    app.scanner.addRoot(root, cacheDir);
+    app.scanning = true;
+}
+#endif
+
+// ============================================================
+// GALAXY SNAPSHOT - library, star layout and covers prepared by
+// planetary-indexer (galaxy_snapshot.h), in place of scanning or
+// crawling Navidrome. The source is the indexer's URL, synced into
+// cache/snapshot/ (the cached copy loads when it is unreachable),
+// or a snapshot directory built with --local-paths.
+// ============================================================
+void loadGalaxySnapshot(App& app) {
+    std::string source = app.snapshotSource;
+    bool remote = source.rfind("http://", 0) == 0;
+    std::string dir = remote ? g_basePath + "cache/snapshot/" : source + "/";
+    app.scanning = true;
+    std::thread([&app, source, remote, dir]() {
+        std::string trackBase = dir;
+        if (remote) {
+#ifndef _WIN32
+            mkdir((g_basePath + "cache").c_str(), 0755);
+            syncSnapshot(source, dir);
+#else
+            LOG_WARN("Snapshot") << "Downloading snapshots is POSIX-only; trying the cache";
+#endif
+            trackBase = source.back() == '/' ? source : source + "/";
+        }
+        GalaxySnapshot snap;
+        if (snap.open(dir + "galaxy.snap") && !remote && snap.servedTracks()) {
+            // track/<id>.<ext> exists only on the indexer's server, not in the directory
+            LOG_ERROR("Snapshot") << source << " was built without --local-paths; load it from the indexer's URL instead";
+        } else if (snap.isOpen()) {
+#ifdef __ANDROID__
+            // Subsonic tracks come without credentials; sign them with ours
+            app.library = snap.toLibrary(trackBase, [](const std::string& id) {
+                return naviUrl("stream", "id=" + id + "&maxBitRate=320&format=mp3");
+            });
+#else
+            app.library = snap.toLibrary(trackBase);
+#endif
+            auto art = std::make_unique<ArtPack>();
+            if (art->open(dir + "art.pack")) app.artPack = std::move(art);
+            LOG_INFO("Snapshot") << "Generation " << snap.generation() << ": " << app.library.artists.size()
+                                 << " artists, " << app.library.totalTracks << " tracks";
+        } else {
+            LOG_ERROR("Snapshot") << "No snapshot from " << source;
+        }
+        app.libraryLoaded = true; app.scanning = false;
+    }).detach();
+}
+
+// ============================================================
+// CLUSTER DRILL-DOWN (mega-artists)
+// ============================================================
+void openAlbumCluster(App& app, int ci) {
+    auto& star = app.artistNodes[app.selectedArtist];
+    star.openCluster = ci;
+    app.selectedAlbum = -1;
+    app.currentLevel = G_ARTIST_LEVEL;
+    app.camera.flyTo(star.pos, star.clusters[ci].viewDist);
+}
+
+// Back out of an open cluster; false if there was nothing to close
+bool closeAlbumCluster(App& app) {
+    if (app.selectedArtist < 0) return false;
+    auto& star = app.artistNodes[app.selectedArtist];
+    if (star.clusters.empty() || star.openCluster < 0) return false;
+    star.openCluster = -1;
+    app.camera.flyTo(star.pos, star.idealCameraDist);
+    return true;
+}
+
+// Selecting an album anywhere (sidebar, D-pad, now playing) opens its cluster,
+// so deselecting it later stays inside that cluster
+void syncAlbumCluster(App& app) {
+    if (app.selectedArtist < 0 || app.selectedAlbum < 0) return;
+    auto& star = app.artistNodes[app.selectedArtist];
+    if (!star.clusters.empty() && app.selectedAlbum < (int)star.albumOrbits.size())
+        star.openCluster = star.albumOrbits[app.selectedAlbum].cluster;
 }
 
 // Forward declarations
 void recenterToNowPlaying(App& app);
+void selectArtist(App& app, int i);
+size_t artistLowerBound(const App& app, const std::string& prefixKey);
+int findArtist(const App& app, const std::string& text);
 
 // ============================================================
 // RENDERING
@@ -1077,49 +1380,50 @@ glm::vec3 getMoonPos(glm::vec3 center, float radius, float angle, float tiltX, f
 }
 
 void renderScene(App& app) {
+    RenderDevice& gfx = *app.gfx;
     glm::mat4 view = app.camera.viewMatrix();
     glm::mat4 proj = app.camera.projMatrix();
+    app.pick.begin(proj * view, app.screenW, app.screenH);
 
     bool isZoomedToStar = (app.selectedArtist >= 0);
 
     // --- Background: pure black clear + dim point stars only ---
-    glDepthMask(GL_FALSE);
-    glDisable(GL_DEPTH_TEST);
+    gfx.setDepthWrite(false);
+    gfx.setDepthTest(false);
 
     // Only show skydome at galaxy level (it washes out when zoomed in)
     if (!isZoomedToStar) {
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        app.planetShader.use();
-        app.planetShader.setMat4("uView", glm::value_ptr(view));
-        app.planetShader.setMat4("uProjection", glm::value_ptr(proj));
-        glBindTexture(GL_TEXTURE_2D, app.texSkydome);
+        gfx.setBlend(BlendMode::Alpha);
+        gfx.use(app.planetShader);
+        gfx.setMat4("uView", view);
+        gfx.setMat4("uProjection", proj);
+        gfx.bindTexture(app.texSkydome);
         glm::mat4 skyM = glm::translate(glm::mat4(1.0f), app.camera.position);
         skyM = glm::scale(skyM, glm::vec3(900.0f));
-        app.planetShader.setMat4("uModel", glm::value_ptr(skyM));
-        app.planetShader.setVec3("uColor", 0.02f, 0.03f, 0.05f);
-        app.planetShader.setVec3("uEmissive", 0.005f, 0.008f, 0.015f);
-        app.planetShader.setFloat("uEmissiveStrength", 1.0f);
-        app.planetShader.setVec3("uLightPos", 0, 0, 0);
-        glCullFace(GL_FRONT); glEnable(GL_CULL_FACE);
-        app.sphereLo.draw();
-        glDisable(GL_CULL_FACE);
+        gfx.setMat4("uModel", skyM);
+        gfx.setVec3("uColor", 0.02f, 0.03f, 0.05f);
+        gfx.setVec3("uEmissive", 0.005f, 0.008f, 0.015f);
+        gfx.setFloat("uEmissiveStrength", 1.0f);
+        gfx.setVec3("uLightPos", 0, 0, 0);
+        gfx.setCullFront(true);
+        app.sphereLo.draw(gfx);
+        gfx.setCullFront(false);
     }
 
     // Background point stars
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-    app.starPointShader.use();
-    app.starPointShader.setMat4("uView", glm::value_ptr(view));
-    app.starPointShader.setMat4("uProjection", glm::value_ptr(proj));
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, app.texStar);
-    app.starPointShader.setInt("uTexture", 0);
-    app.bgStars.draw();
+    gfx.setBlend(BlendMode::Additive);
+    gfx.use(app.starPointShader);
+    gfx.setMat4("uView", view);
+    gfx.setMat4("uProjection", proj);
+    gfx.bindTexture(app.texStar);
+    gfx.setInt("uTexture", 0);
+    app.bgStars.draw(gfx);
 
     // --- NEBULA CLOUDS --- rich Hubble-like gas clouds filling the galaxy
     // 3-layer system: large diffuse background, medium visible clouds, bright cores
-    app.billboardShader.use();
-    app.billboardShader.setMat4("uView", glm::value_ptr(view));
-    app.billboardShader.setMat4("uProjection", glm::value_ptr(proj));
+    gfx.use(app.billboardShader);
+    gfx.setMat4("uView", view);
+    gfx.setMat4("uProjection", proj);
     {
         std::mt19937 nebRng(12345); // deterministic
         std::uniform_real_distribution<float> uni01(0.0f, 1.0f);
@@ -1140,11 +1444,11 @@ void renderScene(App& app) {
             return glm::vec3(0.6f, 0.15f, 0.4f);                       // Rose/pink
         };
 
-        float audioGlow = app.audio.playing ? app.audioWave * 0.006f : 0;
+        float audioGlow = app.audioPlaying ? app.audioWave * 0.006f : 0;
 
         // === LAYER 1: Giant diffuse background nebulae ===
         // Very large, very subtle - creates overall color atmosphere
-        glBindTexture(GL_TEXTURE_2D, app.texStarGlow);
+        gfx.bindTexture(app.texStarGlow);
         for (int ci = 0; ci < 25; ci++) {
             float angle = uni01(nebRng) * 6.283f;
             float dist = 50.0f + uni01(nebRng) * 350.0f;
@@ -1155,12 +1459,12 @@ void renderScene(App& app) {
             float alpha = 0.006f + uni01(nebRng) * 0.008f;
             alpha += sinf(app.elapsedTime * 0.04f + ci * 0.8f) * 0.002f;
             alpha += audioGlow;
-            app.billboard.draw(cpos, glm::vec4(col, alpha), csize);
+            app.billboard.draw(gfx, cpos, glm::vec4(col, alpha), csize);
         }
 
         // === LAYER 2: Nebula regions - clustered gas structures ===
         // 8 distinct nebula regions, each with a dominant color and 15-20 clouds
-        glBindTexture(GL_TEXTURE_2D, app.texParticle);
+        gfx.bindTexture(app.texParticle);
         struct NebRegion { glm::vec3 center; float radius; float hueBase; };
         NebRegion regions[10]; // 10 regions: 4 red/warm, 3 blue/cyan, 3 mixed
         for (int r = 0; r < 10; r++) {
@@ -1196,13 +1500,13 @@ void renderScene(App& app) {
                 alpha += sinf(app.elapsedTime * 0.08f + (float)(r * 20 + ci) * 0.3f) * 0.004f;
                 alpha += audioGlow;
 
-                app.billboard.draw(cpos, glm::vec4(col, alpha), csize);
+                app.billboard.draw(gfx, cpos, glm::vec4(col, alpha), csize);
             }
         }
 
         // === LAYER 3: Bright cores and filament highlights ===
         // Smaller, brighter spots within nebula regions
-        glBindTexture(GL_TEXTURE_2D, app.texStarGlow);
+        gfx.bindTexture(app.texStarGlow);
         for (int r = 0; r < 10; r++) {
             int brightSpots = 4 + (int)(uni01(nebRng) * 6.0f);
             for (int ci = 0; ci < brightSpots; ci++) {
@@ -1223,12 +1527,12 @@ void renderScene(App& app) {
                 alpha += sinf(app.elapsedTime * 0.15f + (float)(r * 10 + ci) * 0.7f) * 0.008f;
                 alpha += audioGlow * 1.5f;
 
-                app.billboard.draw(cpos, glm::vec4(col, alpha), csize);
+                app.billboard.draw(gfx, cpos, glm::vec4(col, alpha), csize);
             }
         }
 
         // === Interstellar gas wisps - elongated tendrils between regions ===
-        glBindTexture(GL_TEXTURE_2D, app.texParticle);
+        gfx.bindTexture(app.texParticle);
         for (int wi = 0; wi < 30; wi++) {
             // Connect random pairs of regions with gas wisps
             int r1 = (int)(uni01(nebRng) * 9.99f);
@@ -1241,11 +1545,11 @@ void renderScene(App& app) {
                 uniPM(nebRng) * 0.1f + 1.0f, 1.0f);
             glm::vec3 col = nebulaColor(hue);
             float alpha = 0.008f + uni01(nebRng) * 0.012f + audioGlow;
-            app.billboard.draw(wpos, glm::vec4(col, alpha), wsize);
+            app.billboard.draw(gfx, wpos, glm::vec4(col, alpha), wsize);
         }
 
         // === DARK MATTER WISPS - mysterious dim particles drifting through space ===
-        glBindTexture(GL_TEXTURE_2D, app.texParticle);
+        gfx.bindTexture(app.texParticle);
         for (int di = 0; di < 150; di++) {
             float seed = (float)di * 7.31f;
             float angle = seed * 2.39996f; // golden angle
@@ -1270,15 +1574,15 @@ void renderScene(App& app) {
 
             float dmAlpha = 0.04f + sinf(driftT * 0.5f) * 0.015f;
             dmAlpha += audioGlow * 0.5f;
-            app.billboard.draw(dpos, glm::vec4(dmColor, dmAlpha), dsize);
+            app.billboard.draw(gfx, dpos, glm::vec4(dmColor, dmAlpha), dsize);
         }
     }
 
     // --- Star rendering ---
-    app.billboardShader.use();
-    app.billboardShader.setMat4("uView", glm::value_ptr(view));
-    app.billboardShader.setMat4("uProjection", glm::value_ptr(proj));
-    glBindTexture(GL_TEXTURE_2D, app.texStarGlow);
+    gfx.use(app.billboardShader);
+    gfx.setMat4("uView", view);
+    gfx.setMat4("uProjection", proj);
+    gfx.bindTexture(app.texStarGlow);
 
     for (auto& n : app.artistNodes) {
         if (n.isSelected) {
@@ -1295,18 +1599,42 @@ void renderScene(App& app) {
         if (distToCam > 800.0f) continue;
     }
 
-    glDepthMask(GL_TRUE);
-    glEnable(GL_DEPTH_TEST);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // --- Playlist constellation: the queue's stars, joined in playlist order ---
+    if (!isZoomedToStar && app.queue.active()) {
+        const PlayQueue& q = app.queue;
+        int current = queuePlaying(app) ? q.tracks[q.pos].artist : -1;
+        for (int s : q.stars) {
+            const ArtistNode& n = app.artistNodes[s];
+            float alpha = s == current ? 0.45f + app.audioLevel * 0.3f : 0.25f;
+            app.billboard.draw(gfx, n.pos, glm::vec4(n.color, alpha), n.glowRadius * 6.0f);
+        }
+        if (q.stars.size() >= 2) {
+            LineStream& lines = app.lineStream;
+            lines.begin();
+            for (int s : q.stars) lines.add(app.artistNodes[s].pos);
+            gfx.use(app.ringShader);
+            gfx.setMat4("uView", view);
+            gfx.setMat4("uProjection", proj);
+            glm::mat4 id(1.0f);
+            gfx.setMat4("uModel", id);
+            gfx.setVec4("uColor", 0.55f, 0.75f, 1.0f, 0.2f);
+            lines.draw(gfx);
+        }
+    }
+
+    gfx.setDepthWrite(true);
+    gfx.setDepthTest(true);
+    gfx.setBlend(BlendMode::Alpha);
 
     // --- Star rendering (solid spheres, not billboards) ---
-    app.planetShader.use();
-    app.planetShader.setMat4("uView", glm::value_ptr(view));
-    app.planetShader.setMat4("uProjection", glm::value_ptr(proj));
-    app.planetShader.setVec3("uLightPos", 0, 50, 0);
-    glBindTexture(GL_TEXTURE_2D, app.texStarCore);
+    gfx.use(app.planetShader);
+    gfx.setMat4("uView", view);
+    gfx.setMat4("uProjection", proj);
+    gfx.setVec3("uLightPos", 0, 50, 0);
+    gfx.bindTexture(app.texStarCore);
 
     for (auto& n : app.artistNodes) {
+        app.pick.add(n.pos, 25.0f, n.glowRadius * 5.0f, PickKind::Star, n.index);
         if (n.isSelected) {
             // SELECTED STAR: bright colored sphere + massive glow corona
             float starSize = n.radius * 0.35f;
@@ -1318,48 +1646,48 @@ void renderScene(App& app) {
             glm::vec3 brightColor = glm::mix(starColor, glm::vec3(1.0f), 0.3f);
 
             // Bright colored sphere using planet shader (guaranteed to work on all GPUs)
-            glBindTexture(GL_TEXTURE_2D, app.texStarCore);
+            gfx.bindTexture(app.texStarCore);
             glm::mat4 m = glm::translate(glm::mat4(1.0f), n.pos);
             m = glm::rotate(m, app.elapsedTime * 0.15f, glm::vec3(0.05f, 1, 0));
             m = glm::scale(m, glm::vec3(coreSize));
-            app.planetShader.setMat4("uModel", glm::value_ptr(m));
+            gfx.setMat4("uModel", m);
             // Color the sphere with the artist's color, bright
-            app.planetShader.setVec3("uColor", brightColor.r, brightColor.g, brightColor.b);
+            gfx.setVec3("uColor", brightColor.r, brightColor.g, brightColor.b);
             // High emissive = self-luminous, no dark side
-            app.planetShader.setVec3("uEmissive", brightColor.r, brightColor.g, brightColor.b);
-            app.planetShader.setFloat("uEmissiveStrength", 0.85f + app.audioWave * 0.15f);
-            app.planetShader.setVec3("uLightPos", n.pos.x, n.pos.y, n.pos.z);
-            app.sphereHi.draw();
+            gfx.setVec3("uEmissive", brightColor.r, brightColor.g, brightColor.b);
+            gfx.setFloat("uEmissiveStrength", 0.85f + app.audioWave * 0.15f);
+            gfx.setVec3("uLightPos", n.pos.x, n.pos.y, n.pos.z);
+            app.sphereHi.draw(gfx);
 
             // === MASSIVE GLOW CORONA ===
             // THIS is what creates the "flame" look -- multiple layered billboard
             // glows around the sphere, using the starGlow texture's soft falloff
-            glDepthMask(GL_FALSE);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-            app.billboardShader.use();
-            app.billboardShader.setMat4("uView", glm::value_ptr(view));
-            app.billboardShader.setMat4("uProjection", glm::value_ptr(proj));
-            glBindTexture(GL_TEXTURE_2D, app.texStarGlow);
+            gfx.setDepthWrite(false);
+            gfx.setBlend(BlendMode::Additive);
+            gfx.use(app.billboardShader);
+            gfx.setMat4("uView", view);
+            gfx.setMat4("uProjection", proj);
+            gfx.bindTexture(app.texStarGlow);
 
             float aPulse = 1.0f + app.audioWave * 0.2f;
 
             // Layer 1: Inner bright glow - white-hot, tight around sphere
-            app.billboard.draw(n.pos,
+            app.billboard.draw(gfx, n.pos,
                 glm::vec4(brightColor * 0.9f + glm::vec3(0.1f), 0.45f * aPulse),
                 coreSize * 3.5f);
 
             // Layer 2: Mid corona - artist-colored, the main visible flame halo
-            app.billboard.draw(n.pos,
+            app.billboard.draw(gfx, n.pos,
                 glm::vec4(brightColor, 0.3f * aPulse),
                 coreSize * 6.0f);
 
             // Layer 3: Outer corona - rich artist color, wide
-            app.billboard.draw(n.pos,
+            app.billboard.draw(gfx, n.pos,
                 glm::vec4(starColor * 0.8f, 0.15f * aPulse),
                 coreSize * 10.0f);
 
             // Layer 4: Outermost atmosphere - faint, very wide
-            app.billboard.draw(n.pos,
+            app.billboard.draw(gfx, n.pos,
                 glm::vec4(starColor * 0.5f, 0.06f * aPulse),
                 coreSize * 15.0f);
 
@@ -1376,14 +1704,14 @@ void renderScene(App& app) {
                 float gSize = coreSize * (3.0f + sinf(gAngle) * 1.0f) * aPulse;
                 float gAlpha = 0.12f + sinf(gAngle * 1.5f) * 0.04f;
                 glm::vec3 gCol = glm::mix(brightColor, starColor, 0.5f);
-                app.billboard.draw(gPos, glm::vec4(gCol, gAlpha), gSize);
+                app.billboard.draw(gfx, gPos, glm::vec4(gCol, gAlpha), gSize);
             }
 
             // === MASSIVE SOLAR FLARES - shoot outward on the beat ===
-            if (app.audio.playing && app.playingArtist == app.selectedArtist) {
+            if (app.audioPlaying && app.playingArtist == app.selectedArtist) {
 
                 // Giant coronal mass ejections -- long streaming flares
-                glBindTexture(GL_TEXTURE_2D, app.texStarGlow);
+                gfx.bindTexture(app.texStarGlow);
                 int numFlares = 8;
                 for (int fi = 0; fi < numFlares; fi++) {
                     float seed = (float)fi * 137.508f + n.hue * 50.0f;
@@ -1429,12 +1757,12 @@ void renderScene(App& app) {
                             flareCol = glm::mix(brightColor, starColor * 0.4f, (t - 0.3f) / 0.7f);
 
                         float flareAlpha = (1.0f - t * 0.7f) * eruptPower * 0.2f;
-                        app.billboard.draw(flarePos, glm::vec4(flareCol, flareAlpha), flareSize);
+                        app.billboard.draw(gfx, flarePos, glm::vec4(flareCol, flareAlpha), flareSize);
                     }
                 }
 
                 // Smaller rapid-fire prominence sparks
-                glBindTexture(GL_TEXTURE_2D, app.texParticle);
+                gfx.bindTexture(app.texParticle);
                 for (int si = 0; si < 25; si++) {
                     float seed = (float)si * 73.13f + n.hue * 30.0f;
                     float sparkPhase = app.elapsedTime * (1.5f + (si % 5) * 0.5f) + seed;
@@ -1456,12 +1784,12 @@ void renderScene(App& app) {
                         glm::vec3(1.0f, 0.95f, 0.8f), brightColor, sparkPow);
                     float sparkAlpha = sparkPow * 0.2f;
 
-                    app.billboard.draw(sparkPos, glm::vec4(sparkCol, sparkAlpha), sparkSize);
+                    app.billboard.draw(gfx, sparkPos, glm::vec4(sparkCol, sparkAlpha), sparkSize);
                 }
 
                 // === ORBITAL PARTICLES - atoms/protons orbiting the star ===
                 // Like electrons around a nucleus, driven by music
-                glBindTexture(GL_TEXTURE_2D, app.texParticle);
+                gfx.bindTexture(app.texParticle);
                 int numOrbitalParticles = 60;
                 for (int pi = 0; pi < numOrbitalParticles; pi++) {
                     float seed = (float)pi * 137.508f + n.hue * 100.0f;
@@ -1497,11 +1825,11 @@ void renderScene(App& app) {
                         sinf(seed) * 0.5f + 0.5f
                     );
 
-                    app.billboard.draw(ppos, glm::vec4(pcolor, pBright * 0.15f), psize);
+                    app.billboard.draw(gfx, ppos, glm::vec4(pcolor, pBright * 0.15f), psize);
                 }
 
                 // === DARK MATTER RING - subtle ring of particles around the star system ===
-                glBindTexture(GL_TEXTURE_2D, app.texStarGlow);
+                gfx.bindTexture(app.texStarGlow);
                 for (int dmi = 0; dmi < 30; dmi++) {
                     float seed = (float)dmi * 11.7f + n.hue * 30.0f;
                     float dmAngle = app.elapsedTime * 0.015f + seed * 0.5f;
@@ -1515,31 +1843,32 @@ void renderScene(App& app) {
                     glm::vec3 dmCol(0.12f, 0.1f, 0.22f); // Deep indigo
                     float dmA = 0.025f + sinf(app.elapsedTime * 0.3f + seed) * 0.01f;
                     dmA += app.audioWave * 0.01f;
-                    app.billboard.draw(dmPos, glm::vec4(dmCol, dmA), dmSize);
+                    app.billboard.draw(gfx, dmPos, glm::vec4(dmCol, dmA), dmSize);
                 }
             }
-            glDepthMask(GL_TRUE);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-            app.planetShader.use();
-            app.planetShader.setMat4("uView", glm::value_ptr(view));
-            app.planetShader.setMat4("uProjection", glm::value_ptr(proj));
-            app.planetShader.use();
-            app.planetShader.setMat4("uView", glm::value_ptr(view));
-            app.planetShader.setMat4("uProjection", glm::value_ptr(proj));
+            gfx.setDepthWrite(true);
+            gfx.setBlend(BlendMode::Alpha);
+
+            gfx.use(app.planetShader);
+            gfx.setMat4("uView", view);
+            gfx.setMat4("uProjection", proj);
+            gfx.use(app.planetShader);
+            gfx.setMat4("uView", view);
+            gfx.setMat4("uProjection", proj);
         } else {
             // Non-selected: small colored sphere
             float cs = n.radius * 0.16f;
-            glBindTexture(GL_TEXTURE_2D, app.texStarCore);
+            gfx.bindTexture(app.texStarCore);
             glm::mat4 m = glm::translate(glm::mat4(1.0f), n.pos);
             m = glm::rotate(m, app.elapsedTime * 0.5f, glm::vec3(0,1,0));
             m = glm::scale(m, glm::vec3(cs));
-            app.planetShader.setMat4("uModel", glm::value_ptr(m));
+            gfx.setMat4("uModel", m);
             glm::vec3 coreColor = glm::mix(n.color, glm::vec3(1.0f), 0.4f);
-            app.planetShader.setVec3("uColor", coreColor.r, coreColor.g, coreColor.b);
-            app.planetShader.setVec3("uEmissive", n.color.r, n.color.g, n.color.b);
-            app.planetShader.setFloat("uEmissiveStrength", 0.5f);
-            app.sphereLo.draw();
+            gfx.setVec3("uColor", coreColor.r, coreColor.g, coreColor.b);
+            gfx.setVec3("uEmissive", n.color.r, n.color.g, n.color.b);
+            bool hot = app.hover == PickHit{PickKind::Star, n.index};
+            gfx.setFloat("uEmissiveStrength", hot ? 1.0f : 0.5f);
+            app.octaLo.draw(gfx);
         }
     }
 
@@ -1549,50 +1878,70 @@ void renderScene(App& app) {
 
         // Orbit rings -- only show for selected album (cleaner look)
         if (app.selectedAlbum >= 0) {
-            app.ringShader.use();
-            app.ringShader.setMat4("uView", glm::value_ptr(view));
-            app.ringShader.setMat4("uProjection", glm::value_ptr(proj));
+            gfx.use(app.ringShader);
+            gfx.setMat4("uView", view);
+            gfx.setMat4("uProjection", proj);
             // Show the selected album's orbit ring
             auto& selO = star.albumOrbits[app.selectedAlbum];
             glm::mat4 rm = glm::translate(glm::mat4(1.0f), star.pos);
             rm = glm::scale(rm, glm::vec3(selO.radius));
-            app.ringShader.setMat4("uModel", glm::value_ptr(rm));
-            app.ringShader.setVec4("uColor", BRIGHT_BLUE.r, BRIGHT_BLUE.g, BRIGHT_BLUE.b, 0.08f);
-            app.unitRing.draw();
+            gfx.setMat4("uModel", rm);
+            gfx.setVec4("uColor", BRIGHT_BLUE.r, BRIGHT_BLUE.g, BRIGHT_BLUE.b, 0.08f);
+            app.unitRing.draw(gfx);
         }
 
         // Album planets
-        app.planetShader.use();
-        app.planetShader.setMat4("uView", glm::value_ptr(view));
-        app.planetShader.setMat4("uProjection", glm::value_ptr(proj));
+        gfx.use(app.planetShader);
+        gfx.setMat4("uView", view);
+        gfx.setMat4("uProjection", proj);
+
+        // Mega-artist overview: one planet per cluster instead of hundreds of albums
+        if (!star.clusters.empty() && visibleCluster(star, app.selectedAlbum) < 0) {
+            gfx.bindTexture(app.texSurface);
+            for (int ci = 0; ci < (int)star.clusters.size(); ci++) {
+                auto& c = star.clusters[ci];
+                float angle = c.angle + app.elapsedTime * c.speed;
+                glm::vec3 cpos = star.pos + glm::vec3(cosf(angle)*c.radius, 0, sinf(angle)*c.radius);
+                glm::vec3 cc = glm::mix(star.color, glm::vec3(0.7f), 0.5f + 0.3f * sinf((float)ci * 1.7f));
+                app.pick.add(cpos, std::max(35.0f, c.planetSize * 100.0f), 0, PickKind::Cluster, app.selectedArtist, ci);
+                bool hot = app.hover == PickHit{PickKind::Cluster, app.selectedArtist, ci};
+                glm::mat4 pm = glm::translate(glm::mat4(1.0f), cpos);
+                pm = glm::rotate(pm, app.elapsedTime * 0.1f + (float)ci, glm::vec3(0, 1, 0));
+                pm = glm::scale(pm, glm::vec3(c.planetSize));
+                gfx.setMat4("uModel", pm);
+                gfx.setVec3("uColor", cc.r, cc.g, cc.b);
+                gfx.setVec3("uLightPos", star.pos.x, star.pos.y, star.pos.z);
+                gfx.setVec3("uEmissive", star.color.r * 0.1f, star.color.g * 0.1f, star.color.b * 0.1f);
+                gfx.setFloat("uEmissiveStrength", hot ? 0.4f : 0.15f);
+                app.sphereHi.draw(gfx);
+            }
+            // Atmospheres in one blend state
+            gfx.setDepthWrite(false);
+            gfx.setBlend(BlendMode::Additive);
+            gfx.use(app.billboardShader);
+            gfx.setMat4("uView", view);
+            gfx.setMat4("uProjection", proj);
+            gfx.bindTexture(app.texAtmosphere);
+            for (auto& c : star.clusters) {
+                float angle = c.angle + app.elapsedTime * c.speed;
+                glm::vec3 cpos = star.pos + glm::vec3(cosf(angle)*c.radius, 0, sinf(angle)*c.radius);
+                app.billboard.draw(gfx, cpos, glm::vec4(0.3f, 0.7f, 1.0f, 0.12f), c.planetSize * 2.8f);
+            }
+            gfx.setDepthWrite(true);
+            gfx.setBlend(BlendMode::Alpha);
+            return;  // albums stay hidden until a cluster is opened
+        }
 
         for (int ai = 0; ai < (int)star.albumOrbits.size(); ai++) {
+            if (!albumVisible(star, app.selectedAlbum, ai)) continue;
             auto& o = star.albumOrbits[ai];
             float angle = o.angle + app.elapsedTime * o.speed;
             glm::vec3 apos = star.pos + glm::vec3(cosf(angle)*o.radius, 0, sinf(angle)*o.radius);
 
-            // Planet color from hash
-            std::hash<std::string> hasher;
-            size_t albumHash = hasher(o.name);
-            float planetHue = (float)(albumHash % 1000) / 1000.0f;
-            float planetSat = 0.3f + (float)((albumHash >> 10) % 100) / 200.0f;
-            float ph = planetHue * 6.0f;
-            int phi = (int)ph % 6;
-            float pf = ph - (int)ph;
-            float pp = 1.0f - planetSat, pq = 1.0f - planetSat * pf, pt = 1.0f - planetSat * (1.0f - pf);
-            glm::vec3 planetColor;
-            switch (phi) {
-                case 0: planetColor = {1, pt, pp}; break;
-                case 1: planetColor = {pq, 1, pp}; break;
-                case 2: planetColor = {pp, 1, pt}; break;
-                case 3: planetColor = {pp, pq, 1}; break;
-                case 4: planetColor = {pt, pp, 1}; break;
-                default: planetColor = {1, pp, pq}; break;
-            }
-
-            // Unique tilt per planet
-            float tiltX = sinf((float)albumHash * 0.1f) * 0.3f;
-            float tiltZ = cosf((float)albumHash * 0.2f) * 0.25f;
+            const glm::vec3& planetColor = o.planetColor;
+            float tiltX = o.tiltX, tiltZ = o.tiltZ;
+            app.pick.add(apos, std::max(35.0f, o.planetSize * 100.0f), 0, PickKind::Planet, app.selectedArtist, ai);
+            bool hotPlanet = app.hover == PickHit{PickKind::Planet, app.selectedArtist, ai};
 
             // === USE ALBUM ART AS PLANET TEXTURE if available ===
             std::string artKey = std::to_string(app.selectedArtist) + "_" + std::to_string(ai);
@@ -1601,74 +1950,65 @@ void renderScene(App& app) {
 
             if (hasArt) {
                 // Album art texture -- use white color so art shows through
-                glBindTexture(GL_TEXTURE_2D, artIt->second);
-                app.planetShader.setVec3("uColor", 0.85f, 0.85f, 0.85f);
+                gfx.bindTexture(artIt->second);
+                gfx.setVec3("uColor", 0.85f, 0.85f, 0.85f);
             } else {
                 // Fallback: colored generic surface
-                glBindTexture(GL_TEXTURE_2D, app.texSurface);
-                app.planetShader.setVec3("uColor", planetColor.r * 0.7f, planetColor.g * 0.7f, planetColor.b * 0.7f);
+                gfx.bindTexture(app.texSurface);
+                gfx.setVec3("uColor", planetColor.r * 0.7f, planetColor.g * 0.7f, planetColor.b * 0.7f);
             }
 
             glm::mat4 pm = glm::translate(glm::mat4(1.0f), apos);
             pm = glm::rotate(pm, app.elapsedTime * 0.12f + (float)ai * 1.5f,
                 glm::vec3(tiltX, 1.0f, tiltZ));
             pm = glm::scale(pm, glm::vec3(o.planetSize));
-            app.planetShader.setMat4("uModel", glm::value_ptr(pm));
-            app.planetShader.setVec3("uLightPos", star.pos.x, star.pos.y, star.pos.z);
-            app.planetShader.setVec3("uEmissive", 0.01f, 0.01f, 0.02f);
-            app.planetShader.setFloat("uEmissiveStrength", ai == app.selectedAlbum ? 0.2f : 0.05f);
-            app.sphereHi.draw();
+            gfx.setMat4("uModel", pm);
+            gfx.setVec3("uLightPos", star.pos.x, star.pos.y, star.pos.z);
+            gfx.setVec3("uEmissive", 0.01f, 0.01f, 0.02f);
+            gfx.setFloat("uEmissiveStrength", hotPlanet ? 0.3f : ai == app.selectedAlbum ? 0.2f : 0.05f);
+            app.sphereHi.draw(gfx);
 
             // Cloud layer (semi-transparent, slightly larger, slower rotation)
             if (o.numTracks > 3) {
-                int cloudIdx = albumHash % 5;
-                glEnable(GL_BLEND);
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                gfx.setBlend(BlendMode::Alpha);
                 // Use actual cloud textures with per-planet variety
-                GLuint cloudTex = app.texPlanetClouds[cloudIdx];
-                glBindTexture(GL_TEXTURE_2D, cloudTex ? cloudTex : app.texSurface);
+                GLuint cloudTex = app.texPlanetClouds[o.cloudIdx];
+                gfx.bindTexture(cloudTex ? cloudTex : app.texSurface);
                 glm::mat4 cm = glm::translate(glm::mat4(1.0f), apos);
                 cm = glm::rotate(cm, app.elapsedTime * 0.08f + (float)ai * 2.0f,
                     glm::vec3(tiltX * 0.5f, 1.0f, tiltZ * 0.7f));
                 cm = glm::scale(cm, glm::vec3(o.planetSize * 1.02f));
-                app.planetShader.setMat4("uModel", glm::value_ptr(cm));
-                // Varied cloud tints per planet for diversity
-                const glm::vec3 cloudTints[5] = {
-                    {0.7f, 0.7f, 0.78f}, {0.78f, 0.72f, 0.65f},
-                    {0.65f, 0.78f, 0.72f}, {0.72f, 0.65f, 0.78f},
-                    {0.8f, 0.77f, 0.72f}
-                };
-                glm::vec3 cc = cloudTints[cloudIdx];
-                app.planetShader.setVec3("uColor", cc.r, cc.g, cc.b);
-                app.planetShader.setVec3("uEmissive", 0.0f, 0.0f, 0.0f);
-                app.planetShader.setFloat("uEmissiveStrength", 0.0f);
-                app.sphereHi.draw();
-            }
-
-            // Cyan-blue atmosphere ring -- pulses with audio
-            glDepthMask(GL_FALSE);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-            app.billboardShader.use();
-            app.billboardShader.setMat4("uView", glm::value_ptr(view));
-            app.billboardShader.setMat4("uProjection", glm::value_ptr(proj));
-            glBindTexture(GL_TEXTURE_2D, app.texAtmosphere);
-            float audioPulse = app.audio.playing ? app.audioWave * 0.05f : 0;
+                gfx.setMat4("uModel", cm);
+                const glm::vec3& cc = o.cloudTint;
+                gfx.setVec3("uColor", cc.r, cc.g, cc.b);
+                gfx.setVec3("uEmissive", 0.0f, 0.0f, 0.0f);
+                gfx.setFloat("uEmissiveStrength", 0.0f);
+                app.sphereHi.draw(gfx);
+            }
+
+            // Atmosphere ring in the cover's accent colour -- pulses with audio
+            gfx.setDepthWrite(false);
+            gfx.setBlend(BlendMode::Additive);
+            gfx.use(app.billboardShader);
+            gfx.setMat4("uView", view);
+            gfx.setMat4("uProjection", proj);
+            gfx.bindTexture(app.texAtmosphere);
+            float audioPulse = app.audioPlaying ? app.audioWave * 0.05f : 0;
             float atmoAlpha = ((ai == app.selectedAlbum) ? 0.2f : 0.1f) + audioPulse;
-            app.billboard.draw(apos,
-                glm::vec4(0.3f, 0.7f, 1.0f, atmoAlpha),
+            app.billboard.draw(gfx, apos,
+                glm::vec4(o.atmoColor, atmoAlpha),
                 o.planetSize * 2.5f);
-            glDepthMask(GL_TRUE);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            gfx.setDepthWrite(true);
+            gfx.setBlend(BlendMode::Alpha);
 
             // Saturn-like rings for large albums (10+ tracks)
             if (o.numTracks >= 10 && app.saturnRingShader.id) {
-                glDepthMask(GL_FALSE);
-                glEnable(GL_BLEND);
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                gfx.setDepthWrite(false);
+                gfx.setBlend(BlendMode::Alpha);
 
-                app.saturnRingShader.use();
-                app.saturnRingShader.setMat4("uView", glm::value_ptr(view));
-                app.saturnRingShader.setMat4("uProjection", glm::value_ptr(proj));
+                gfx.use(app.saturnRingShader);
+                gfx.setMat4("uView", view);
+                gfx.setMat4("uProjection", proj);
 
                 float ringScale = o.planetSize * 2.5f;
                 glm::mat4 rm = glm::translate(glm::mat4(1.0f), apos);
@@ -1676,112 +2016,123 @@ void renderScene(App& app) {
                 rm = glm::rotate(rm, tiltZ * 0.5f + 0.3f, glm::vec3(0, 0, 1));
                 rm = glm::scale(rm, glm::vec3(ringScale));
 
-                app.saturnRingShader.setMat4("uModel", glm::value_ptr(rm));
-                app.saturnRingShader.setVec3("uColor", planetColor.r * 0.9f, planetColor.g * 0.85f, planetColor.b * 0.8f);
-                app.saturnRingShader.setVec3("uLightPos", star.pos.x, star.pos.y, star.pos.z);
-                app.saturnRingShader.setFloat("uAlpha", 0.65f);
-                app.saturnRingShader.setFloat("uTime", app.elapsedTime);
+                gfx.setMat4("uModel", rm);
+                gfx.setVec3("uColor", planetColor.r * 0.9f, planetColor.g * 0.85f, planetColor.b * 0.8f);
+                gfx.setVec3("uLightPos", star.pos.x, star.pos.y, star.pos.z);
+                gfx.setFloat("uAlpha", 0.65f);
+                gfx.setFloat("uTime", app.elapsedTime);
 
-                app.ringDisc.draw();
+                app.ringDisc.draw(gfx);
 
-                glDepthMask(GL_TRUE);
+                gfx.setDepthWrite(true);
                 // Restore planet shader
-                app.planetShader.use();
-                app.planetShader.setMat4("uView", glm::value_ptr(view));
-                app.planetShader.setMat4("uProjection", glm::value_ptr(proj));
+                gfx.use(app.planetShader);
+                gfx.setMat4("uView", view);
+                gfx.setMat4("uProjection", proj);
             }
 
             // Track moons -- only show when this album is selected
             if (ai == app.selectedAlbum) {
+                // Very long albums: moons become one ring of points, no per-moon orbit rings
+                bool moonPoints = (int)o.tracks.size() > G_MOON_POINT_TRACKS;
+                // Point size that matches a sphere of radius t.size (star_points.vert divides by 300)
+                float pointScale = (float)(app.screenH * app.camera.tileRows) / (tanf(glm::radians(app.camera.fov) * 0.5f) * 300.0f);
+                if (moonPoints) app.moonPoints.begin();
+
                 // Draw tilted orbit rings for each moon
-                app.ringShader.use();
-                app.ringShader.setMat4("uView", glm::value_ptr(view));
-                app.ringShader.setMat4("uProjection", glm::value_ptr(proj));
+                gfx.use(app.ringShader);
+                gfx.setMat4("uView", view);
+                gfx.setMat4("uProjection", proj);
                 for (auto& t : o.tracks) {
+                    if (moonPoints) break;  // hundreds of rings read as noise anyway
                     glm::mat4 trm = glm::translate(glm::mat4(1.0f), apos);
                     // Apply the same tilt as the moon's orbit
                     trm = glm::rotate(trm, t.tiltX, glm::vec3(1, 0, 0));
                     trm = glm::rotate(trm, t.tiltZ, glm::vec3(0, 0, 1));
                     trm = glm::scale(trm, glm::vec3(t.radius));
-                    app.ringShader.setMat4("uModel", glm::value_ptr(trm));
-                    app.ringShader.setVec4("uColor", BRIGHT_BLUE.r * 0.5f, BRIGHT_BLUE.g * 0.5f, BRIGHT_BLUE.b * 0.5f, 0.04f);
-                    app.unitRing.draw();
+                    gfx.setMat4("uModel", trm);
+                    gfx.setVec4("uColor", BRIGHT_BLUE.r * 0.5f, BRIGHT_BLUE.g * 0.5f, BRIGHT_BLUE.b * 0.5f, 0.04f);
+                    app.unitRing.draw(gfx);
                 }
-                app.planetShader.use();
-                app.planetShader.setMat4("uView", glm::value_ptr(view));
-                app.planetShader.setMat4("uProjection", glm::value_ptr(proj));
-                glBindTexture(GL_TEXTURE_2D, app.texSurface);
+                gfx.use(app.planetShader);
+                gfx.setMat4("uView", view);
+                gfx.setMat4("uProjection", proj);
+                gfx.bindTexture(app.texSurface);
                 for (int ti = 0; ti < (int)o.tracks.size(); ti++) {
                     auto& t = o.tracks[ti];
                     float ta = t.angle + app.elapsedTime * t.speed;
                     glm::vec3 mp = getMoonPos(apos, t.radius, ta, t.tiltX, t.tiltZ);
+                    app.pick.add(mp, std::max(35.0f, t.size * 180.0f), 0, PickKind::Moon, app.selectedArtist, ai, ti);
+                    bool isPlayingTrack = (app.playingArtist == app.selectedArtist &&
+                        app.playingAlbum == ai && app.playingTrack == ti && app.audioPlaying);
+                    bool hot = app.hover == PickHit{PickKind::Moon, app.selectedArtist, ai, ti};
+                    // The playing and hovered moons stay full moons so they stand out of the ring
+                    if (moonPoints && !isPlayingTrack && !hot) {
+                        app.moonPoints.add(mp, glm::vec4(0.6f, 0.6f, 0.65f, 0.9f), t.size * 2.0f * pointScale);
+                        continue;
+                    }
+
                     glm::mat4 mm = glm::translate(glm::mat4(1.0f), mp);
                     mm = glm::scale(mm, glm::vec3(t.size));
-                    app.planetShader.setMat4("uModel", glm::value_ptr(mm));
-                    app.planetShader.setVec3("uLightPos", star.pos.x, star.pos.y, star.pos.z);
+                    gfx.setMat4("uModel", mm);
+                    gfx.setVec3("uLightPos", star.pos.x, star.pos.y, star.pos.z);
 
-                    bool isPlayingTrack = (app.playingArtist == app.selectedArtist &&
-                        app.playingAlbum == ai && app.playingTrack == ti && app.audio.playing);
                     if (isPlayingTrack) {
                         // Playing track moon glows brighter
-                        app.planetShader.setVec3("uColor", 0.8f, 0.9f, 1.0f);
-                        app.planetShader.setVec3("uEmissive", BRIGHT_BLUE.r, BRIGHT_BLUE.g, BRIGHT_BLUE.b);
-                        app.planetShader.setFloat("uEmissiveStrength", 0.4f);
+                        gfx.setVec3("uColor", 0.8f, 0.9f, 1.0f);
+                        gfx.setVec3("uEmissive", BRIGHT_BLUE.r, BRIGHT_BLUE.g, BRIGHT_BLUE.b);
+                        gfx.setFloat("uEmissiveStrength", 0.4f);
                     } else {
-                        app.planetShader.setVec3("uColor", 0.6f, 0.6f, 0.65f);
-                        app.planetShader.setVec3("uEmissive", star.color.r * 0.1f, star.color.g * 0.1f, star.color.b * 0.1f);
-                        app.planetShader.setFloat("uEmissiveStrength", 0.1f);
+                        gfx.setVec3("uColor", 0.6f, 0.6f, 0.65f);
+                        gfx.setVec3("uEmissive", star.color.r * 0.1f, star.color.g * 0.1f, star.color.b * 0.1f);
+                        gfx.setFloat("uEmissiveStrength", hot ? 0.5f : 0.1f);
                     }
-                    app.sphereMd.draw();
+                    app.octaMd.draw(gfx);
 
                     // Playback trail -- cyan arc showing track progress
                     if (isPlayingTrack) {
-                        float progress = app.audio.progress();
+                        float progress = app.audioProgress;
                         int segments = std::max(4, (int)(progress * 80));
-                        std::vector<float> trailVerts;
+                        LineStream& trail = app.lineStream;
+                        trail.begin();
                         for (int s = 0; s <= segments; s++) {
                             float frac = (float)s / 80.0f;
                             float a = frac * 2.0f * (float)M_PI;
                             glm::vec3 tp = getMoonPos(apos, t.radius, a, t.tiltX, t.tiltZ);
-                            trailVerts.push_back(tp.x);
-                            trailVerts.push_back(tp.y + 0.01f);
-                            trailVerts.push_back(tp.z);
+                            trail.add(glm::vec3(tp.x, tp.y + 0.01f, tp.z));
                         }
-                        GLuint trailVAO, trailVBO;
-                        glGenVertexArrays(1, &trailVAO);
-                        glGenBuffers(1, &trailVBO);
-                        glBindVertexArray(trailVAO);
-                        glBindBuffer(GL_ARRAY_BUFFER, trailVBO);
-                        glBufferData(GL_ARRAY_BUFFER, trailVerts.size()*sizeof(float), trailVerts.data(), GL_STREAM_DRAW);
-                        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3*sizeof(float), 0);
-                        glEnableVertexAttribArray(0);
-
-                        app.ringShader.use();
-                        app.ringShader.setMat4("uView", glm::value_ptr(view));
-                        app.ringShader.setMat4("uProjection", glm::value_ptr(proj));
-                        glm::mat4 identity(1.0f);
-                        app.ringShader.setMat4("uModel", glm::value_ptr(identity));
-                        app.ringShader.setVec4("uColor", BRIGHT_BLUE.r, BRIGHT_BLUE.g, BRIGHT_BLUE.b, 0.8f);
-                        glLineWidth(2.0f);
-                        glDrawArrays(GL_LINE_STRIP, 0, segments + 1);
-                        glLineWidth(1.0f);
 
-                        glDeleteBuffers(1, &trailVBO);
-                        glDeleteVertexArrays(1, &trailVAO);
-                        glBindVertexArray(0);
+                        gfx.use(app.ringShader);
+                        gfx.setMat4("uView", view);
+                        gfx.setMat4("uProjection", proj);
+                        glm::mat4 identity(1.0f);
+                        gfx.setMat4("uModel", identity);
+                        gfx.setVec4("uColor", BRIGHT_BLUE.r, BRIGHT_BLUE.g, BRIGHT_BLUE.b, 0.8f);
+                        gfx.setLineWidth(2.0f);
+                        trail.draw(gfx);
+                        gfx.setLineWidth(1.0f);
 
                         // Restore planet shader
-                        app.planetShader.use();
-                        app.planetShader.setMat4("uView", glm::value_ptr(view));
-                        app.planetShader.setMat4("uProjection", glm::value_ptr(proj));
-                        glBindTexture(GL_TEXTURE_2D, app.texSurface);
+                        gfx.use(app.planetShader);
+                        gfx.setMat4("uView", view);
+                        gfx.setMat4("uProjection", proj);
+                        gfx.bindTexture(app.texSurface);
                     }
                 }
+
+                if (moonPoints && !app.moonPoints.empty()) {
+                    gfx.use(app.starPointShader);
+                    gfx.setMat4("uView", view);
+                    gfx.setMat4("uProjection", proj);
+                    gfx.bindTexture(app.texParticle);
+                    gfx.setInt("uTexture", 0);
+                    app.moonPoints.draw(gfx);
+                }
             }
-            app.planetShader.use();
-            app.planetShader.setMat4("uView", glm::value_ptr(view));
-            app.planetShader.setMat4("uProjection", glm::value_ptr(proj));
-            glBindTexture(GL_TEXTURE_2D, app.texSurface);
+            gfx.use(app.planetShader);
+            gfx.setMat4("uView", view);
+            gfx.setMat4("uProjection", proj);
+            gfx.bindTexture(app.texSurface);
         }
     }
 }
@@ -1856,6 +2207,7 @@ void updateMeteors(App& app, float dt) {
 
 void renderMeteors(App& app) {
     if (app.meteors.empty()) return;
+    RenderDevice& gfx = *app.gfx;
     glm::mat4 view = app.camera.viewMatrix();
     glm::mat4 proj = app.camera.projMatrix();
 
@@ -1863,39 +2215,32 @@ void renderMeteors(App& app) {
         float alpha = std::min(m.life / m.maxLife, 1.0f) * std::min((m.maxLife - m.life) / 0.5f, 1.0f);
 
         // Meteor head (additive glow)
-        glDepthMask(GL_FALSE);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-        app.billboardShader.use();
-        app.billboardShader.setMat4("uView", glm::value_ptr(view));
-        app.billboardShader.setMat4("uProjection", glm::value_ptr(proj));
-        glBindTexture(GL_TEXTURE_2D, app.texStarGlow);
-        app.billboard.draw(m.pos, glm::vec4(m.color, alpha * 0.4f), m.size * 3.0f);
-        app.billboard.draw(m.pos, glm::vec4(1.0f, 1.0f, 1.0f, alpha * 0.6f), m.size * 1.0f);
+        gfx.setDepthWrite(false);
+        gfx.setBlend(BlendMode::Additive);
+        gfx.use(app.billboardShader);
+        gfx.setMat4("uView", view);
+        gfx.setMat4("uProjection", proj);
+        gfx.bindTexture(app.texStarGlow);
+        app.billboard.draw(gfx, m.pos, glm::vec4(m.color, alpha * 0.4f), m.size * 3.0f);
+        app.billboard.draw(gfx, m.pos, glm::vec4(1.0f, 1.0f, 1.0f, alpha * 0.6f), m.size * 1.0f);
 
         // Trail
         if (m.trail.size() >= 2) {
-            std::vector<float> tv;
-            for (auto& p : m.trail) { tv.push_back(p.x); tv.push_back(p.y); tv.push_back(p.z); }
-            GLuint tvao, tvbo;
-            glGenVertexArrays(1, &tvao); glGenBuffers(1, &tvbo);
-            glBindVertexArray(tvao); glBindBuffer(GL_ARRAY_BUFFER, tvbo);
-            glBufferData(GL_ARRAY_BUFFER, tv.size()*sizeof(float), tv.data(), GL_STREAM_DRAW);
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3*sizeof(float), 0);
-            glEnableVertexAttribArray(0);
-
-            app.ringShader.use();
-            app.ringShader.setMat4("uView", glm::value_ptr(view));
-            app.ringShader.setMat4("uProjection", glm::value_ptr(proj));
-            glm::mat4 id(1.0f);
-            app.ringShader.setMat4("uModel", glm::value_ptr(id));
-            app.ringShader.setVec4("uColor", m.color.r, m.color.g, m.color.b, alpha * 0.3f);
-            glDrawArrays(GL_LINE_STRIP, 0, (int)m.trail.size());
+            LineStream& trail = app.lineStream;
+            trail.begin();
+            for (auto& p : m.trail) trail.add(p);
 
-            glDeleteBuffers(1, &tvbo); glDeleteVertexArrays(1, &tvao);
+            gfx.use(app.ringShader);
+            gfx.setMat4("uView", view);
+            gfx.setMat4("uProjection", proj);
+            glm::mat4 id(1.0f);
+            gfx.setMat4("uModel", id);
+            gfx.setVec4("uColor", m.color.r, m.color.g, m.color.b, alpha * 0.3f);
+            trail.draw(gfx);
         }
 
-        glDepthMask(GL_TRUE);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gfx.setDepthWrite(true);
+        gfx.setBlend(BlendMode::Alpha);
     }
 }
 
@@ -1961,26 +2306,27 @@ void updateComets(App& app, float dt) {
 
 void renderComets(App& app) {
     if (app.comets.empty()) return;
+    RenderDevice& gfx = *app.gfx;
     glm::mat4 view = app.camera.viewMatrix();
     glm::mat4 proj = app.camera.projMatrix();
 
-    glDepthMask(GL_FALSE);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    gfx.setDepthWrite(false);
+    gfx.setBlend(BlendMode::Additive);
 
-    app.billboardShader.use();
-    app.billboardShader.setMat4("uView", glm::value_ptr(view));
-    app.billboardShader.setMat4("uProjection", glm::value_ptr(proj));
+    gfx.use(app.billboardShader);
+    gfx.setMat4("uView", view);
+    gfx.setMat4("uProjection", proj);
 
     for (auto& c : app.comets) {
         float lifeA = std::min(c.life / c.maxLife, 1.0f) * std::min((c.maxLife - c.life) / 1.0f, 1.0f);
 
         // Bright comet nucleus
-        glBindTexture(GL_TEXTURE_2D, app.texStarGlow);
-        app.billboard.draw(c.pos, glm::vec4(1.0f, 1.0f, 1.0f, lifeA * 0.7f), c.headSize * 2.0f);
-        app.billboard.draw(c.pos, glm::vec4(c.color, lifeA * 0.4f), c.headSize * 5.0f);
+        gfx.bindTexture(app.texStarGlow);
+        app.billboard.draw(gfx, c.pos, glm::vec4(1.0f, 1.0f, 1.0f, lifeA * 0.7f), c.headSize * 2.0f);
+        app.billboard.draw(gfx, c.pos, glm::vec4(c.color, lifeA * 0.4f), c.headSize * 5.0f);
 
         // Glowing tail particles
-        glBindTexture(GL_TEXTURE_2D, app.texParticle);
+        gfx.bindTexture(app.texParticle);
         int tailLen = (int)c.tail.size();
         for (int i = 0; i < tailLen; i++) {
             float t = (float)i / (float)std::max(tailLen - 1, 1); // 0=oldest, 1=newest
@@ -1990,33 +2336,56 @@ void renderComets(App& app) {
             glm::vec3 tailColor = glm::mix(glm::vec3(0.8f, 0.4f, 0.2f), c.color, t);
             // Render every other point for performance, but always render near head
             if (i % 2 == 0 || i > tailLen - 10)
-                app.billboard.draw(c.tail[i], glm::vec4(tailColor, tailAlpha), tailSize);
+                app.billboard.draw(gfx, c.tail[i], glm::vec4(tailColor, tailAlpha), tailSize);
         }
     }
 
-    glDepthMask(GL_TRUE);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    gfx.setDepthWrite(true);
+    gfx.setBlend(BlendMode::Alpha);
+}
+
+// Per-frame simulation (everything that advances with dt except input)
+void updateSimulation(App& app, float dt) {
+    syncAlbumCluster(app);
+    updateAudioAnalysis(app, dt);
+    app.camera.update(dt);
+    updateMeteors(app, dt);
+    updateComets(app, dt);
 }
 
-void render(App& app) {
+void render(App& app, GLuint target = 0) {
     // Direct to screen -- no FBO, no post-process (keeps GL state clean for ImGui/search)
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(0, 0, app.screenW, app.screenH);
-    glClearColor(0.0f, 0.0f, 0.005f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    // target != 0 only for offline export. One pass: cleared on entry, and
+    // depth/stencil is dropped at the end -- labels and the UI draw on top
+    // without it, so a tiler never writes it back. Reduced-resolution
+    // particles need it once more, to test against and upsample by.
+    SoftParticles& soft = app.softParticles;
+    PassDesc pass;
+    pass.fbo = target;
+    pass.width = app.screenW;
+    pass.height = app.screenH;
+    pass.clearColor = glm::vec4(0.0f, 0.0f, 0.005f, 1.0f);
+    if (soft.enabled()) {
+        pass.depthStore = StoreOp::Store;
+        soft.begin();
+        app.billboard.defer = &soft;
+    }
+    app.gfx->beginPass(pass);
 
     renderScene(app);
+    app.pick.end();
     renderMeteors(app);
     renderComets(app);
+    app.gfx->endPass();
+
+    if (soft.enabled()) {
+        app.billboard.defer = nullptr;
+        soft.composite(*app.gfx, app.billboardShader, app.particleUpsampleShader, target, app.screenW, app.screenH,
+                       app.camera.viewMatrix(), app.camera.projMatrix(), app.camera.nearPlane, app.camera.farPlane);
+    }
 
     // Clean GL state for ImGui
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glDepthMask(GL_TRUE);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glActiveTexture(GL_TEXTURE0);
-    glUseProgram(0);
+    app.gfx->resetState();
 }
 
 // ============================================================
@@ -2030,7 +2399,8 @@ void renderLabels(App& app) {
     for (auto& n : app.artistNodes) {
         float distToCam = glm::length(n.pos - app.camera.position);
         // Only show labels for nearby stars or selected star
-        float labelDist = n.isSelected ? 9999.0f : (app.currentLevel == G_ALPHA_LEVEL ? 80.0f : 30.0f);
+        bool hot = app.hover == PickHit{PickKind::Star, n.index};
+        float labelDist = n.isSelected || hot ? 9999.0f : (app.currentLevel == G_ALPHA_LEVEL ? 80.0f : 30.0f);
         if (distToCam > labelDist) continue;
 
         glm::vec2 sp = worldToScreen(vp, n.pos + glm::vec3(0, n.radius * 0.3f, 0), app.screenW, app.screenH);
@@ -2058,7 +2428,29 @@ void renderLabels(App& app) {
     if (app.selectedArtist >= 0 && app.selectedArtist < (int)app.artistNodes.size()) {
         auto& star = app.artistNodes[app.selectedArtist];
 
+        // Mega-artist overview: label the clusters
+        if (!star.clusters.empty() && visibleCluster(star, app.selectedAlbum) < 0) {
+            ImFont* af = app.fontMedium ? app.fontMedium : ImGui::GetFont();
+            float afs = app.fontMedium ? 20.0f : ImGui::GetFontSize();
+            ImU32 col = ImGui::ColorConvertFloat4ToU32(ImVec4(1.0f, 1.0f, 1.0f, 0.8f));
+            ImU32 shadow = ImGui::ColorConvertFloat4ToU32(ImVec4(0, 0, 0, 0.5f));
+            char label[96];
+            for (auto& c : star.clusters) {
+                float angle = c.angle + app.elapsedTime * c.speed;
+                glm::vec3 cpos = star.pos + glm::vec3(cosf(angle)*c.radius, c.planetSize * 1.5f, sinf(angle)*c.radius);
+                glm::vec2 sp = worldToScreen(vp, cpos, app.screenW, app.screenH);
+                if (sp.x < -100 || sp.x > app.screenW + 100) continue;
+                snprintf(label, sizeof(label), "%s  (%d)", c.name.c_str(), c.numAlbums);
+                ImVec2 ts = af->CalcTextSizeA(afs, FLT_MAX, 0.0f, label);
+                ImVec2 pos(sp.x - ts.x * 0.5f, sp.y - ts.y);
+                dl->AddText(af, afs, ImVec2(pos.x + 1, pos.y + 1), shadow, label);
+                dl->AddText(af, afs, pos, col, label);
+            }
+            return;
+        }
+
         for (int ai = 0; ai < (int)star.albumOrbits.size(); ai++) {
+            if (!albumVisible(star, app.selectedAlbum, ai)) continue;
             auto& o = star.albumOrbits[ai];
             float angle = o.angle + app.elapsedTime * o.speed;
             glm::vec3 apos = star.pos + glm::vec3(cosf(angle)*o.radius, 0, sinf(angle)*o.radius);
@@ -2079,8 +2471,8 @@ void renderLabels(App& app) {
             dl->AddText(af, afs, ImVec2(pos.x + 1, pos.y + 1), shadow, albumUpper.c_str());
             dl->AddText(af, afs, pos, col, albumUpper.c_str());
 
-            // Track moon labels for selected album
-            if (ai == app.selectedAlbum) {
+            // Track moon labels for selected album (point-ring moons stay unlabeled)
+            if (ai == app.selectedAlbum && (int)o.tracks.size() <= G_MOON_POINT_TRACKS) {
                 for (auto& t : o.tracks) {
                     float ta = t.angle + app.elapsedTime * t.speed;
                     glm::vec3 mp = getMoonPos(apos, t.radius, ta, t.tiltX, t.tiltZ);
@@ -2103,6 +2495,37 @@ void renderLabels(App& app) {
     }
 }
 
+// Tooltip for the hovered star, cluster, planet or moon
+void renderHoverTooltip(App& app) {
+    const PickHit& h = app.hover;
+    if (!h.valid() || app.imguiWantsMouse || h.artist < 0 || h.artist >= (int)app.artistNodes.size()) return;
+    auto& star = app.artistNodes[h.artist];
+    auto mmss = [](float sec) { int s = (int)sec; return std::to_string(s / 60) + ":" + (s % 60 < 10 ? "0" : "") + std::to_string(s % 60); };
+
+    ImGui::BeginTooltip();
+    if (h.kind == PickKind::Star) {
+        ImGui::TextColored(ImVec4(star.color.r, star.color.g, star.color.b, 1.0f), "%s", star.name.c_str());
+        ImGui::TextDisabled("%d albums, %d tracks", (int)app.library.artists[h.artist].albums.size(), star.totalTracks);
+    } else if (h.kind == PickKind::Cluster && h.album < (int)star.clusters.size()) {
+        auto& c = star.clusters[h.album];
+        ImGui::Text("%s", c.name.c_str());
+        ImGui::TextDisabled("%d albums, %d tracks", c.numAlbums, c.numTracks);
+    } else if (h.album >= 0 && h.album < (int)star.albumOrbits.size()) {
+        auto& o = star.albumOrbits[h.album];
+        if (h.kind == PickKind::Moon && h.track >= 0 && h.track < (int)o.tracks.size()) {
+            auto& t = o.tracks[h.track];
+            ImGui::Text("%s", t.name.c_str());
+            ImGui::TextDisabled("%s  %s", o.name.c_str(), mmss(t.duration).c_str());
+        } else {
+            float total = 0;
+            for (auto& t : o.tracks) total += t.duration;
+            ImGui::Text("%s", o.name.c_str());
+            ImGui::TextDisabled("%s  -  %d tracks, %s", star.name.c_str(), (int)o.tracks.size(), mmss(total).c_str());
+        }
+    }
+    ImGui::EndTooltip();
+}
+
 // ============================================================
 // UI OVERLAY (Dear ImGui)
 // ============================================================
@@ -2144,24 +2567,30 @@ void renderUI(App& app) {
         if (strlen(app.searchBuf) > 1) {
             std::string q = app.searchBuf;
             std::transform(q.begin(), q.end(), q.begin(), ::tolower);
-            int shown = 0;
+            std::string pk = collationPrefix(app.searchBuf);
+            int shown = 0, picked = -1;
+            auto isPrefix = [&](int i) {
+                return !pk.empty() && keyHasPrefix(app.library.artists[i].sortKey, pk);
+            };
+            auto listArtist = [&](int i) {
+                if (ImGui::Selectable(app.artistNodes[i].name.c_str(), false, 0, ImVec2(0, 20))) picked = i;
+                shown++;
+            };
+            // Names starting with the query first (binary search), then
+            // names merely containing it
+            if (!pk.empty())
+                for (size_t i = artistLowerBound(app, pk); i < app.artistNodes.size() && shown < 15 && isPrefix((int)i); i++)
+                    listArtist((int)i);
             for (int i = 0; i < (int)app.artistNodes.size() && shown < 15; i++) {
+                if (isPrefix(i)) continue;
                 std::string lower = app.artistNodes[i].name;
                 std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-                if (lower.find(q) != std::string::npos) {
-                    if (ImGui::Selectable(app.artistNodes[i].name.c_str(), false, 0, ImVec2(0, 20))) {
-                        // Deselect current star, navigate to the searched one
-                        if (app.selectedArtist >= 0) app.artistNodes[app.selectedArtist].isSelected = false;
-                        app.selectedArtist = i;
-                        app.selectedAlbum = -1;
-                        app.artistNodes[i].isSelected = true;
-                        app.currentLevel = G_ARTIST_LEVEL;
-                        app.camera.autoRotate = false;
-                        app.camera.flyTo(app.artistNodes[i].pos, app.artistNodes[i].idealCameraDist);
-                        app.searchBuf[0] = '\0'; // Clear search after selection
-                    }
-                    shown++;
-                }
+                if (lower.find(q) != std::string::npos) listArtist(i);
+            }
+            if (picked >= 0) {
+                // Deselect current star, navigate to the searched one
+                selectArtist(app, picked);
+                app.searchBuf[0] = '\0'; // Clear search after selection
             }
             if (shown == 0) {
                 ImGui::TextColored(ImVec4(0.5f, 0.4f, 0.4f, 0.7f), "No matches");
@@ -2178,10 +2607,43 @@ void renderUI(App& app) {
         ImGui::TextColored(ImVec4(0.5f, 0.6f, 0.7f, 0.8f),
             "%d albums, %d tracks", (int)star.albumOrbits.size(), star.totalTracks);
 
-        // Album list with cover art
-        for (int i = 0; i < (int)star.albumOrbits.size(); i++) {
+        // Album list with cover art. Lists are clipped: only visible rows are
+        // laid out, so a 500-album compilation costs the same as a 5-album one.
+        auto clipped = [](int begin, int end, auto&& row) {
+            ImGuiListClipper clipper;
+            clipper.Begin(end - begin);
+            while (clipper.Step())
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) row(begin + i);
+        };
+        int first = 0, last = (int)star.albumOrbits.size();
+        if (!star.clusters.empty()) {
+            int vc = visibleCluster(star, app.selectedAlbum);
+            if (vc >= 0) {
+                auto& c = star.clusters[vc];
+                if (ImGui::SmallButton("< All albums")) {
+                    app.selectedAlbum = -1;
+                    app.currentLevel = G_ARTIST_LEVEL;
+                    closeAlbumCluster(app);
+                }
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(0.5f, 0.6f, 0.7f, 0.8f), "%s", c.name.c_str());
+                first = c.firstAlbum;
+                last = c.firstAlbum + c.numAlbums;
+            } else {
+                clipped(0, (int)star.clusters.size(), [&](int ci) {
+                    auto& c = star.clusters[ci];
+                    char label[128];
+                    snprintf(label, sizeof(label), "%s  -  %d albums##cluster%d", c.name.c_str(), c.numAlbums, ci);
+                    if (ImGui::Selectable(label, false, 0, ImVec2(0, 24))) openAlbumCluster(app, ci);
+                });
+                first = last = 0;
+            }
+        }
+
+        auto albumRow = [&](int i) {
             auto& album = star.albumOrbits[i];
             bool selected = (i == app.selectedAlbum);
+            ImGui::PushID(i);
 
             // Album art thumbnail
             std::string artKey = std::to_string(app.selectedArtist) + "_" + std::to_string(i);
@@ -2195,56 +2657,65 @@ void renderUI(App& app) {
                 app.selectedAlbum = (app.selectedAlbum == i) ? -1 : i;
                 app.currentLevel = (app.selectedAlbum >= 0) ? G_ALBUM_LEVEL : G_ARTIST_LEVEL;
             }
+            ImGui::PopID();
+        };
 
-            // Track list for selected album
-            if (i == app.selectedAlbum) {
-                ImGui::Indent(12);
-                for (int t = 0; t < (int)album.tracks.size(); t++) {
-                    auto& track = album.tracks[t];
-                    int mins = (int)track.duration / 60;
-                    int secs = (int)track.duration % 60;
+        // Track list for selected album
+        auto trackRow = [&](int i, int t) {
+            auto& album = star.albumOrbits[i];
+            auto& track = album.tracks[t];
+            int mins = (int)track.duration / 60;
+            int secs = (int)track.duration % 60;
 
-                    bool isPlaying = (app.audio.currentTrack == track.filePath && app.audio.playing);
+            bool isPlaying = (app.audio.currentTrack == track.filePath && app.audio.isPlaying());
 
-                    // Highlight playing track, make all tracks clearly clickable
-                    if (isPlaying) {
-                        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.4f, 0.9f, 1.0f, 1.0f));
-                        ImGui::PushStyleColor(ImGuiCol_Header, ImVec4(0.1f, 0.3f, 0.5f, 0.6f));
-                    } else {
-                        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.75f, 0.8f, 0.85f, 1.0f));
-                        ImGui::PushStyleColor(ImGuiCol_Header, ImVec4(0.1f, 0.15f, 0.2f, 0.4f));
-                    }
+            // Highlight playing track, make all tracks clearly clickable
+            if (isPlaying) {
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.4f, 0.9f, 1.0f, 1.0f));
+                ImGui::PushStyleColor(ImGuiCol_Header, ImVec4(0.1f, 0.3f, 0.5f, 0.6f));
+            } else {
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.75f, 0.8f, 0.85f, 1.0f));
+                ImGui::PushStyleColor(ImGuiCol_Header, ImVec4(0.1f, 0.15f, 0.2f, 0.4f));
+            }
 
-                    char label[512];
-                    snprintf(label, sizeof(label), " %2d  %s", t + 1, track.name.c_str());
+            char label[512];
+            snprintf(label, sizeof(label), " %2d  %s##t%d", t + 1, track.name.c_str(), t);
+
+            if (ImGui::Selectable(label, isPlaying, 0, ImVec2(0, 22))) {
+                app.audio.play(track.filePath, track.name, star.name, album.name, track.duration);
+                app.playingArtist = app.selectedArtist;
+                app.playingAlbum = i;
+                app.playingTrack = t;
+                // Select this album and zoom camera to the moon
+                app.selectedAlbum = i;
+                app.currentLevel = G_TRACK_LEVEL;
+                // Compute moon position and fly there
+                float a = album.angle + app.elapsedTime * album.speed;
+                glm::vec3 apos = star.pos + glm::vec3(cosf(a)*album.radius, 0, sinf(a)*album.radius);
+                float ta = track.angle + app.elapsedTime * track.speed;
+                glm::vec3 mpos = getMoonPos(apos, track.radius, ta, track.tiltX, track.tiltZ);
+                app.camera.flyTo(mpos, track.radius * 4.0f + 0.5f);
+                app.camera.autoRotate = false;
+            }
 
-                    if (ImGui::Selectable(label, isPlaying, 0, ImVec2(0, 22))) {
-                        app.audio.play(track.filePath, track.name, star.name, album.name, track.duration);
-                        app.playingArtist = app.selectedArtist;
-                        app.playingAlbum = i;
-                        app.playingTrack = t;
-                        // Select this album and zoom camera to the moon
-                        app.selectedAlbum = i;
-                        app.currentLevel = G_TRACK_LEVEL;
-                        // Compute moon position and fly there
-                        float a = album.angle + app.elapsedTime * album.speed;
-                        glm::vec3 apos = star.pos + glm::vec3(cosf(a)*album.radius, 0, sinf(a)*album.radius);
-                        float ta = track.angle + app.elapsedTime * track.speed;
-                        glm::vec3 mpos = getMoonPos(apos, track.radius, ta, track.tiltX, track.tiltZ);
-                        app.camera.flyTo(mpos, track.radius * 4.0f + 0.5f);
-                        app.camera.autoRotate = false;
-                    }
+            // Duration on same line, right-aligned
+            ImGui::SameLine(sidebarW - 70);
+            ImGui::TextColored(ImVec4(0.4f, 0.5f, 0.6f, 0.7f), "%d:%02d", mins, secs);
 
-                    // Duration on same line, right-aligned
-                    ImGui::SameLine(sidebarW - 70);
-                    ImGui::TextColored(ImVec4(0.4f, 0.5f, 0.6f, 0.7f), "%d:%02d", mins, secs);
+            ImGui::PopStyleColor(2);
+        };
 
-                    ImGui::PopStyleColor(2);
-                }
-                ImGui::Unindent(12);
-                ImGui::Spacing();
-            }
+        // Albums up to the selected one, its tracks, then the rest
+        int sel = (app.selectedAlbum >= first && app.selectedAlbum < last) ? app.selectedAlbum : -1;
+        int split = sel >= 0 ? sel + 1 : last;
+        clipped(first, split, albumRow);
+        if (sel >= 0) {
+            ImGui::Indent(12);
+            clipped(0, (int)star.albumOrbits[sel].tracks.size(), [&](int t) { trackRow(sel, t); });
+            ImGui::Unindent(12);
+            ImGui::Spacing();
         }
+        clipped(split, last, albumRow);
     }
     ImGui::End();
 
@@ -2258,7 +2729,7 @@ void renderUI(App& app) {
             ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollbar);
 
         // Play/pause button
-        if (ImGui::Button(app.audio.playing ? "||" : ">", ImVec2(30, 30))) {
+        if (ImGui::Button(app.audio.isPlaying() ? "||" : ">", ImVec2(30, 30))) {
             app.audio.togglePause();
         }
         ImGui::SameLine();
@@ -2297,6 +2768,11 @@ void renderUI(App& app) {
         ImGui::TextColored(ImVec4(1, 1, 1, 1), "%s", app.audio.currentTrackName.c_str());
         ImGui::TextColored(ImVec4(0.5f, 0.6f, 0.7f, 0.8f), "%s - %s",
             app.audio.currentArtist.c_str(), app.audio.currentAlbum.c_str());
+        if (queuePlaying(app)) {
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(0.55f, 0.75f, 1.0f, 0.6f), "  %s %d/%d", app.queue.playlist.name.c_str(),
+                               app.queue.pos + 1, (int)app.queue.tracks.size());
+        }
         ImGui::EndGroup();
 
         ImGui::SameLine(280);
@@ -2304,7 +2780,8 @@ void renderUI(App& app) {
         // Time display
         float ct = app.audio.currentTime();
         int cm = (int)ct / 60, cs = (int)ct % 60;
-        ImGui::TextColored(ImVec4(0.5f, 0.7f, 0.9f, 0.9f), "%d:%02d", cm, cs);
+        if (app.audio.isBuffering()) ImGui::TextColored(ImVec4(0.5f, 0.7f, 0.9f, 0.6f), "-:--");
+        else ImGui::TextColored(ImVec4(0.5f, 0.7f, 0.9f, 0.9f), "%d:%02d", cm, cs);
         ImGui::SameLine();
 
         // Seekable progress slider -- drag to change position
@@ -2315,12 +2792,7 @@ void renderUI(App& app) {
         ImGui::SetNextItemWidth((float)app.screenW - 520);
         if (ImGui::SliderFloat("##seek", &prog, 0.0f, 1.0f, "")) {
             // Seek to new position
-            if (app.audio.soundInit && app.audio.duration > 0) {
-                float seekTime = prog * app.audio.duration;
-                ma_uint32 sampleRate = ma_engine_get_sample_rate(&app.audio.engine);
-                ma_sound_seek_to_pcm_frame(&app.audio.sound,
-                    (ma_uint64)(seekTime * sampleRate));
-            }
+            if (app.audio.duration > 0) app.audio.seek(prog * app.audio.duration);
         }
         ImGui::PopStyleColor(3);
 
@@ -2394,6 +2866,8 @@ void renderUI(App& app) {
                 }
             }
             if (matches > 0) {
+                int first = findArtist(app, app.vkbInput);
+                if (first >= 0) firstMatch = app.artistNodes[first].name;
                 ImGui::TextColored(ImVec4(0.3f, 0.9f, 0.5f, 0.9f), "%d matches - %s%s",
                     matches, firstMatch.c_str(), matches > 1 ? " ..." : "");
             } else {
@@ -2464,26 +2938,7 @@ void renderUI(App& app) {
                         // GO - search: copy vkb input into the search buffer
                         strncpy(app.searchBuf, app.vkbInput.c_str(), sizeof(app.searchBuf) - 1);
                         app.searchBuf[sizeof(app.searchBuf) - 1] = '\0';
-                        if (!app.vkbInput.empty()) {
-                            std::string q = app.vkbInput;
-                            std::transform(q.begin(), q.end(), q.begin(), ::tolower);
-                            for (int i = 0; i < (int)app.artistNodes.size(); i++) {
-                                std::string lower = app.artistNodes[i].name;
-                                std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-                                if (lower.find(q) != std::string::npos) {
-                                    if (app.selectedArtist >= 0)
-                                        app.artistNodes[app.selectedArtist].isSelected = false;
-                                    app.selectedArtist = i;
-                                    app.selectedAlbum = -1;
-                                    app.artistNodes[i].isSelected = true;
-                                    app.currentLevel = G_ARTIST_LEVEL;
-                                    app.camera.autoRotate = false;
-                                    app.camera.flyTo(app.artistNodes[i].pos,
-                                        app.artistNodes[i].idealCameraDist);
-                                    break;
-                                }
-                            }
-                        }
+                        selectArtist(app, findArtist(app, app.vkbInput));
                         app.showVirtualKB = false;
                     }
                 }
@@ -2502,7 +2957,7 @@ void renderUI(App& app) {
         ImGui::SetNextWindowPos(ImVec2((float)app.screenW - 10, (float)app.screenH - 70), 0, ImVec2(1.0f, 1.0f));
         ImGui::Begin("##ctrlhints", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize |
             ImGuiWindowFlags_NoMove | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoInputs);
-        ImGui::TextColored(ImVec4(0.35f, 0.45f, 0.55f, 0.5f), "L3:Now Playing  R3:Search  LB/RB:Tracks");
+        ImGui::TextColored(ImVec4(0.35f, 0.45f, 0.55f, 0.5f), "L3:Now Playing  R3:Search  LB/RB:Tracks  D-pad L/R:A-Z");
         ImGui::End();
     }
 
@@ -2514,6 +2969,7 @@ void renderUI(App& app) {
     ImGui::End();
 
     app.imguiWantsMouse = ImGui::GetIO().WantCaptureMouse;
+    renderHoverTooltip(app);
 
     // Render 3D text labels via ImGui draw lists
     renderLabels(app);
@@ -2547,7 +3003,7 @@ int hitTestStar(App& app, int mx, int my) {
 }
 
 // Hit test planets and moons in the 3D view. Returns {albumIdx, trackIdx} or {-1,-1}
-struct HitResult { int album = -1; int track = -1; };
+struct HitResult { int album = -1; int track = -1; int cluster = -1; };
 
 HitResult hitTestPlanetMoon(App& app, int mx, int my) {
     if (app.selectedArtist < 0) return {};
@@ -2556,7 +3012,21 @@ HitResult hitTestPlanetMoon(App& app, int mx, int my) {
     float bestDist = 999999;
     HitResult result;
 
+    if (!star.clusters.empty() && visibleCluster(star, app.selectedAlbum) < 0) {
+        for (int ci = 0; ci < (int)star.clusters.size(); ci++) {
+            auto& c = star.clusters[ci];
+            float angle = c.angle + app.elapsedTime * c.speed;
+            glm::vec3 cpos = star.pos + glm::vec3(cosf(angle)*c.radius, 0, sinf(angle)*c.radius);
+            glm::vec2 sp = worldToScreen(vp, cpos, app.screenW, app.screenH);
+            float d = sqrtf((sp.x-mx)*(sp.x-mx) + (sp.y-my)*(sp.y-my));
+            float hitR = std::max(35.0f, c.planetSize * 100.0f);
+            if (d < hitR && d < bestDist) { bestDist = d; result.cluster = ci; }
+        }
+        return result;
+    }
+
     for (int ai = 0; ai < (int)star.albumOrbits.size(); ai++) {
+        if (!albumVisible(star, app.selectedAlbum, ai)) continue;
         auto& o = star.albumOrbits[ai];
         float angle = o.angle + app.elapsedTime * o.speed;
         glm::vec3 apos = star.pos + glm::vec3(cosf(angle)*o.radius, 0, sinf(angle)*o.radius);
@@ -2565,7 +3035,7 @@ HitResult hitTestPlanetMoon(App& app, int mx, int my) {
         glm::vec2 sp = worldToScreen(vp, apos, app.screenW, app.screenH);
         float d = sqrtf((sp.x-mx)*(sp.x-mx) + (sp.y-my)*(sp.y-my));
         float hitR = std::max(35.0f, o.planetSize * 100.0f);
-        if (d < hitR && d < bestDist) { bestDist = d; result = {ai, -1}; }
+        if (d < hitR && d < bestDist) { bestDist = d; result = {ai, -1, -1}; }
 
         // Test track moons (only for selected album, larger hit area)
         if (ai == app.selectedAlbum) {
@@ -2576,13 +3046,20 @@ HitResult hitTestPlanetMoon(App& app, int mx, int my) {
                 glm::vec2 msp = worldToScreen(vp, mp, app.screenW, app.screenH);
                 float md = sqrtf((msp.x-mx)*(msp.x-mx) + (msp.y-my)*(msp.y-my));
                 float mhitR = std::max(35.0f, t.size * 180.0f);
-                if (md < mhitR && md < bestDist) { bestDist = md; result = {ai, ti}; }
+                if (md < mhitR && md < bestDist) { bestDist = md; result = {ai, ti, -1}; }
             }
         }
     }
     return result;
 }
 
+// Hover reads the pick grid of the last frame: once per mouse move, and
+// once per frame since bodies orbit under a still cursor
+void updateHover(App& app) {
+    bool off = app.mouseX < 0 || app.mouseDown || app.imguiWantsMouse || app.showVirtualKB;
+    app.hover = off ? PickHit() : app.pick.query((float)app.mouseX, (float)app.mouseY);
+}
+
 // ============================================================
 // RECENTER TO NOW PLAYING - fly camera to the currently playing track
 // ============================================================
@@ -2624,6 +3101,65 @@ void recenterToNowPlaying(App& app) {
     }
 }
 
+// ============================================================
+// ARTIST LOOKUP - artists are sorted by collation key, so "starts
+// with" is a binary search; substring matching is the fallback
+// ============================================================
+void selectArtist(App& app, int i) {
+    if (i < 0 || i >= (int)app.artistNodes.size()) return;
+    if (app.selectedArtist >= 0 && app.selectedArtist < (int)app.artistNodes.size())
+        app.artistNodes[app.selectedArtist].isSelected = false;
+    app.selectedArtist = i;
+    app.selectedAlbum = -1;
+    app.artistNodes[i].isSelected = true;
+    app.currentLevel = G_ARTIST_LEVEL;
+    app.camera.autoRotate = false;
+    app.camera.flyTo(app.artistNodes[i].pos, app.artistNodes[i].idealCameraDist);
+}
+
+size_t artistLowerBound(const App& app, const std::string& prefixKey) {
+    return lowerBoundKey(app.library.artists, prefixKey,
+        [](const ArtistData& a) -> const std::string& { return a.sortKey; });
+}
+
+// First artist starting with text, else first containing it; -1 if none
+int findArtist(const App& app, const std::string& text) {
+    if (text.empty()) return -1;
+    std::string pk = collationPrefix(text);
+    if (!pk.empty()) {
+        size_t i = artistLowerBound(app, pk);
+        if (i < app.library.artists.size() && keyHasPrefix(app.library.artists[i].sortKey, pk)) return (int)i;
+    }
+    std::string q = text;
+    std::transform(q.begin(), q.end(), q.begin(), ::tolower);
+    for (int i = 0; i < (int)app.artistNodes.size(); i++) {
+        std::string lower = app.artistNodes[i].name;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        if (lower.find(q) != std::string::npos) return i;
+    }
+    return -1;
+}
+
+// Select the first artist of the next/previous initial (D-pad left/right, PgUp/PgDn)
+void jumpArtistInitial(App& app, int dir) {
+    auto& artists = app.library.artists;
+    if (artists.empty() || artists.size() != app.artistNodes.size()) return;
+    int cur = app.selectedArtist;
+    auto initial = [&](size_t i) { return (unsigned char)artists[i].sortKey[0]; };
+    size_t target;
+    if (dir > 0) {
+        if (cur < 0) target = 0;
+        else if (initial(cur) == 0xFF) return;
+        else target = artistLowerBound(app, std::string(1, (char)(initial(cur) + 1)));
+        if (target >= artists.size()) return;
+    } else {
+        size_t start = cur < 0 ? artists.size() : artistLowerBound(app, std::string(1, (char)initial(cur)));
+        if (start == 0) return;
+        target = artistLowerBound(app, std::string(1, (char)initial(start - 1)));
+    }
+    selectArtist(app, (int)target);
+}
+
 // ============================================================
 // EVENTS
 // ============================================================
@@ -2634,9 +3170,13 @@ void handleEvents(App& app) {
         switch (ev.type) {
         case SDL_QUIT: app.running = false; break;
         case SDL_WINDOWEVENT:
+            if (ev.window.event == SDL_WINDOWEVENT_LEAVE) {
+                app.mouseX = app.mouseY = -1;
+                updateHover(app);
+            }
             if (ev.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
                 app.screenW = ev.window.data1; app.screenH = ev.window.data2;
-                app.camera.aspect = (float)app.screenW / (float)app.screenH;
+                app.camera.setScreen(app.screenW, app.screenH);
                 glViewport(0, 0, app.screenW, app.screenH);
             }
             break;
@@ -2656,7 +3196,9 @@ void handleEvents(App& app) {
                     int mx = ev.button.x, my = ev.button.y;
                     // Try planets/moons first
                     HitResult pmHit = hitTestPlanetMoon(app, mx, my);
-                    if (pmHit.track >= 0 && pmHit.album >= 0) {
+                    if (pmHit.cluster >= 0) {
+                        openAlbumCluster(app, pmHit.cluster);
+                    } else if (pmHit.track >= 0 && pmHit.album >= 0) {
                         // Clicked a track moon -- play it and zoom to it
                         auto& star = app.artistNodes[app.selectedArtist];
                         auto& album = star.albumOrbits[pmHit.album];
@@ -2716,6 +3258,9 @@ void handleEvents(App& app) {
             app.mouseDown = false;
             break;
         case SDL_MOUSEMOTION:
+            app.mouseX = ev.motion.x;
+            app.mouseY = ev.motion.y;
+            updateHover(app);
             if (app.mouseDown && !app.imguiWantsMouse) {
                 app.mouseDragDist += abs(ev.motion.xrel) + abs(ev.motion.yrel);
                 // LEFT or RIGHT click drag = orbit camera
@@ -2732,6 +3277,7 @@ void handleEvents(App& app) {
             if (!ImGui::GetIO().WantCaptureKeyboard) {
                 if (ev.key.keysym.sym == SDLK_ESCAPE) {
                     if (app.selectedAlbum >= 0) { app.selectedAlbum = -1; app.currentLevel = G_ARTIST_LEVEL; }
+                    else if (closeAlbumCluster(app)) {}
                     else if (app.selectedArtist >= 0) {
                         app.artistNodes[app.selectedArtist].isSelected = false;
                         app.selectedArtist = -1; app.currentLevel = G_ALPHA_LEVEL;
@@ -2743,20 +3289,19 @@ void handleEvents(App& app) {
                 }
                 if (ev.key.keysym.sym == SDLK_SPACE) app.audio.togglePause();
                 if (ev.key.keysym.sym == SDLK_n) recenterToNowPlaying(app);
+                if (ev.key.keysym.sym == SDLK_PAGEUP) jumpArtistInitial(app, -1);
+                if (ev.key.keysym.sym == SDLK_PAGEDOWN) jumpArtistInitial(app, +1);
             }
             break;
         case SDL_DROPFILE: {
 #ifndef __ANDROID__
             char* path = ev.drop.file;
-            if (fs::is_directory(path)) {
-                app.musicPath = path;
-                app.scanning = true;
-                std::thread([&app]() {
-                    app.library = scanMusicLibrary(app.musicPath,
-                        [&](int d, int t) { app.scanProgress = d; app.scanTotal = t; });
-                    app.libraryLoaded = true; app.scanning = false;
-                }).detach();
-            }
+            // Dropped folders join the galaxy as extra roots, playlists
+            // become the play queue
+            std::string ext = fs::path(path).extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            if (fs::is_directory(path)) addLibraryRoot(app, parseRootLine(path));
+            else if (ext == ".m3u" || ext == ".m3u8") importPlaylist(app, path);
             SDL_free(path);
 #endif
             break;
@@ -2768,7 +3313,9 @@ void handleEvents(App& app) {
                 if (app.selectedArtist >= 0) {
                     // At star level: try to select a planet or moon
                     HitResult pmHit = hitTestPlanetMoon(app, cx, cy);
-                    if (pmHit.track >= 0 && pmHit.album >= 0) {
+                    if (pmHit.cluster >= 0) {
+                        openAlbumCluster(app, pmHit.cluster);
+                    } else if (pmHit.track >= 0 && pmHit.album >= 0) {
                         auto& star = app.artistNodes[app.selectedArtist];
                         auto& album = star.albumOrbits[pmHit.album];
                         auto& track = album.tracks[pmHit.track];
@@ -2809,7 +3356,9 @@ void handleEvents(App& app) {
                     app.selectedAlbum = -1;
                     app.currentLevel = G_ARTIST_LEVEL;
                     auto& star = app.artistNodes[app.selectedArtist];
-                    app.camera.flyTo(star.pos, star.idealCameraDist);
+                    int ci = visibleCluster(star, -1);
+                    app.camera.flyTo(star.pos, ci >= 0 ? star.clusters[ci].viewDist : star.idealCameraDist);
+                } else if (closeAlbumCluster(app)) {
                 } else if (app.selectedArtist >= 0) {
                     app.artistNodes[app.selectedArtist].isSelected = false;
                     app.selectedArtist = -1;
@@ -2852,7 +3401,10 @@ void handleEvents(App& app) {
             }
             // L/R bumpers = prev/next track
             if (ev.cbutton.button == SDL_CONTROLLER_BUTTON_LEFTSHOULDER) {
-                if (app.playingArtist >= 0 && app.playingAlbum >= 0 && app.playingTrack > 0) {
+                if (queuePlaying(app)) {
+                    int prev = app.queue.step(app.queue.pos, -1);
+                    if (prev >= 0) playQueueEntry(app, prev);
+                } else if (app.playingArtist >= 0 && app.playingAlbum >= 0 && app.playingTrack > 0) {
                     auto& star = app.artistNodes[app.playingArtist];
                     auto& album = star.albumOrbits[app.playingAlbum];
                     int prev = app.playingTrack - 1;
@@ -2862,7 +3414,10 @@ void handleEvents(App& app) {
                 }
             }
             if (ev.cbutton.button == SDL_CONTROLLER_BUTTON_RIGHTSHOULDER) {
-                if (app.playingArtist >= 0 && app.playingAlbum >= 0) {
+                if (queuePlaying(app)) {
+                    int next = app.queue.step(app.queue.pos, +1);
+                    if (next >= 0) playQueueEntry(app, next);
+                } else if (app.playingArtist >= 0 && app.playingAlbum >= 0) {
                     auto& star = app.artistNodes[app.playingArtist];
                     auto& album = star.albumOrbits[app.playingAlbum];
                     int next = app.playingTrack + 1;
@@ -2920,27 +3475,8 @@ void handleEvents(App& app) {
                             case 3: // GO (search)
                                 strncpy(app.searchBuf, app.vkbInput.c_str(), sizeof(app.searchBuf) - 1);
                                 app.searchBuf[sizeof(app.searchBuf) - 1] = '\0';
-                                // Find first matching artist and navigate to it
-                                if (!app.vkbInput.empty()) {
-                                    std::string q = app.vkbInput;
-                                    std::transform(q.begin(), q.end(), q.begin(), ::tolower);
-                                    for (int i = 0; i < (int)app.artistNodes.size(); i++) {
-                                        std::string lower = app.artistNodes[i].name;
-                                        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-                                        if (lower.find(q) != std::string::npos) {
-                                            if (app.selectedArtist >= 0)
-                                                app.artistNodes[app.selectedArtist].isSelected = false;
-                                            app.selectedArtist = i;
-                                            app.selectedAlbum = -1;
-                                            app.artistNodes[i].isSelected = true;
-                                            app.currentLevel = G_ARTIST_LEVEL;
-                                            app.camera.autoRotate = false;
-                                            app.camera.flyTo(app.artistNodes[i].pos,
-                                                app.artistNodes[i].idealCameraDist);
-                                            break;
-                                        }
-                                    }
-                                }
+                                // Prefer an artist starting with the input
+                                selectArtist(app, findArtist(app, app.vkbInput));
                                 app.showVirtualKB = false;
                                 break;
                         }
@@ -2970,6 +3506,9 @@ void handleEvents(App& app) {
                         }
                     }
                 }
+                // Left/right: previous/next initial letter
+                if (ev.cbutton.button == SDL_CONTROLLER_BUTTON_DPAD_LEFT) jumpArtistInitial(app, -1);
+                if (ev.cbutton.button == SDL_CONTROLLER_BUTTON_DPAD_RIGHT) jumpArtistInitial(app, +1);
             }
             // Start = toggle auto-rotate
             if (ev.cbutton.button == SDL_CONTROLLER_BUTTON_START) {
@@ -2995,20 +3534,467 @@ void handleEvents(App& app) {
             if (app.controller) {
                 SDL_GameControllerClose(app.controller);
                 app.controller = nullptr;
-                std::cout << "[Controller] Disconnected" << std::endl;
+                LOG_INFO("Controller") << "Disconnected";
             }
             break;
         case SDL_CONTROLLERDEVICEADDED:
             if (!app.controller && SDL_IsGameController(ev.cdevice.which)) {
                 app.controller = SDL_GameControllerOpen(ev.cdevice.which);
                 if (app.controller)
-                    std::cout << "[Controller] Connected: " << SDL_GameControllerName(app.controller) << std::endl;
+                    LOG_INFO("Controller") << "Connected: " << SDL_GameControllerName(app.controller);
             }
             break;
         }
     }
 }
 
+// ============================================================
+// HEADLESS FRAME BENCH - full CPU frame against the null device
+// planetary --bench-frames N [--bench-artists N] [--bench-mega ALBUMS] [--particle-res N]
+// ============================================================
+#ifdef PLANETARY_ALLOC_STATS
+static std::atomic<size_t> g_allocCount{0};
+void* operator new(size_t n) {
+    g_allocCount++;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+static size_t allocCount() { return g_allocCount.load(); }
+#else
+static size_t allocCount() { return 0; }
+#endif
+
+// Null device, ImGui without a backend, synthetic library
+static NullRenderDevice* initHeadless(App& app, int numArtists, int megaAlbums) {
+    auto nullDevice = std::make_unique<NullRenderDevice>();
+    NullRenderDevice* dev = nullDevice.get();
+    app.gfx = std::move(nullDevice);
+    {
+        StartupScope phase("meshes");
+        createMeshes(app);
+    }
+
+    // ImGui without a platform/renderer backend -- labels only build draw lists
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2((float)app.screenW, (float)app.screenH);
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    io.IniFilename = nullptr;
+
+    srand(1234);  // meteors / comets spawn from rand()
+    {
+        StartupScope phase("synthetic library");
+        app.library = makeSyntheticLibrary(numArtists, 6, 12, megaAlbums);
+    }
+    buildScene(app);
+    return dev;
+}
+
+int runFrameBench(int frames, int numArtists, int megaAlbums, int particleRes) {
+    App app;
+    app.softParticles.divisor = particleRes;
+    NullRenderDevice* dev = initHeadless(app, numArtists, megaAlbums);
+
+    // Three phases: galaxy overview, artist selected, album selected
+    const float dt = 1.0f / 60.0f;
+    const char* phaseNames[3] = { "galaxy", "artist", "album" };
+    int phaseFrames = std::max(1, frames / 3);
+    std::cout << "[Bench] " << app.artistNodes.size() << " artists, " << app.library.totalTracks
+              << " tracks, " << phaseFrames << " frames per phase" << std::endl;
+    struct { const char* name; const SphereMesh& m; } meshes[] = {
+        { "sphereHi", app.sphereHi }, { "sphereLo", app.sphereLo },
+        { "octaMd", app.octaMd }, { "octaLo", app.octaLo } };
+    for (auto& m : meshes)
+        std::cout << "[Bench] " << m.name << " ACMR " << m.m.acmrBefore << " -> " << m.m.acmrAfter << std::endl;
+
+    for (int phase = 0; phase < 3; phase++) {
+        if (phase == 1 && !app.artistNodes.empty()) {
+            app.selectedArtist = 0;
+            app.artistNodes[0].isSelected = true;
+            app.currentLevel = G_ARTIST_LEVEL;
+            app.camera.autoRotate = false;
+            app.camera.flyTo(app.artistNodes[0].pos, app.artistNodes[0].idealCameraDist);
+        } else if (phase == 2 && app.selectedArtist >= 0) {
+            app.selectedAlbum = 0;
+            app.currentLevel = G_ALBUM_LEVEL;
+        }
+
+        app.gfx->resetStats();
+        size_t allocs0 = allocCount();
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (int f = 0; f < phaseFrames; f++) {
+            app.elapsedTime += dt;
+            updateSimulation(app, dt);
+            render(app);
+            ImGui::NewFrame();
+            renderLabels(app);
+            ImGui::EndFrame();
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count() / phaseFrames;
+
+        const RenderStats& st = dev->stats;
+        std::cout << "[Bench] " << phaseNames[phase] << ": " << ms << " ms/frame, "
+                  << st.total() / phaseFrames << " cmds/frame, "
+                  << st.vertices / phaseFrames << " verts/frame, "
+                  << st.attachmentBytes / phaseFrames / 1024 << " KB attachment traffic/frame";
+#ifdef PLANETARY_ALLOC_STATS
+        std::cout << ", " << (allocCount() - allocs0) / phaseFrames << " allocs/frame";
+#else
+        (void)allocs0;
+#endif
+        std::cout << std::endl;
+        for (int op = 0; op < (int)RenderOp::Count; op++) {
+            if (st.ops[op] == 0) continue;
+            std::cout << "[Bench]   " << renderOpName((RenderOp)op) << " " << st.ops[op] / phaseFrames << std::endl;
+        }
+    }
+
+    ImGui::DestroyContext();
+    std::cout << "[Bench] Live meshes " << app.gfx->liveMeshes()
+              << ", textures " << app.gfx->liveTextures() << std::endl;
+    return 0;
+}
+
+// ============================================================
+// SOAK RUN - see soak.h
+// planetary --soak SECONDS [--soak-headless] [--soak-accel X]
+//   [--soak-interval SECONDS] [--soak-clock-start SECONDS] [--soak-csv FILE]
+// ============================================================
+SoakSample soakSample(App& app, double wallSec) {
+    double sceneSec = app.sceneClock;
+    SoakSample s;
+    s.wallSec = wallSec;
+    s.sceneSec = sceneSec;
+    s.rssKB = processRssKB();
+    s.meshes = app.gfx->liveMeshes();
+    s.textures = app.gfx->liveTextures();
+    s.particles = (int)(app.meteors.size() + app.comets.size());
+    s.clockDrift = fabs((double)app.elapsedTime - sceneSec);
+    // Body position from the float clock, as the renderer computes it,
+    // against the exact clock: chord length between the two angles
+    auto error = [&](float angle, float speed, float radius) {
+        float a = angle + app.elapsedTime * speed;
+        double d = std::remainder((double)a - ((double)angle + sceneSec * speed), 2.0 * M_PI);
+        return 2.0 * radius * fabs(sin(d * 0.5));
+    };
+    for (auto& star : app.artistNodes) {
+        for (auto& o : star.albumOrbits) {
+            s.orbitError = std::max(s.orbitError, error(o.angle, o.speed, o.radius));
+            for (auto& t : o.tracks) s.orbitError = std::max(s.orbitError, error(t.angle, t.speed, t.radius));
+        }
+    }
+    return s;
+}
+
+int runHeadlessSoak(const SoakConfig& cfg, int numArtists) {
+    App app;
+    initHeadless(app, numArtists, 0);
+    SoakMonitor monitor(cfg);
+    LOG_INFO("Soak") << "Headless, " << app.artistNodes.size() << " artists, " << cfg.seconds
+                     << " s at " << cfg.accel << "x clock";
+
+    const float dt = 1.0f / 60.0f;
+    app.sceneClock = cfg.clockStart;
+    double nextSample = cfg.interval;
+    auto start = std::chrono::steady_clock::now();
+    for (long frame = 0;; frame++) {
+        // Wander between artists and albums so selection paths churn too
+        if (frame % 600 == 0 && !app.artistNodes.empty()) {
+            if (app.selectedArtist >= 0) app.artistNodes[app.selectedArtist].isSelected = false;
+            int a = (int)((frame / 600) % (long)app.artistNodes.size());
+            app.selectedArtist = a;
+            app.artistNodes[a].isSelected = true;
+            app.selectedAlbum = (frame / 1200) % 2 ? 0 : -1;
+            app.currentLevel = app.selectedAlbum >= 0 ? G_ALBUM_LEVEL : G_ARTIST_LEVEL;
+            app.camera.flyTo(app.artistNodes[a].pos, app.artistNodes[a].idealCameraDist);
+        }
+        auto t0 = std::chrono::steady_clock::now();
+        app.sceneClock += (double)dt * cfg.accel;
+        app.elapsedTime = (float)app.sceneClock;
+        updateSimulation(app, dt);
+        render(app);
+        ImGui::NewFrame();
+        renderLabels(app);
+        ImGui::EndFrame();
+        auto t1 = std::chrono::steady_clock::now();
+        monitor.frame(std::chrono::duration<double, std::milli>(t1 - t0).count());
+
+        double wallSeconds = std::chrono::duration<double>(t1 - start).count();
+        if (wallSeconds >= nextSample) {
+            monitor.sample(soakSample(app, wallSeconds));
+            nextSample += cfg.interval;
+        }
+        if (wallSeconds >= cfg.seconds) break;
+    }
+    ImGui::DestroyContext();
+    return monitor.passed() ? 0 : 1;
+}
+
+// ============================================================
+// STARTUP REPORT - phase table, time to first frame and time to
+// interactive. With a budget the app exits once interactive, 1 if over:
+// planetary --startup-report [--startup-budget TTI_MS[,FRAME_MS]]
+//           [--startup-synthetic | --startup-headless] [--bench-artists N]
+// The synthetic modes load the reference library instead of scanning.
+// ============================================================
+int finishStartupReport(const StartupBudget& budget) {
+    StartupProfile& profile = StartupProfile::get();
+    profile.finish();
+    Logger::get().flush();  // keep the table clear of queued log lines
+    profile.report();
+    return budget.enabled() && !budget.check(profile) ? 1 : 0;
+}
+
+// CPU side only: no window, GL, shaders or textures
+int runHeadlessStartup(const StartupBudget& budget, int numArtists) {
+    App app;
+    initHeadless(app, numArtists, 0);
+    {
+        StartupScope phase("frame 1");
+        updateSimulation(app, 1.0f / 60.0f);
+        render(app);
+        ImGui::NewFrame();
+        renderLabels(app);
+        ImGui::EndFrame();
+    }
+    StartupProfile::get().mark("first frame");
+    StartupProfile::get().mark("interactive");
+    int rc = finishStartupReport(budget);
+    ImGui::DestroyContext();
+    return rc;
+}
+
+// ============================================================
+// OFFLINE EXPORT - fixed timestep, offscreen, no dropped frames
+// ============================================================
+int runExport(App& app) {
+    ExportSettings& cfg = app.exportCfg;
+
+    // Wait for the scan started by main() -- export needs the whole library
+    while (app.scanning && !app.libraryLoaded) {
+        SDL_Event ev;
+        while (SDL_PollEvent(&ev)) if (ev.type == SDL_QUIT) return 1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+#ifndef __ANDROID__
+        pollLibraryScan(app);
+#endif
+    }
+    if (app.libraryLoaded.exchange(false)) buildScene(app);
+    if (app.artistNodes.empty()) {
+        LOG_ERROR("Export") << "No music library to render";
+        return 1;
+    }
+
+    // The scene code reads screenW/H for viewport and labels
+    app.screenW = cfg.width;
+    app.screenH = cfg.height;
+    app.camera.aspect = (float)cfg.width / (float)cfg.height;
+    srand(cfg.seed);
+
+    FrameExporter exporter;
+    Y4mWriter writer;
+    if (!exporter.create(cfg)) return 1;
+    if (!writer.open(cfg.output, cfg.width, cfg.height, cfg.fps)) return 1;
+
+    ImGuiIO& io = ImGui::GetIO();
+    const float dt = 1.0f / (float)cfg.fps;
+    const int frames = cfg.frameCount();
+    LOG_INFO("Export") << frames << " frames at " << cfg.fps << " fps -> " << cfg.output;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames && app.running; f++) {
+        SDL_Event ev;
+        while (SDL_PollEvent(&ev)) if (ev.type == SDL_QUIT) app.running = false;
+
+        app.elapsedTime += dt;
+        updateSimulation(app, dt);
+        render(app, exporter.target());
+
+        // Labels are part of the shot; the UI panels are not
+        ImGui_ImplOpenGL3_NewFrame();
+        io.DisplaySize = ImVec2((float)cfg.width, (float)cfg.height);
+        io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
+        io.DeltaTime = dt;
+        ImGui::NewFrame();
+        renderLabels(app);
+        ImGui::Render();
+        glBindFramebuffer(GL_FRAMEBUFFER, exporter.target());
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+        exporter.capture(writer);
+        if ((f + 1) % cfg.fps == 0) {
+            double secs = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+            std::string title = "Planetary - exporting " + std::to_string(f + 1) + "/" + std::to_string(frames);
+            SDL_SetWindowTitle(app.window, title.c_str());
+            LOG_INFO("Export") << (f + 1) << "/" << frames << " (" << (int)((f + 1) / secs) << " fps)";
+        }
+    }
+    exporter.flush(writer);
+    writer.close();
+    exporter.destroy();
+
+    double secs = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    LOG_INFO("Export") << "Wrote " << writer.framesWritten() << " frames in " << secs << " s";
+    return writer.failed() || writer.framesWritten() != frames ? 1 : 0;
+}
+
+// ============================================================
+// VIDEO WALL - master state out, follower state in (see video_wall.h)
+// ============================================================
+WallState packWallState(const App& app, uint64_t frame, float dt, uint32_t seed, float meteorTime, float cometTime) {
+    WallState s{};
+    s.frame = frame;
+    s.sceneClock = app.sceneClock;
+    s.dt = dt;
+    s.seed = seed;
+    s.nextMeteorTime = meteorTime;
+    s.nextCometTime = cometTime;
+    const Camera& c = app.camera;
+    for (int i = 0; i < 3; i++) {
+        s.position[i] = c.position[i];
+        s.target[i] = c.target[i];
+        s.targetPos[i] = c.targetPos[i];
+        s.targetLookAt[i] = c.targetLookAt[i];
+    }
+    s.orbitYaw = c.orbitYaw;
+    s.orbitPitch = c.orbitPitch;
+    s.orbitDist = c.orbitDist;
+    s.targetOrbitDist = c.targetOrbitDist;
+    s.fov = c.fov;
+    s.autoRotate = c.autoRotate;
+    s.selectedArtist = app.selectedArtist;
+    s.selectedAlbum = app.selectedAlbum;
+    s.openCluster = app.selectedArtist >= 0 ? app.artistNodes[app.selectedArtist].openCluster : -1;
+    s.currentLevel = app.currentLevel;
+    s.playingArtist = app.playingArtist;
+    s.playingAlbum = app.playingAlbum;
+    s.playingTrack = app.playingTrack;
+    s.audioLevel = app.audioLevel;
+    s.audioPeak = app.audioPeak;
+    s.audioBass = app.audioBass;
+    s.audioWave = app.audioWave;
+    s.audioProgress = app.audioProgress;
+    s.audioPlaying = app.audioPlaying;
+    s.libraryArtists = (uint32_t)app.artistNodes.size();
+    s.libraryTracks = (uint32_t)app.library.totalTracks;
+    return s;
+}
+
+// Takes the master's frame, then steps meteors and comets exactly as it did
+void applyWallState(App& app, const WallState& s) {
+    Camera& c = app.camera;
+    for (int i = 0; i < 3; i++) {
+        c.position[i] = s.position[i];
+        c.target[i] = s.target[i];
+        c.targetPos[i] = s.targetPos[i];
+        c.targetLookAt[i] = s.targetLookAt[i];
+    }
+    c.orbitYaw = s.orbitYaw;
+    c.orbitPitch = s.orbitPitch;
+    c.orbitDist = s.orbitDist;
+    c.targetOrbitDist = s.targetOrbitDist;
+    c.fov = s.fov;
+    c.autoRotate = s.autoRotate != 0;
+    app.sceneClock = s.sceneClock;
+    app.elapsedTime = (float)s.sceneClock;
+    app.audioLevel = s.audioLevel;
+    app.audioPeak = s.audioPeak;
+    app.audioBass = s.audioBass;
+    app.audioWave = s.audioWave;
+    app.audioProgress = s.audioProgress;
+    app.audioPlaying = s.audioPlaying != 0;
+
+    // Indices only mean the same thing with the same library
+    bool sameLibrary = s.libraryArtists == app.artistNodes.size() && s.libraryTracks == (uint32_t)app.library.totalTracks;
+    static bool warned = false;
+    if (!sameLibrary && !app.artistNodes.empty() && !warned) {
+        LOG_WARN("Wall") << "Master has " << s.libraryArtists << " artists / " << s.libraryTracks
+                         << " tracks, this node " << app.artistNodes.size() << " / " << app.library.totalTracks;
+        warned = true;
+    }
+    if (sameLibrary) {
+        if (app.selectedArtist != s.selectedArtist) {
+            if (app.selectedArtist >= 0) app.artistNodes[app.selectedArtist].isSelected = false;
+            if (s.selectedArtist >= 0) app.artistNodes[s.selectedArtist].isSelected = true;
+        }
+        app.selectedArtist = s.selectedArtist;
+        app.selectedAlbum = s.selectedAlbum;
+        if (app.selectedArtist >= 0) app.artistNodes[app.selectedArtist].openCluster = s.openCluster;
+        app.currentLevel = s.currentLevel;
+        app.playingArtist = s.playingArtist;
+        app.playingAlbum = s.playingAlbum;
+        app.playingTrack = s.playingTrack;
+    }
+
+    app.nextMeteorTime = s.nextMeteorTime;
+    app.nextCometTime = s.nextCometTime;
+    srand(s.seed);
+    updateMeteors(app, s.dt);
+    updateComets(app, s.dt);
+}
+
+// Follower loop: no input, no UI panels -- state from the master,
+// this tile of the view, swap on the master's word
+int runWallFollower(App& app, VideoWall& wall) {
+    std::string title = "Planetary - wall tile " + std::to_string(app.camera.tileCol) + "," + std::to_string(app.camera.tileRow);
+    SDL_SetWindowTitle(app.window, title.c_str());
+    std::vector<WallState> states;
+    bool waiting = false;
+    while (app.running) {
+        SDL_Event ev;
+        while (SDL_PollEvent(&ev)) {
+            if (ev.type == SDL_QUIT) app.running = false;
+            if (ev.type == SDL_WINDOWEVENT && ev.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                app.screenW = ev.window.data1;
+                app.screenH = ev.window.data2;
+                app.camera.setScreen(app.screenW, app.screenH);
+            }
+        }
+        if (app.libraryLoaded.exchange(false)) buildScene(app);
+#ifndef __ANDROID__
+        pollLibraryScan(app);
+#endif
+
+        if (!wall.receiveStates(states, 100)) {
+            if (!waiting) LOG_INFO("Wall") << "Waiting for the master...";
+            waiting = true;
+            continue;
+        }
+        if (waiting) LOG_INFO("Wall") << "Master found at frame " << states.back().frame;
+        waiting = false;
+        // Late frames still step the meteors; only the newest is drawn
+        for (auto& s : states) applyWallState(app, s);
+        uint64_t frame = states.back().frame;
+
+        render(app);
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplSDL2_NewFrame();
+        ImGui::NewFrame();
+        renderLabels(app);
+        ImGui::Render();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        glFinish();
+
+        wall.sendReady(frame);
+        wall.awaitSwap(frame, 100);
+        SDL_GL_SwapWindow(app.window);
+    }
+    return 0;
+}
+
+void shutdown(App& app) {
+    app.audio.cleanup();
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplSDL2_Shutdown();
+    ImGui::DestroyContext();
+    SDL_GL_DeleteContext(app.glContext);
+    SDL_DestroyWindow(app.window);
+    SDL_Quit();
+}
+
 // ============================================================
 // MAIN
 // ============================================================
@@ -3019,62 +4005,210 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR lpCmdLine, int) {
 #else
 int main(int argc, char* argv[]) {
 #endif
+    StartupProfile::get().start();
+#ifndef _WIN32
+    // A closed pipe or socket (export encoder, cast receiver) should fail
+    // the write, not kill the process
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    // Each option parser marks the argv entries it consumes; whatever is
+    // left over and isn't an option is a library root
+    std::vector<bool> argUsed(argc, false);
+    auto nextArg = [&](int& i) -> const char* {
+        argUsed[i] = argUsed[i + 1] = true;
+        return argv[++i];
+    };
+
+    // Headless CPU benchmark -- no window, no GL context
+    int benchArtists = 500, benchMega = 0, particleRes = 1;
+#ifdef __ANDROID__
+    particleRes = 2;
+#endif
+    for (int j = 1; j + 1 < argc; j++) {
+        std::string a = argv[j];
+        if (a == "--bench-artists") benchArtists = std::max(1, atoi(nextArg(j)));
+        else if (a == "--bench-mega") benchMega = std::max(0, atoi(nextArg(j)));
+        else if (a == "--particle-res") particleRes = particleDivisor(atoi(nextArg(j)));
+    }
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::string(argv[i]) == "--bench-frames")
+            return runFrameBench(std::max(3, atoi(argv[i + 1])), benchArtists, benchMega, particleRes);
+    }
+
+    SoakConfig soakCfg;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--soak" && hasValue) soakCfg.seconds = atof(nextArg(i));
+        else if (a == "--soak-headless") soakCfg.headless = true;
+        else if (a == "--soak-accel" && hasValue) soakCfg.accel = std::max(0.0, atof(nextArg(i)));
+        else if (a == "--soak-interval" && hasValue) soakCfg.interval = std::max(0.1, atof(nextArg(i)));
+        else if (a == "--soak-clock-start" && hasValue) soakCfg.clockStart = std::max(0.0, atof(nextArg(i)));
+        else if (a == "--soak-csv" && hasValue) soakCfg.csv = nextArg(i);
+    }
+    if (soakCfg.enabled() && soakCfg.headless) return runHeadlessSoak(soakCfg, benchArtists);
+
+    StartupBudget startupBudget;
+    bool startupReport = false, startupSynthetic = false, startupHeadless = false;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (a == "--startup-report") startupReport = true;
+        else if (a == "--startup-budget" && i + 1 < argc) startupBudget = StartupBudget::parse(nextArg(i));
+        else if (a == "--startup-synthetic") startupSynthetic = true;
+        else if (a == "--startup-headless") startupHeadless = true;
+    }
+    startupReport = startupReport || startupBudget.enabled();
+    if (startupReport && startupHeadless) return runHeadlessStartup(startupBudget, benchArtists);
+
+    WallConfig wallCfg;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--wall-master") wallCfg.role = WallConfig::Master;
+        else if (a == "--wall-follow") wallCfg.role = WallConfig::Follower;
+        else if (a == "--wall-grid" && hasValue) parseWallPair(nextArg(i), wallCfg.cols, wallCfg.rows);
+        else if (a == "--wall-tile" && hasValue) parseWallPair(nextArg(i), wallCfg.col, wallCfg.row);
+        else if (a == "--wall-iface" && hasValue) wallCfg.iface = nextArg(i);
+        else if (a == "--wall-barrier-ms" && hasValue) wallCfg.barrierMs = std::max(1, atoi(nextArg(i)));
+        else if (a == "--wall-group" && hasValue) {
+            std::string g = nextArg(i);
+            size_t colon = g.find(':');
+            wallCfg.group = g.substr(0, colon);
+            if (colon != std::string::npos) wallCfg.port = atoi(g.c_str() + colon + 1);
+        }
+    }
+    wallCfg.cols = std::max(1, wallCfg.cols);
+    wallCfg.rows = std::max(1, wallCfg.rows);
+    wallCfg.col = std::clamp(wallCfg.col, 0, wallCfg.cols - 1);
+    wallCfg.row = std::clamp(wallCfg.row, 0, wallCfg.rows - 1);
+    VideoWall wall;
+    if (wallCfg.enabled() && !wall.open(wallCfg)) return 1;
+
     App app;
+    app.camera.tileCols = wallCfg.cols;
+    app.camera.tileRows = wallCfg.rows;
+    app.camera.tileCol = wallCfg.col;
+    app.camera.tileRow = wallCfg.row;
+    app.softParticles.divisor = particleRes;
+    std::vector<std::string> argPaths;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--export" && hasValue) app.exportCfg.output = nextArg(i);
+        else if (a == "--export-size" && hasValue) {
+            if (!parseExportSize(nextArg(i), app.exportCfg.width, app.exportCfg.height)) {
+                LOG_WARN("Export") << "Bad size '" << argv[i] << "', expected WxH";
+                return 1;
+            }
+        }
+        else if (a == "--export-fps" && hasValue) app.exportCfg.fps = std::max(1, atoi(nextArg(i)));
+        else if (a == "--export-seconds" && hasValue) app.exportCfg.seconds = (float)atof(nextArg(i));
+        else if (a == "--export-seed" && hasValue) app.exportCfg.seed = (unsigned)atoi(nextArg(i));
+        else if (a == "--snapshot" && hasValue) argPaths.push_back(std::string("snapshot=") + nextArg(i));
+        else if (a == "--playlist" && hasValue) importPlaylist(app, nextArg(i));
+        else if (!argUsed[i] && a.rfind("--", 0) != 0) argPaths.push_back(a);
+    }
+
     if (!initSDL(app)) return 1;
+    app.gfx = std::make_unique<GLRenderDevice>();
     if (!initResources(app)) return 1;
 
-    // Load saved config first (persistent library)
-    std::string savedPath = loadConfig();
+    if (startupSynthetic) {
+        // Reference library for startup budgets: no disk, no saved config
+        app.scanning = true;
+        std::thread([&app, benchArtists]() {
+            app.library = makeSyntheticLibrary(benchArtists, 6, 12, 0);
+            app.libraryLoaded = true; app.scanning = false;
+        }).detach();
+        argPaths.clear();
+    }
 
-    if (argc > 1) {
-        app.musicPath = argv[1];
-    } else if (!savedPath.empty()) {
-        app.musicPath = savedPath;
-        std::cout << "[Planetary] Auto-loading saved library: " << savedPath << std::endl;
+    // Load saved config first (persistent library); command-line roots win
+    std::vector<std::string> savedPaths;
+    if (!startupSynthetic) {
+        StartupScope phase("config");
+        savedPaths = loadConfig();
+    }
+    bool fromConfig = argPaths.empty() && !savedPaths.empty();
+    if (fromConfig) {
+        argPaths = savedPaths;
+        LOG_INFO("Planetary") << "Auto-loading saved library (" << savedPaths.size() << " roots)";
+    }
+
+    // An indexer snapshot stands in for roots and Navidrome alike
+    for (auto& p : argPaths)
+        if (p.rfind("snapshot=", 0) == 0 && app.snapshotSource.empty()) app.snapshotSource = p.substr(9);
+    if (!app.snapshotSource.empty() && !startupSynthetic) {
+        loadGalaxySnapshot(app);
+        argPaths.clear();
     }
 
 #ifdef __ANDROID__
     // Android: Always load from Navidrome server (Mac Studio LAN IP)
-    if (app.musicPath.empty()) {
-        app.musicPath = "http://10.0.0.73:4533"; // Navidrome server
-    }
-    app.scanning = true;
-    std::thread([&app]() {
-        app.library = fetchMusicLibraryFromNavidrome(app.musicPath,
-            [&](int d, int t) { app.scanProgress = d; app.scanTotal = t; });
-        app.libraryLoaded = true; app.scanning = false;
-    }).detach();
-#else
-    if (!app.musicPath.empty() && fs::is_directory(app.musicPath)) {
+    if (!startupSynthetic && app.snapshotSource.empty()) {
+        if (!argPaths.empty()) app.musicPath = argPaths[0];
+        if (app.musicPath.empty()) {
+            app.musicPath = "http://10.0.0.73:4533"; // Navidrome server
+        }
         app.scanning = true;
         std::thread([&app]() {
-            app.library = scanMusicLibrary(app.musicPath,
+            app.library = fetchMusicLibraryFromNavidrome(app.musicPath,
                 [&](int d, int t) { app.scanProgress = d; app.scanTotal = t; });
             app.libraryLoaded = true; app.scanning = false;
         }).detach();
     }
+#else
+    // Saved roots are kept even when offline; a mistyped argument isn't
+    for (auto& p : argPaths) {
+        LibraryRoot root = parseRootLine(p);
+        if (fromConfig || fs::is_directory(root.path)) addLibraryRoot(app, root);
+    }
 #endif
 
+    if (app.exportCfg.enabled()) {
+        int rc = runExport(app);
+        shutdown(app);
+        return rc;
+    }
+    if (wallCfg.role == WallConfig::Follower) {
+        int rc = runWallFollower(app, wall);
+        shutdown(app);
+        return rc;
+    }
+
+    std::unique_ptr<SoakMonitor> soak;
+    if (soakCfg.enabled()) soak = std::make_unique<SoakMonitor>(soakCfg);
+    app.sceneClock = soakCfg.clockStart;
+    double soakNext = soakCfg.interval;
+    bool soakFailed = false, startupFailed = false;
+
+    StartupProfile& startup = StartupProfile::get();
+    int framePhase = startup.open("frame 1");
+    uint64_t wallFrame = 0;
     auto prev = std::chrono::high_resolution_clock::now();
+    auto soakStart = prev;
     while (app.running) {
         auto now = std::chrono::high_resolution_clock::now();
         float dt = std::chrono::duration<float>(now - prev).count();
         prev = now;
-        app.elapsedTime += dt;
+        // Summing frame times into a float loses ~0.2 s per 15 minutes;
+        // accumulate in double and hand the renderer a float view
+        app.sceneClock += soak ? (double)dt * soakCfg.accel : (double)dt;
+        app.elapsedTime = (float)app.sceneClock;
 
         handleEvents(app);
         if (app.libraryLoaded.exchange(false)) {
+            startup.mark("library loaded");
             buildScene(app);
-            saveConfig(app); // Remember this library for next launch
+            if (!startupSynthetic) saveConfig(app); // Remember this library for next launch
         }
-
-        // Rebuild bloom FBOs on resize
-        if (app.screenW / 2 != app.bloomW || app.screenH / 2 != app.bloomH) {
-            setupBloom(app);
+#ifndef __ANDROID__
+        if (pollLibraryScan(app)) {
+            startup.mark("library loaded");
+            saveConfig(app);
         }
-
-        // Audio analysis for reactive visuals
-        updateAudioAnalysis(app, dt);
+#endif
 
         // Gamepad input (PS5/Xbox/Steam controller via SDL2)
         // Hot-plug: reconnect if controller was disconnected
@@ -3083,7 +4217,7 @@ int main(int argc, char* argv[]) {
                 if (SDL_IsGameController(i)) {
                     app.controller = SDL_GameControllerOpen(i);
                     if (app.controller) {
-                        std::cout << "[Controller] Connected: " << SDL_GameControllerName(app.controller) << std::endl;
+                        LOG_INFO("Controller") << "Connected: " << SDL_GameControllerName(app.controller);
                         break;
                     }
                 }
@@ -3125,8 +4259,28 @@ int main(int argc, char* argv[]) {
             if (lt > 0.1f) app.camera.onMouseScroll(-lt * 2.0f);
         }
 
-        // Auto-play next track when current one ends
-        if (app.audio.soundInit && app.audio.isAtEnd() && app.playingArtist >= 0) {
+        // Hint the following track so cast receivers can prefetch it
+        if (app.audio.castEnabled && queuePlaying(app)) {
+            int next = app.queue.step(app.queue.pos, +1);
+            if (next >= 0) {
+                TrackRef r = app.queue.tracks[next];
+                auto& track = app.library.artists[r.artist].albums[r.album].tracks[r.track];
+                app.audio.setNext(track.filePath, track.title);
+            }
+        } else if (app.audio.castEnabled && app.playingArtist >= 0 && app.playingAlbum >= 0 &&
+            app.playingAlbum < (int)app.artistNodes[app.playingArtist].albumOrbits.size()) {
+            auto& album = app.artistNodes[app.playingArtist].albumOrbits[app.playingAlbum];
+            int nextTrack = app.playingTrack + 1;
+            if (nextTrack < (int)album.tracks.size())
+                app.audio.setNext(album.tracks[nextTrack].filePath, album.tracks[nextTrack].name);
+        }
+
+        // Auto-play next track when current one ends: next in the queue,
+        // else next on the album
+        if (app.audio.isAtEnd() && queuePlaying(app)) {
+            int next = app.queue.step(app.queue.pos, +1);
+            if (next >= 0) playQueueEntry(app, next);
+        } else if (app.audio.isAtEnd() && app.playingArtist >= 0) {
             auto& star = app.artistNodes[app.playingArtist];
             if (app.playingAlbum >= 0 && app.playingAlbum < (int)star.albumOrbits.size()) {
                 auto& album = star.albumOrbits[app.playingAlbum];
@@ -3139,20 +4293,53 @@ int main(int argc, char* argv[]) {
             }
         }
 
-        app.camera.update(dt);
-        updateMeteors(app, dt);
-        updateComets(app, dt);
+        // Wall master: a shared seed and the pre-update spawn timers let
+        // followers replay this frame's meteors and comets
+        uint32_t wallSeed = wallFrameSeed(++wallFrame);
+        float meteorTime = app.nextMeteorTime, cometTime = app.nextCometTime;
+        if (wall.isOpen()) srand(wallSeed);
+        updateSimulation(app, dt);  // audio analysis, camera, meteors, comets
+        if (wall.isOpen()) wall.sendState(packWallState(app, wallFrame, dt, wallSeed, meteorTime, cometTime));
         render(app);     // includes renderScene + renderMeteors + renderComets + gravity ripple
+        updateHover(app);
         renderUI(app);   // also calls renderLabels inside ImGui frame
+        if (wall.isOpen()) {
+            glFinish();
+            wall.awaitReady(wallFrame);
+            wall.sendSwap(wallFrame);
+        }
         SDL_GL_SwapWindow(app.window);
+
+        if (startup.recording()) {
+            startup.close(framePhase);
+            framePhase = -1;
+            startup.mark("first frame");
+            // Interactive: a galaxy on screen, or nothing left to load
+            if (!app.artistNodes.empty() || (!app.scanning && !app.libraryLoaded)) {
+                startup.mark("interactive");
+                if (startupReport) {
+                    startupFailed = finishStartupReport(startupBudget) != 0;
+                    if (startupBudget.enabled()) app.running = false;
+                }
+                startup.finish();
+            }
+        }
+
+        if (soak) {
+            auto end = std::chrono::high_resolution_clock::now();
+            soak->frame(std::chrono::duration<double, std::milli>(end - now).count());
+            double wallSeconds = std::chrono::duration<double>(end - soakStart).count();
+            if (wallSeconds >= soakNext) {
+                soak->sample(soakSample(app, wallSeconds));
+                soakNext += soakCfg.interval;
+            }
+            if (wallSeconds >= soakCfg.seconds) {
+                soakFailed = !soak->passed();
+                app.running = false;
+            }
+        }
     }
 
-    app.audio.cleanup();
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplSDL2_Shutdown();
-    ImGui::DestroyContext();
-    SDL_GL_DeleteContext(app.glContext);
-    SDL_DestroyWindow(app.window);
-    SDL_Quit();
-    return 0;
+    shutdown(app);
+    return soakFailed || startupFailed ? 1 : 0;
 }
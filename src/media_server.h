@@ -0,0 +1,298 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include "log.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef MSG_NOSIGNAL
+#define PLANETARY_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define PLANETARY_SEND_FLAGS 0
+#endif
+
+// ============================================================
+// MEDIA SERVER - in-process HTTP server for cast receivers.
+// Serves the current and next tracks with byte-range support under
+// a stable URL per track (/track/<id>.<ext>, id = hash of the path),
+// so receivers can seek, resume and prefetch without us spawning
+// anything per track.
+// ============================================================
+
+inline bool sendAll(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, PLANETARY_SEND_FLAGS);
+        if (n <= 0) return false;
+        data += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+inline std::string mediaMimeType(const std::string& path) {
+    std::string ext = path.substr(path.find_last_of('.') + 1);
+    for (char& c : ext) c = (char)tolower((unsigned char)c);
+    if (ext == "mp3") return "audio/mpeg";
+    if (ext == "flac") return "audio/flac";
+    if (ext == "wav") return "audio/wav";
+    if (ext == "ogg" || ext == "opus") return "audio/ogg";
+    if (ext == "m4a" || ext == "aac") return "audio/mp4";
+    return "application/octet-stream";
+}
+
+// Address other machines on the LAN can reach us at. A connected UDP
+// socket sends nothing but makes the kernel pick the outgoing interface.
+inline std::string lanAddress() {
+    const char* env = std::getenv("PLANETARY_CAST_HOST");
+    if (env && *env) return env;
+    std::string ip = "127.0.0.1";
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return ip;
+    sockaddr_in dst{};
+    dst.sin_family = AF_INET;
+    dst.sin_port = htons(1900);
+    inet_pton(AF_INET, "239.255.255.250", &dst.sin_addr);
+    sockaddr_in local{};
+    socklen_t len = sizeof(local);
+    if (connect(fd, (sockaddr*)&dst, sizeof(dst)) == 0 &&
+        getsockname(fd, (sockaddr*)&local, &len) == 0 && local.sin_addr.s_addr != 0) {
+        char buf[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &local.sin_addr, buf, sizeof(buf));
+        ip = buf;
+    }
+    close(fd);
+    return ip;
+}
+
+class MediaServer {
+public:
+    ~MediaServer() { stop(); }
+
+    // port 0 = any free port
+    bool start(int port = 0, const std::string& bindHost = "0.0.0.0") {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        if (listenFd < 0) return false;
+        int one = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)port);
+        inet_pton(AF_INET, bindHost.c_str(), &addr.sin_addr);
+        socklen_t len = sizeof(addr);
+        if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd, 16) != 0 ||
+            getsockname(listenFd, (sockaddr*)&addr, &len) != 0) {
+            LOG_ERROR("Cast") << "Media server failed to bind port " << port;
+            close(listenFd);
+            listenFd = -1;
+            return false;
+        }
+        boundPort = ntohs(addr.sin_port);
+        host = bindHost == "0.0.0.0" ? lanAddress() : bindHost;
+        running = true;
+        acceptThread = std::thread([this] { acceptLoop(); });
+        LOG_INFO("Cast") << "Media server on http://" << host << ":" << boundPort << "/";
+        return true;
+    }
+
+    void stop() {
+        if (!running.exchange(false)) return;
+        shutdown(listenFd, SHUT_RDWR);
+        close(listenFd);
+        acceptThread.join();
+        // Connections time out on their own (SO_SNDTIMEO/SO_RCVTIMEO)
+        std::unique_lock<std::mutex> lock(activeMutex);
+        idle.wait(lock, [this] { return active == 0; });
+    }
+
+    int port() const { return boundPort; }
+
+    // Stable per-track ID: FNV-1a of the file path
+    static std::string trackId(const std::string& path) {
+        uint64_t h = 1469598103934665603ull;
+        for (unsigned char c : path) { h ^= c; h *= 1099511628211ull; }
+        char buf[17];
+        snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)h);
+        return buf;
+    }
+
+    std::string urlFor(const std::string& path) const {
+        std::string ext = path.substr(path.find_last_of('.') + 1);
+        return "http://" + host + ":" + std::to_string(boundPort) + "/track/" + trackId(path) + "." + ext;
+    }
+
+    // Only these tracks are reachable; everything else is 404. The
+    // previous current track stays valid so in-flight reads can drain.
+    void serve(const std::string& current, const std::string& next) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::map<std::string, std::string> keep;
+        if (!current.empty()) keep[trackId(current)] = current;
+        if (!next.empty()) keep[trackId(next)] = next;
+        if (!servingCurrent.empty() && servingCurrent != current) keep[trackId(servingCurrent)] = servingCurrent;
+        servingCurrent = current;
+        tracks.swap(keep);
+    }
+
+    // Fixed URL paths ("/galaxy.snap" -> file) served alongside the
+    // cast tracks, for planetary-indexer; replaces the previous table
+    void publishFiles(std::map<std::string, std::string> table) {
+        std::lock_guard<std::mutex> lock(mutex);
+        files.swap(table);
+    }
+
+    std::atomic<uint64_t> bytesServed{0};
+    std::atomic<uint64_t> requests{0};
+
+private:
+    int listenFd = -1;
+    int boundPort = 0;
+    std::string host;
+    std::atomic<bool> running{false};
+    std::mutex activeMutex;
+    std::condition_variable idle;   // signalled as each handler finishes
+    int active = 0;
+    std::thread acceptThread;
+    std::mutex mutex;
+    std::map<std::string, std::string> tracks;  // id -> path
+    std::map<std::string, std::string> files;   // URL path -> path
+    std::string servingCurrent;
+
+    void acceptLoop() {
+        while (running) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                if (!running) break;
+                continue;
+            }
+            timeval tv{10, 0};
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+            setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+#ifdef SO_NOSIGPIPE
+            int one = 1;
+            setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+            {
+                std::lock_guard<std::mutex> lock(activeMutex);
+                active++;
+            }
+            std::thread([this, fd] {
+                handle(fd);
+                close(fd);
+                // Notify under the lock: stop() may destroy us once it sees 0
+                std::lock_guard<std::mutex> lock(activeMutex);
+                active--;
+                idle.notify_all();
+            }).detach();
+        }
+    }
+
+    void respond(int fd, const char* status, const std::string& extra = "") {
+        std::string r = std::string("HTTP/1.1 ") + status + "\r\nContent-Length: 0\r\nConnection: close\r\n" + extra + "\r\n";
+        sendAll(fd, r.data(), r.size());
+    }
+
+    void handle(int fd) {
+        // Read the request head
+        std::string req;
+        char buf[2048];
+        while (req.find("\r\n\r\n") == std::string::npos && req.size() < 16384) {
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) return;
+            req.append(buf, (size_t)n);
+        }
+        requests++;
+        size_t sp1 = req.find(' '), sp2 = req.find(' ', sp1 + 1);
+        if (sp1 == std::string::npos || sp2 == std::string::npos) return respond(fd, "400 Bad Request");
+        std::string method = req.substr(0, sp1);
+        std::string target = req.substr(sp1 + 1, sp2 - sp1 - 1);
+        if (method != "GET" && method != "HEAD") return respond(fd, "405 Method Not Allowed", "Allow: GET, HEAD\r\n");
+
+        // Published files, then /track/<id>.<ext>
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto f = files.find(target.substr(0, target.find('?')));
+            if (f != files.end()) path = f->second;
+        }
+        if (path.empty() && target.rfind("/track/", 0) == 0) {
+            std::string id = target.substr(7, target.find('.', 7) - 7);
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = tracks.find(id);
+            if (it != tracks.end()) path = it->second;
+        }
+        if (path.empty()) return respond(fd, "404 Not Found");
+
+        int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat st;
+        if (file < 0 || fstat(file, &st) != 0) {
+            if (file >= 0) close(file);
+            return respond(fd, "404 Not Found");
+        }
+        int64_t size = (int64_t)st.st_size;
+
+        // Range: bytes=a-b | a- | -n (single range only)
+        int64_t first = 0, last = size - 1;
+        bool partial = false;
+        std::string lower = req;
+        for (char& c : lower) c = (char)tolower((unsigned char)c);
+        size_t rp = lower.find("\r\nrange: bytes=");
+        if (rp != std::string::npos) {
+            const char* r = req.c_str() + rp + 15;
+            char* end;
+            if (*r == '-') {
+                int64_t n = strtoll(r + 1, &end, 10);
+                first = std::max<int64_t>(0, size - n);
+            } else {
+                first = strtoll(r, &end, 10);
+                if (*end == '-' && isdigit((unsigned char)end[1])) last = std::min(last, (int64_t)strtoll(end + 1, &end, 10));
+            }
+            partial = true;
+            if (first >= size || first > last) {
+                close(file);
+                return respond(fd, "416 Range Not Satisfiable", "Content-Range: bytes */" + std::to_string(size) + "\r\n");
+            }
+        }
+
+        std::string head = std::string("HTTP/1.1 ") + (partial ? "206 Partial Content" : "200 OK") + "\r\n" +
+            "Content-Type: " + mediaMimeType(path) + "\r\n" +
+            "Content-Length: " + std::to_string(last - first + 1) + "\r\n" +
+            "Accept-Ranges: bytes\r\n" +
+            // DLNA renderers only offer seeking when byte seek is advertised
+            "transferMode.dlna.org: Streaming\r\n" +
+            "contentFeatures.dlna.org: DLNA.ORG_OP=01;DLNA.ORG_CI=0;DLNA.ORG_FLAGS=01700000000000000000000000000000\r\n" +
+            "Connection: close\r\n";
+        if (partial)
+            head += "Content-Range: bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" + std::to_string(size) + "\r\n";
+        head += "\r\n";
+
+        if (sendAll(fd, head.data(), head.size()) && method == "GET") {
+            std::vector<char> chunk(64 * 1024);
+            for (int64_t pos = first; pos <= last && running; ) {
+                size_t want = (size_t)std::min<int64_t>((int64_t)chunk.size(), last - pos + 1);
+                ssize_t n = pread(file, chunk.data(), want, pos);
+                if (n <= 0 || !sendAll(fd, chunk.data(), (size_t)n)) break;
+                pos += n;
+                bytesServed += (uint64_t)n;
+            }
+        }
+        close(file);
+    }
+};
+
+#endif // !_WIN32
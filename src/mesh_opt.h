@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+// ============================================================
+// MESH OPTIMIZATION - compact vertex packing + cache ordering
+// Static meshes are built once at startup, so everything here
+// favours simple, predictable code over build speed.
+// ============================================================
+
+inline int16_t packSnorm16(float v) {
+    v = std::max(-1.0f, std::min(1.0f, v));
+    return (int16_t)std::lround(v * 32767.0f);
+}
+
+inline uint16_t packUnorm16(float v) {
+    v = std::max(0.0f, std::min(1.0f, v));
+    return (uint16_t)std::lround(v * 65535.0f);
+}
+
+inline uint8_t packUnorm8(float v) {
+    v = std::max(0.0f, std::min(1.0f, v));
+    return (uint8_t)std::lround(v * 255.0f);
+}
+
+// Unit-sphere vertex: snorm16 position (also used as the normal) +
+// unorm16 UV = 12 bytes, down from 32 for pos/normal/uv floats
+struct PackedSphereVertex {
+    int16_t pos[4];     // xyz + pad (keeps the UV 4-byte aligned)
+    uint16_t uv[2];
+};
+
+// Forsyth's linear-speed vertex cache optimisation
+// (https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html)
+// Reorders triangles so recently transformed vertices are reused.
+inline void optimizeVertexCache(std::vector<uint16_t>& indices, int vertexCount) {
+    const int CACHE = 32;
+    const int triCount = (int)indices.size() / 3;
+    if (triCount == 0) return;
+
+    auto score = [](int cachePos, int remaining) -> float {
+        if (remaining == 0) return -1.0f;
+        float s = 0.0f;
+        if (cachePos >= 0) {
+            if (cachePos < 3) s = 0.75f;  // the last triangle's verts: no bonus for re-using immediately
+            else s = powf(1.0f - (float)(cachePos - 3) / (CACHE - 3), 1.5f);
+        }
+        return s + 2.0f * powf((float)remaining, -0.5f);
+    };
+
+    // Vertex -> triangle adjacency
+    std::vector<int> remaining(vertexCount, 0), offset(vertexCount + 1, 0);
+    for (uint16_t i : indices) remaining[i]++;
+    for (int v = 0; v < vertexCount; v++) offset[v + 1] = offset[v] + remaining[v];
+    std::vector<int> adj(indices.size()), fill(offset.begin(), offset.end() - 1);
+    for (int t = 0; t < triCount; t++)
+        for (int k = 0; k < 3; k++) adj[fill[indices[t * 3 + k]]++] = t;
+
+    std::vector<int> cachePos(vertexCount, -1);
+    std::vector<float> vScore(vertexCount), tScore(triCount, 0.0f);
+    std::vector<bool> emitted(triCount, false);
+    for (int v = 0; v < vertexCount; v++) vScore[v] = score(-1, remaining[v]);
+    for (int t = 0; t < triCount; t++)
+        for (int k = 0; k < 3; k++) tScore[t] += vScore[indices[t * 3 + k]];
+
+    std::vector<int> cache;
+    std::vector<uint16_t> out;
+    out.reserve(indices.size());
+    int best = (int)(std::max_element(tScore.begin(), tScore.end()) - tScore.begin());
+    int scanFrom = 0;
+
+    while (best >= 0) {
+        emitted[best] = true;
+        std::vector<int> next;
+        for (int k = 0; k < 3; k++) {
+            int v = indices[best * 3 + k];
+            out.push_back((uint16_t)v);
+            next.push_back(v);
+            // Drop the triangle from this vertex's live list
+            int* b = &adj[offset[v]];
+            int* e = b + remaining[v];
+            std::swap(*std::find(b, e, best), *(e - 1));
+            remaining[v]--;
+        }
+        for (int v : cache)
+            if (std::find(next.begin(), next.end(), v) == next.end()) next.push_back(v);
+        for (size_t i = CACHE; i < next.size(); i++) {
+            // Evicted: back to the uncached score
+            int v = next[i];
+            cachePos[v] = -1;
+            float ns = score(-1, remaining[v]);
+            for (int j = 0; j < remaining[v]; j++) tScore[adj[offset[v] + j]] += ns - vScore[v];
+            vScore[v] = ns;
+        }
+        if (next.size() > (size_t)CACHE) next.resize(CACHE);
+        cache.swap(next);
+
+        // Rescore cached vertices and their triangles, pick the best one among them
+        best = -1;
+        float bestScore = -1.0f;
+        for (int i = 0; i < (int)cache.size(); i++) {
+            int v = cache[i];
+            cachePos[v] = i;
+            float ns = score(i, remaining[v]);
+            float delta = ns - vScore[v];
+            vScore[v] = ns;
+            for (int j = 0; j < remaining[v]; j++) {
+                int t = adj[offset[v] + j];
+                tScore[t] += delta;
+            }
+        }
+        for (int v : cache)
+            for (int j = 0; j < remaining[v]; j++) {
+                int t = adj[offset[v] + j];
+                if (tScore[t] > bestScore) { bestScore = tScore[t]; best = t; }
+            }
+        // Cache ran dry: fall back to the next unemitted triangle
+        if (best < 0) {
+            while (scanFrom < triCount && emitted[scanFrom]) scanFrom++;
+            if (scanFrom < triCount) best = scanFrom;
+        }
+    }
+    indices.swap(out);
+}
+
+// Reorder vertices into first-use order so fetches stream linearly
+template <typename V>
+void optimizeVertexFetch(std::vector<V>& verts, std::vector<uint16_t>& indices) {
+    std::vector<int> remap(verts.size(), -1);
+    std::vector<V> out;
+    out.reserve(verts.size());
+    for (uint16_t& i : indices) {
+        if (remap[i] < 0) {
+            remap[i] = (int)out.size();
+            out.push_back(verts[i]);
+        }
+        i = (uint16_t)remap[i];
+    }
+    verts.swap(out);
+}
+
+// Average cache miss ratio for a FIFO cache -- 0.5 is ideal, 3.0 is worst
+inline float vertexCacheACMR(const std::vector<uint16_t>& indices, int cacheSize = 16) {
+    std::vector<uint16_t> fifo;
+    int misses = 0;
+    for (uint16_t i : indices) {
+        if (std::find(fifo.begin(), fifo.end(), i) != fifo.end()) continue;
+        misses++;
+        fifo.push_back(i);
+        if ((int)fifo.size() > cacheSize) fifo.erase(fifo.begin());
+    }
+    return indices.empty() ? 0.0f : (float)misses / (float)(indices.size() / 3);
+}
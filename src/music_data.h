@@ -6,7 +6,10 @@
 #include <algorithm>
 #include <functional>
 #include <cmath>
-#include <iostream>
+#include <cstdint>
+#include "log.h"
+#include "palette.h"
+#include "collation.h"
 
 #ifndef __ANDROID__
 #include <filesystem>
@@ -17,6 +20,7 @@
 #include <taglib/id3v2tag.h>
 #include <taglib/attachedpictureframe.h>
 #include <taglib/flacfile.h>
+#include "cover_decode.h"
 namespace fs = std::filesystem;
 #endif
 
@@ -35,6 +39,8 @@ struct TrackData {
     float duration = 0;  // seconds
     int year = 0;
     std::string genre;
+    float bpm = 0;          // from planetary-indexer's analysis; 0 = unknown
+    float loudness = 0;     // RMS, dBFS; 0 = unknown
 };
 
 struct AlbumData {
@@ -43,16 +49,23 @@ struct AlbumData {
     std::string id;         // Navidrome album ID (for cover art URL)
     int year = 0;
     std::vector<TrackData> tracks;
-    // Cover art (raw image data for GL texture creation)
+    // Cover art for GL texture creation: RGBA (coverArtW x coverArtH,
+    // see decodeCover) once scanned; encoded bytes only in the indexer
+    // while it fetches Subsonic covers
     std::vector<unsigned char> coverArtData;
     int coverArtW = 0, coverArtH = 0;
+    ColorPalette palette;   // from the cover; empty when there is no art
+    uint64_t artHash = 0;   // snapshot libraries: entry in the art pack
 };
 
 struct ArtistData {
     std::string name;
+    std::string sortKey;      // collationKey(name), built once when sorting
     std::string primaryGenre; // Most common genre across tracks
     std::vector<AlbumData> albums;
     int totalTracks = 0;
+    bool hasLayout = false;   // star position pinned by a galaxy snapshot
+    float layoutPos[3] = {0, 0, 0};
 };
 
 struct MusicLibrary {
@@ -61,6 +74,106 @@ struct MusicLibrary {
     int totalAlbums = 0;
 };
 
+// Artists in collation order ("The Beatles" under B, "Björk" next to
+// "Bjorn"); keys are computed only for artists that don't have one yet
+inline void sortArtists(std::vector<ArtistData>& artists) {
+    for (auto& a : artists)
+        if (a.sortKey.empty()) a.sortKey = collationKey(a.name);
+    sortByKey(artists, [](const ArtistData& a) -> const std::string& { return a.sortKey; });
+}
+
+// ============================================================
+// SYNTHETIC LIBRARY - deterministic stand-in for benchmarks / CI
+// ============================================================
+// megaAlbums > 0 turns artist 0 into a compilation-style "Various Artists"
+// with that many albums, the first one a long box set
+inline MusicLibrary makeSyntheticLibrary(int numArtists, int albumsPerArtist, int tracksPerAlbum,
+                                         int megaAlbums = 0) {
+    static const char* genres[] = { "Rock", "Electronic", "Jazz", "Hip-Hop", "Classical", "Pop", "Metal", "Folk" };
+    MusicLibrary lib;
+    for (int a = 0; a < numArtists; a++) {
+        ArtistData artist;
+        artist.name = "Artist " + std::to_string(a);
+        artist.primaryGenre = genres[a % 8];
+        // Vary album count so orbit layouts differ between stars
+        int albums = std::max(1, albumsPerArtist - (a % 3));
+        if (a == 0 && megaAlbums > 0) {
+            artist.name = "Various Artists";
+            albums = megaAlbums;
+        }
+        for (int b = 0; b < albums; b++) {
+            AlbumData album;
+            album.name = "Album " + std::to_string(a) + "-" + std::to_string(b);
+            album.artist = artist.name;
+            album.year = 1970 + (a * 7 + b) % 50;
+            int tracks = (a == 0 && megaAlbums > 0 && b == 0) ? tracksPerAlbum * 10 : tracksPerAlbum;
+            for (int t = 0; t < tracks; t++) {
+                TrackData track;
+                track.title = "Track " + std::to_string(t + 1);
+                track.artist = artist.name;
+                track.album = album.name;
+                track.albumArtist = artist.name;
+                track.trackNumber = t + 1;
+                track.duration = 120.0f + (float)((a + b + t) % 240);
+                track.year = album.year;
+                track.genre = artist.primaryGenre;
+                album.tracks.push_back(track);
+            }
+            artist.totalTracks += (int)album.tracks.size();
+            artist.albums.push_back(std::move(album));
+        }
+        lib.totalTracks += artist.totalTracks;
+        lib.totalAlbums += (int)artist.albums.size();
+        lib.artists.push_back(std::move(artist));
+    }
+    return lib;
+}
+
+// ============================================================
+// MERGE - fold one root's library into another (artists and albums
+// matched by name), keeping the scanner's sort order
+// ============================================================
+inline void mergeLibrary(MusicLibrary& into, MusicLibrary&& from) {
+    std::map<std::string, size_t> artistIdx;
+    for (size_t i = 0; i < into.artists.size(); i++) artistIdx[into.artists[i].name] = i;
+
+    for (auto& artist : from.artists) {
+        auto it = artistIdx.find(artist.name);
+        if (it == artistIdx.end()) {
+            artistIdx[artist.name] = into.artists.size();
+            into.totalAlbums += (int)artist.albums.size();
+            into.totalTracks += artist.totalTracks;
+            into.artists.push_back(std::move(artist));
+            continue;
+        }
+        ArtistData& dst = into.artists[it->second];
+        for (auto& album : artist.albums) {
+            auto same = std::find_if(dst.albums.begin(), dst.albums.end(),
+                [&](const AlbumData& a) { return a.name == album.name; });
+            if (same == dst.albums.end()) {
+                into.totalAlbums++;
+                dst.albums.push_back(std::move(album));
+                continue;
+            }
+            // Same album split across roots: append tracks, keep existing art
+            for (auto& t : album.tracks) same->tracks.push_back(std::move(t));
+            std::sort(same->tracks.begin(), same->tracks.end(),
+                [](const TrackData& a, const TrackData& b) { return a.trackNumber < b.trackNumber; });
+            if (same->coverArtData.empty() && same->palette.count == 0) {
+                same->coverArtData = std::move(album.coverArtData);
+                same->coverArtW = album.coverArtW;
+                same->coverArtH = album.coverArtH;
+                same->palette = album.palette;
+            }
+        }
+        dst.totalTracks += artist.totalTracks;
+        into.totalTracks += artist.totalTracks;
+        std::sort(dst.albums.begin(), dst.albums.end(),
+            [](const AlbumData& a, const AlbumData& b) { return a.year < b.year; });
+    }
+    sortArtists(into.artists);
+}
+
 // ============================================================
 // SCANNER - Port of the Electron version's music:scan IPC
 // (Desktop only — Android uses Navidrome HTTP API)
@@ -91,7 +204,7 @@ inline std::vector<std::string> scanDirectory(const std::string& dirPath) {
             }
         }
     } catch (const std::exception& e) {
-        std::cerr << "[Planetary] Scan error: " << e.what() << std::endl;
+        LOG_ERROR("Planetary") << "Scan error: " << e.what();
     }
     return files;
 }
@@ -126,60 +239,52 @@ inline std::vector<unsigned char> extractCoverArt(const std::string& path) {
     return {};
 }
 
-inline MusicLibrary scanMusicLibrary(const std::string& dirPath,
-    std::function<void(int, int)> progressCallback = nullptr)
-{
-    std::cout << "[Planetary] Scanning: " << dirPath << std::endl;
-    auto files = scanDirectory(dirPath);
-    std::cout << "[Planetary] Found " << files.size() << " audio files" << std::endl;
-
-    // Parse metadata with TagLib
-    std::map<std::string, std::map<std::string, AlbumData>> artistAlbums;
-    int scanned = 0;
-
-    for (auto& filePath : files) {
-        TrackData track;
-        track.filePath = filePath;
-
-        TagLib::FileRef f(filePath.c_str());
-        if (!f.isNull() && f.tag()) {
-            auto* tag = f.tag();
-            track.title = tag->title().toCString(true);
-            track.artist = tag->artist().toCString(true);
-            track.album = tag->album().toCString(true);
-            track.trackNumber = tag->track();
-            track.year = tag->year();
-            track.genre = tag->genre().toCString(true);
-
-            if (f.audioProperties()) {
-                track.duration = f.audioProperties()->lengthInSeconds();
-            }
-        }
-
-        // Fallbacks (same as Electron version)
-        if (track.title.empty()) {
-            track.title = fs::path(filePath).stem().string();
+// Tags for one file, with the Electron version's fallbacks
+inline TrackData readTrackTags(const std::string& filePath) {
+    TrackData track;
+    track.filePath = filePath;
+
+    TagLib::FileRef f(filePath.c_str());
+    if (!f.isNull() && f.tag()) {
+        auto* tag = f.tag();
+        track.title = tag->title().toCString(true);
+        track.artist = tag->artist().toCString(true);
+        track.album = tag->album().toCString(true);
+        track.trackNumber = tag->track();
+        track.year = tag->year();
+        track.genre = tag->genre().toCString(true);
+
+        if (f.audioProperties()) {
+            track.duration = f.audioProperties()->lengthInSeconds();
         }
-        if (track.artist.empty()) {
-            track.artist = fs::path(filePath).parent_path().filename().string();
-        }
-        if (track.album.empty()) {
-            track.album = fs::path(filePath).parent_path().filename().string();
-        }
-        if (track.duration <= 0) track.duration = 180.0f;
+    }
 
-        track.albumArtist = track.artist;
+    // Fallbacks (same as Electron version)
+    if (track.title.empty()) {
+        track.title = fs::path(filePath).stem().string();
+    }
+    if (track.artist.empty()) {
+        track.artist = fs::path(filePath).parent_path().filename().string();
+    }
+    if (track.album.empty()) {
+        track.album = fs::path(filePath).parent_path().filename().string();
+    }
+    if (track.duration <= 0) track.duration = 180.0f;
 
-        // Group by artist → album
-        artistAlbums[track.albumArtist][track.album].name = track.album;
-        artistAlbums[track.albumArtist][track.album].artist = track.albumArtist;
-        artistAlbums[track.albumArtist][track.album].year = track.year;
-        artistAlbums[track.albumArtist][track.album].tracks.push_back(track);
+    track.albumArtist = track.artist;
+    return track;
+}
 
-        scanned++;
-        if (progressCallback && scanned % 50 == 0) {
-            progressCallback(scanned, (int)files.size());
-        }
+// Group tracks into artists/albums, pick genres, pull cover art, sort
+inline MusicLibrary buildLibrary(std::vector<TrackData>&& tracks) {
+    // Group by artist → album
+    std::map<std::string, std::map<std::string, AlbumData>> artistAlbums;
+    for (auto& track : tracks) {
+        auto& album = artistAlbums[track.albumArtist][track.album];
+        album.name = track.album;
+        album.artist = track.albumArtist;
+        album.year = track.year;
+        album.tracks.push_back(std::move(track));
     }
 
     // Build the library structure
@@ -193,8 +298,8 @@ inline MusicLibrary scanMusicLibrary(const std::string& dirPath,
                 [](const TrackData& a, const TrackData& b) {
                     return a.trackNumber < b.trackNumber;
                 });
-            artist.albums.push_back(albumData);
-            artist.totalTracks += (int)albumData.tracks.size();
+            artist.albums.push_back(std::move(albumData));
+            artist.totalTracks += (int)artist.albums.back().tracks.size();
             lib.totalAlbums++;
         }
         // Determine primary genre from most common genre across tracks
@@ -209,11 +314,13 @@ inline MusicLibrary scanMusicLibrary(const std::string& dirPath,
             artist.primaryGenre = "Unknown";
         }
 
-        // Extract cover art for each album (from first track)
+        // Cover art for each album (from first track), decoded once at
+        // texture size while we're off the main thread
         for (auto& album : artist.albums) {
-            if (album.coverArtData.empty() && !album.tracks.empty()) {
-                album.coverArtData = extractCoverArt(album.tracks[0].filePath);
-            }
+            if (!album.coverArtData.empty() || album.tracks.empty()) continue;
+            std::vector<unsigned char> encoded = extractCoverArt(album.tracks[0].filePath);
+            album.coverArtData = decodeCover(encoded.data(), encoded.size(), album.coverArtW, album.coverArtH);
+            album.palette = extractPalette(album.coverArtData.data(), album.coverArtW, album.coverArtH);
         }
 
         // Sort albums by year
@@ -221,18 +328,36 @@ inline MusicLibrary scanMusicLibrary(const std::string& dirPath,
             [](const AlbumData& a, const AlbumData& b) {
                 return a.year < b.year;
             });
-        lib.artists.push_back(artist);
-        lib.totalTracks += artist.totalTracks;
+        lib.artists.push_back(std::move(artist));
+        lib.totalTracks += lib.artists.back().totalTracks;
     }
 
-    // Sort artists by name
-    std::sort(lib.artists.begin(), lib.artists.end(),
-        [](const ArtistData& a, const ArtistData& b) {
-            return a.name < b.name;
-        });
+    sortArtists(lib.artists);
+    return lib;
+}
+
+inline MusicLibrary scanMusicLibrary(const std::string& dirPath,
+    std::function<void(int, int)> progressCallback = nullptr)
+{
+    LOG_INFO("Planetary") << "Scanning: " << dirPath;
+    auto files = scanDirectory(dirPath);
+    LOG_INFO("Planetary") << "Found " << files.size() << " audio files";
+
+    // Parse metadata with TagLib
+    std::vector<TrackData> tracks;
+    tracks.reserve(files.size());
+    int scanned = 0;
+    for (auto& filePath : files) {
+        tracks.push_back(readTrackTags(filePath));
+        scanned++;
+        if (progressCallback && scanned % 50 == 0) {
+            progressCallback(scanned, (int)files.size());
+        }
+    }
 
-    std::cout << "[Planetary] Library: " << lib.artists.size() << " artists, "
-              << lib.totalAlbums << " albums, " << lib.totalTracks << " tracks" << std::endl;
+    MusicLibrary lib = buildLibrary(std::move(tracks));
+    LOG_INFO("Planetary") << "Library: " << lib.artists.size() << " artists, "
+                          << lib.totalAlbums << " albums, " << lib.totalTracks << " tracks";
     return lib;
 }
 
@@ -248,9 +373,6 @@ inline MusicLibrary scanMusicLibrary(const std::string& dirPath,
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <unistd.h>
-#include <android/log.h>
-
-#define PLANETARY_LOG(...) __android_log_print(ANDROID_LOG_DEBUG, "Planetary", __VA_ARGS__)
 
 // Simple HTTP GET (blocking, no SSL)
 static std::string planetaryHttpGet(const std::string& url, int timeoutSec = 10) {
@@ -275,7 +397,7 @@ static std::string planetaryHttpGet(const std::string& url, int timeoutSec = 10)
     hints.ai_socktype = SOCK_STREAM;
     std::string portStr = std::to_string(port);
     if (getaddrinfo(host.c_str(), portStr.c_str(), &hints, &res) != 0) {
-        PLANETARY_LOG("[HTTP] Failed to resolve host: %s", host.c_str());
+        logPrintf(LogLevel::Error, "HTTP", "Failed to resolve host: %s", host.c_str());
         return "";
     }
 
@@ -289,7 +411,7 @@ static std::string planetaryHttpGet(const std::string& url, int timeoutSec = 10)
     setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
 
     if (connect(sock, res->ai_addr, res->ai_addrlen) < 0) {
-        PLANETARY_LOG("[HTTP] Failed to connect to %s:%d", host.c_str(), port);
+        logPrintf(LogLevel::Error, "HTTP", "Failed to connect to %s:%d", host.c_str(), port);
         close(sock);
         freeaddrinfo(res);
         return "";
@@ -398,11 +520,11 @@ inline MusicLibrary fetchMusicLibraryFromNavidrome(
     std::function<void(int,int)> progressCallback = nullptr
 ) {
     MusicLibrary lib;
-    PLANETARY_LOG("[Planetary] Connecting to Navidrome at %s", NAVI_BASE);
+    logPrintf(LogLevel::Info, "Planetary", "Connecting to Navidrome at %s", NAVI_BASE);
 
     std::string artistsJson = planetaryHttpGet(naviUrl("getArtists"));
     if (artistsJson.empty()) {
-        PLANETARY_LOG("[Planetary] Failed to reach Navidrome, using demo library");
+        logPrintf(LogLevel::Warn, "Planetary", "Failed to reach Navidrome, using demo library");
         ArtistData demo;
         demo.name = "Navidrome Offline";
         demo.primaryGenre = "Electronic";
@@ -433,7 +555,7 @@ inline MusicLibrary fetchMusicLibraryFromNavidrome(
         pos = found + 10;
     }
 
-    PLANETARY_LOG("[Planetary] Found %zu artists", artistEntries.size());
+    logPrintf(LogLevel::Info, "Planetary", "Found %zu artists", artistEntries.size());
     int totalArtists = (int)artistEntries.size();
     int processed = 0;
 
@@ -500,10 +622,9 @@ inline MusicLibrary fetchMusicLibraryFromNavidrome(
         if (progressCallback) progressCallback(processed, totalArtists);
     }
 
-    std::sort(lib.artists.begin(), lib.artists.end(),
-        [](const ArtistData& a, const ArtistData& b) { return a.name < b.name; });
+    sortArtists(lib.artists);
 
-    PLANETARY_LOG("[Planetary] Library loaded: %zu artists, %d albums, %d tracks",
+    logPrintf(LogLevel::Info, "Planetary", "Library loaded: %zu artists, %d albums, %d tracks",
         lib.artists.size(), lib.totalAlbums, lib.totalTracks);
     return lib;
 }
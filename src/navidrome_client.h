@@ -9,7 +9,7 @@
 #include <string>
 #include <vector>
 #include <functional>
-#include <iostream>
+#include "log.h"
 #include <sstream>
 #include <algorithm>
 #include <cstring>
@@ -54,7 +54,7 @@ inline std::string httpGet(const std::string& url) {
     curl_easy_cleanup(curl);
 
     if (res != CURLE_OK) {
-        std::cerr << "[Navidrome] HTTP error: " << curl_easy_strerror(res) << " url=" << url << std::endl;
+        LOG_ERROR("Navidrome") << "HTTP error: " << curl_easy_strerror(res) << " url=" << url;
         return "";
     }
     return result;
@@ -148,21 +148,21 @@ inline MusicLibrary fetchMusicLibraryFromNavidrome(
     MusicLibrary lib;
     curl_global_init(CURL_GLOBAL_DEFAULT);
 
-    std::cout << "[Navidrome] Connecting to: " << serverUrl << std::endl;
+    LOG_INFO("Navidrome") << "Connecting to: " << serverUrl;
 
     // Step 1: Get all artists
     std::string artistsUrl = buildUrl(serverUrl, "getArtists.view");
     std::string artistsXml = httpGet(artistsUrl);
 
     if (artistsXml.empty()) {
-        std::cerr << "[Navidrome] Failed to fetch artists. Is the server running?" << std::endl;
+        LOG_ERROR("Navidrome") << "Failed to fetch artists. Is the server running?";
         curl_global_cleanup();
         return lib;
     }
 
     // Parse artists
     auto artistTags = xmlFindTags(artistsXml, "artist");
-    std::cout << "[Navidrome] Found " << artistTags.size() << " artists" << std::endl;
+    LOG_INFO("Navidrome") << "Found " << artistTags.size() << " artists";
 
     int totalArtists = (int)artistTags.size();
     int processed = 0;
@@ -190,6 +190,7 @@ inline MusicLibrary fetchMusicLibraryFromNavidrome(
             album.name   = albumName.empty() ? "Unknown Album" : albumName;
             album.artist = artistName;
             album.year   = yearStr.empty() ? 0 : std::stoi(yearStr);
+            album.id     = albumId;
 
             // Step 3: Get tracks for this album
             std::string tracksUrl = buildUrl(serverUrl, "getAlbum.view", "id=" + albumId);
@@ -213,6 +214,7 @@ inline MusicLibrary fetchMusicLibraryFromNavidrome(
                 // The filePath for streaming: use the Subsonic stream URL
                 std::string songId = xmlAttr(songTag, "id");
                 if (songId.empty()) continue;
+                track.id = songId;
                 track.filePath = buildUrl(serverUrl, "stream.view", "id=" + songId + "&format=raw&estimateContentLength=true");
 
                 if (track.title.empty()) track.title = "Track " + trackNumStr;
@@ -260,12 +262,10 @@ inline MusicLibrary fetchMusicLibraryFromNavidrome(
         if (progressCallback) progressCallback(processed, totalArtists);
     }
 
-    // Sort artists by name
-    std::sort(lib.artists.begin(), lib.artists.end(),
-        [](const ArtistData& a, const ArtistData& b){ return a.name < b.name; });
+    sortArtists(lib.artists);
 
-    std::cout << "[Navidrome] Library: " << lib.artists.size() << " artists, "
-              << lib.totalAlbums << " albums, " << lib.totalTracks << " tracks" << std::endl;
+    LOG_INFO("Navidrome") << "Library: " << lib.artists.size() << " artists, "
+                          << lib.totalAlbums << " albums, " << lib.totalTracks << " tracks";
 
     curl_global_cleanup();
     return lib;
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+// ============================================================
+// PALETTE - dominant colours of a cover, computed once when the art
+// is read. Pixels are sampled on a grid of at most 64x64, binned into
+// a 4-bit-per-channel histogram and the occupied bins are clustered
+// with a few k-means rounds.
+// ============================================================
+
+struct ColorPalette {
+    static constexpr int MAX = 4;
+    uint8_t rgb[MAX][3] = {};
+    float weight[MAX] = {};     // share of the cover, high to low
+    int count = 0;
+
+    // Colour that best represents the cover: common, but not washed out
+    int dominant() const {
+        int best = 0;
+        float bestScore = -1;
+        for (int i = 0; i < count; i++) {
+            float s = weight[i] * (0.25f + saturation(i));
+            if (s > bestScore) { bestScore = s; best = i; }
+        }
+        return best;
+    }
+
+    // Most saturated colour covering a meaningful part of the cover
+    int accent() const {
+        int best = dominant();
+        for (int i = 0; i < count; i++)
+            if (weight[i] >= 0.05f && saturation(i) > saturation(best)) best = i;
+        return best;
+    }
+
+    float saturation(int i) const {
+        int mx = std::max({rgb[i][0], rgb[i][1], rgb[i][2]});
+        int mn = std::min({rgb[i][0], rgb[i][1], rgb[i][2]});
+        return mx == 0 ? 0.0f : (float)(mx - mn) / (float)mx;
+    }
+};
+
+inline ColorPalette extractPalette(const uint8_t* rgba, int w, int h) {
+    ColorPalette pal;
+    if (!rgba || w <= 0 || h <= 0) return pal;
+
+    // Histogram over a sampled grid
+    const int GRID = 64;
+    int sw = std::min(w, GRID), sh = std::min(h, GRID);
+    std::vector<uint32_t> cols(sw);
+    for (int x = 0; x < sw; x++) cols[x] = (uint32_t)((x * w / sw) * 4);
+    std::vector<uint32_t> count(4096, 0), sum(4096 * 3, 0);
+    for (int y = 0; y < sh; y++) {
+        const uint8_t* row = rgba + (size_t)(y * h / sh) * w * 4;
+        for (int x = 0; x < sw; x++) {
+            const uint8_t* p = row + cols[x];
+            uint32_t bin = ((uint32_t)(p[0] >> 4) << 8) | ((uint32_t)(p[1] >> 4) << 4) | (uint32_t)(p[2] >> 4);
+            count[bin]++;
+            sum[bin * 3 + 0] += p[0];
+            sum[bin * 3 + 1] += p[1];
+            sum[bin * 3 + 2] += p[2];
+        }
+    }
+
+    // Occupied bins as weighted points
+    struct Point { float r, g, b, n; };
+    std::vector<Point> pts;
+    for (int i = 0; i < 4096; i++) {
+        if (!count[i]) continue;
+        float n = (float)count[i];
+        pts.push_back({sum[i * 3] / n, sum[i * 3 + 1] / n, sum[i * 3 + 2] / n, n});
+    }
+    auto dist2 = [](const Point& a, const float* c) {
+        float dr = a.r - c[0], dg = a.g - c[1], db = a.b - c[2];
+        return dr * dr + dg * dg + db * db;
+    };
+
+    // Deterministic k-means++ seeding: heaviest bin first, then the bin
+    // with the most weight * distance from the chosen centres
+    const int K = ColorPalette::MAX;
+    float centre[K][3];
+    int k = 0;
+    while (k < K && k < (int)pts.size()) {
+        int best = -1;
+        float bestScore = 0;
+        for (int i = 0; i < (int)pts.size(); i++) {
+            float d = 1e9f;
+            for (int j = 0; j < k; j++) d = std::min(d, dist2(pts[i], centre[j]));
+            float s = pts[i].n * (k == 0 ? 1.0f : d);
+            if (s > bestScore) { bestScore = s; best = i; }
+        }
+        if (best < 0) break;
+        centre[k][0] = pts[best].r;
+        centre[k][1] = pts[best].g;
+        centre[k][2] = pts[best].b;
+        k++;
+    }
+
+    float weight[K] = {};
+    for (int iter = 0; iter < 6; iter++) {
+        float acc[K][4] = {};
+        for (auto& p : pts) {
+            int nearest = 0;
+            float nd = dist2(p, centre[0]);
+            for (int j = 1; j < k; j++) {
+                float d = dist2(p, centre[j]);
+                if (d < nd) { nd = d; nearest = j; }
+            }
+            acc[nearest][0] += p.r * p.n;
+            acc[nearest][1] += p.g * p.n;
+            acc[nearest][2] += p.b * p.n;
+            acc[nearest][3] += p.n;
+        }
+        for (int j = 0; j < k; j++) {
+            weight[j] = acc[j][3];
+            if (acc[j][3] > 0)
+                for (int c = 0; c < 3; c++) centre[j][c] = acc[j][c] / acc[j][3];
+        }
+    }
+
+    // Sort by coverage, fold near-duplicates into the bigger one, drop specks
+    int order[K];
+    for (int j = 0; j < k; j++) order[j] = j;
+    std::sort(order, order + k, [&](int a, int b) { return weight[a] > weight[b]; });
+    for (int j = 0; j < k; j++) {
+        for (int i = j + 1; i < k; i++) {
+            int a = order[j], b = order[i];
+            Point pb{centre[b][0], centre[b][1], centre[b][2], 0};
+            if (weight[a] > 0 && weight[b] > 0 && dist2(pb, centre[a]) < 24.0f * 24.0f) {
+                weight[a] += weight[b];
+                weight[b] = 0;
+            }
+        }
+    }
+    std::sort(order, order + k, [&](int a, int b) { return weight[a] > weight[b]; });
+    float total = (float)(sw * sh);
+    for (int j = 0; j < k; j++) {
+        int c = order[j];
+        if (weight[c] / total < 0.02f) continue;
+        for (int ch = 0; ch < 3; ch++) pal.rgb[pal.count][ch] = (uint8_t)std::min(255.0f, centre[c][ch] + 0.5f);
+        pal.weight[pal.count] = weight[c] / total;
+        pal.count++;
+    }
+    return pal;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// ============================================================
+// PICK GRID - screen-space index of what the last frame drew, so hover
+// can be tested on every mouse move. The renderer adds each star,
+// planet, cluster and moon as it draws it; end() buckets the items into
+// 64 px cells, every cell a hit circle touches. A query then reads the
+// one cell under the cursor instead of projecting the whole galaxy, and
+// repeats (same cursor, same frame) are answered from the last result.
+// Planets, clusters and moons win over stars, as in the click tests.
+// ============================================================
+
+enum class PickKind : uint8_t { None, Star, Cluster, Planet, Moon };
+
+struct PickHit {
+    PickKind kind = PickKind::None;
+    int artist = -1, album = -1, track = -1;   // album = cluster index for Cluster
+
+    bool valid() const { return kind != PickKind::None; }
+    bool operator==(const PickHit& o) const {
+        return kind == o.kind && artist == o.artist && album == o.album && track == o.track;
+    }
+    bool operator!=(const PickHit& o) const { return !(*this == o); }
+};
+
+class PickGrid {
+public:
+    static constexpr int CELL = 64;
+    static constexpr int MAX_SPAN = 8;   // wider circles go to the always-tested list
+
+    // Starts collecting the next frame; queries keep using the last one
+    void begin(const glm::mat4& viewProj, int width, int height) {
+        vp = viewProj;
+        w = width;
+        h = height;
+        next.clear();
+    }
+
+    // Hit radius in pixels: max(minPx, perDepth / max(clip.w * 0.1, 0.1)),
+    // the falloff hitTestStar uses; perDepth = 0 for a fixed radius
+    void add(const glm::vec3& pos, float minPx, float perDepth, PickKind kind, int artist, int album = -1, int track = -1) {
+        glm::vec4 clip = vp * glm::vec4(pos, 1.0f);
+        if (clip.w <= 0.01f) return;
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        float r = std::max(minPx, perDepth / std::max(clip.w * 0.1f, 0.1f));
+        float x = (ndc.x * 0.5f + 0.5f) * w, y = (1.0f - (ndc.y * 0.5f + 0.5f)) * h;
+        if (x + r < 0 || y + r < 0 || x - r > w || y - r > h) return;
+        next.push_back({x, y, r * r, {kind, artist, album, track}});
+    }
+
+    // Publishes the frame: counting sort of items into cells
+    void end() {
+        items.swap(next);
+        cols = std::max(1, (w + CELL - 1) / CELL);
+        rows = std::max(1, (h + CELL - 1) / CELL);
+        cellStart.assign((size_t)(cols * rows + 1), 0);
+        wide.clear();
+        for (int pass = 0; pass < 2; pass++) {
+            if (pass == 1) {
+                for (size_t c = 1; c < cellStart.size(); c++) cellStart[c] += cellStart[c - 1];
+                cellItems.resize(cellStart.back());
+                fill.assign(cellStart.begin(), cellStart.end() - 1);
+            }
+            for (uint32_t i = 0; i < (uint32_t)items.size(); i++) {
+                int x0, y0, x1, y1;
+                if (!span(items[i], x0, y0, x1, y1)) {
+                    if (pass == 0) wide.push_back(i);
+                    continue;
+                }
+                for (int cy = y0; cy <= y1; cy++)
+                    for (int cx = x0; cx <= x1; cx++) {
+                        size_t c = (size_t)(cy * cols + cx);
+                        if (pass == 0) cellStart[c + 1]++;
+                        else cellItems[fill[c]++] = i;
+                    }
+            }
+        }
+        generation++;
+    }
+
+    PickHit query(float mx, float my) {
+        if (generation == lastGeneration && mx == lastX && my == lastY) return last;
+        lastGeneration = generation;
+        lastX = mx;
+        lastY = my;
+        last = PickHit();
+        if (mx < 0 || my < 0 || mx >= w || my >= h || items.empty()) return last;
+
+        float bestD = 0;
+        auto test = [&](uint32_t i) {
+            const Item& it = items[i];
+            float dx = it.x - mx, dy = it.y - my, d = dx * dx + dy * dy;
+            if (d >= it.r2) return;
+            bool better = !last.valid() || layer(it.hit.kind) > layer(last.kind) ||
+                          (layer(it.hit.kind) == layer(last.kind) && d < bestD);
+            if (better) { last = it.hit; bestD = d; }
+        };
+        size_t c = (size_t)(std::min((int)my / CELL, rows - 1) * cols + std::min((int)mx / CELL, cols - 1));
+        for (uint32_t k = cellStart[c]; k < cellStart[c + 1]; k++) test(cellItems[k]);
+        for (uint32_t i : wide) test(i);
+        return last;
+    }
+
+    size_t size() const { return items.size(); }
+
+private:
+    struct Item { float x, y, r2; PickHit hit; };
+
+    glm::mat4 vp = glm::mat4(1.0f);
+    int w = 0, h = 0, cols = 1, rows = 1;
+    std::vector<Item> items, next;
+    std::vector<uint32_t> cellStart, cellItems, fill, wide;
+    uint64_t generation = 0, lastGeneration = ~0ull;
+    float lastX = -1, lastY = -1;
+    PickHit last;
+
+    static int layer(PickKind k) { return k == PickKind::Star ? 0 : 1; }
+
+    bool span(const Item& it, int& x0, int& y0, int& x1, int& y1) const {
+        float r = sqrtf(it.r2);
+        x0 = std::max(0, (int)((it.x - r) / CELL));
+        y0 = std::max(0, (int)((it.y - r) / CELL));
+        x1 = std::min(cols - 1, (int)((it.x + r) / CELL));
+        y1 = std::min(rows - 1, (int)((it.y + r) / CELL));
+        return x1 - x0 < MAX_SPAN && y1 - y0 < MAX_SPAN;
+    }
+};
@@ -0,0 +1,362 @@
+#pragma once
+
+#include "music_data.h"
+#include "collation.h"
+#include "galaxy_snapshot.h"
+#include "log.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cctype>
+#include <cstdlib>
+#include <cstdint>
+
+// ============================================================
+// PLAYLISTS - M3U / M3U8 import. Entries resolve to library tracks
+// through hash indexes built once per library, so a 20k-entry radio
+// rotation costs a few lookups per line instead of a walk over
+// library.artists for each one. Tried in order:
+//   id     Subsonic track ID: stream URLs ("...?id=XYZ&...") or a bare ID
+//   path   file path, absolute or relative to the playlist, file:// too
+//   tail   album folder + file name, for playlists written against
+//          another mount point or machine
+//   name   folded artist + title from #EXTINF, for moved or renamed files
+// ============================================================
+
+struct TrackRef {
+    int artist = -1, album = -1, track = -1;
+    bool valid() const { return artist >= 0; }
+    bool operator==(const TrackRef& o) const { return artist == o.artist && album == o.album && track == o.track; }
+    bool operator<(const TrackRef& o) const {
+        return artist != o.artist ? artist < o.artist : album != o.album ? album < o.album : track < o.track;
+    }
+};
+
+// One playlist line, as read; kept so the queue can be resolved again
+// when the library changes underneath it
+struct PlaylistEntry {
+    std::string location;
+    std::string artist, title;   // #EXTINF hint, may be empty
+};
+
+struct Playlist {
+    std::string name;            // file name without extension
+    std::string dir;             // relative entries start here
+    std::vector<PlaylistEntry> entries;
+};
+
+// Lexical normalization: '/' separators, no "." or "a/.." components,
+// no doubled slashes. Case-folded on Windows. No filesystem access.
+inline std::string normalizeTrackPath(const std::string& in) {
+    auto sep = [](char c) { return c == '/' || c == '\\'; };
+    bool absolute = !in.empty() && sep(in[0]);
+    size_t root = absolute ? 1 : 0;
+    std::string out(absolute ? "/" : "");
+    out.reserve(in.size());
+    for (size_t i = 0, n = in.size(); i < n; ) {
+        size_t end = i;
+        while (end < n && !sep(in[end])) end++;
+        size_t len = end - i;
+        bool dotdot = len == 2 && in[i] == '.' && in[i + 1] == '.';
+        bool lastDotdot = out.size() >= root + 2 && out.compare(out.size() - 2, 2, "..") == 0 &&
+                          (out.size() == root + 2 || out[out.size() - 3] == '/');
+        if (len == 0 || (len == 1 && in[i] == '.')) {
+            // skip
+        } else if (dotdot && out.size() > root && !lastDotdot) {
+            size_t cut = out.rfind('/');
+            out.resize(cut == std::string::npos || cut < root ? root : cut);
+        } else if (!dotdot || !absolute) {
+            if (out.size() > root) out += '/';
+#ifdef _WIN32
+            for (size_t k = i; k < end; k++) out += (char)tolower((unsigned char)in[k]);
+#else
+            out.append(in, i, len);
+#endif
+        }
+        i = end + 1;
+    }
+    return out;
+}
+
+// Offset of "Album/03 Song.flac" in a normalized path; 0 when it has
+// fewer than two components
+inline size_t pathTail(const std::string& normalized) {
+    size_t last = normalized.rfind('/');
+    if (last == std::string::npos || last == 0) return 0;
+    size_t prev = normalized.rfind('/', last - 1);
+    return prev == std::string::npos ? 0 : prev + 1;
+}
+
+inline std::string percentDecode(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] == '%' && i + 2 < s.size() && isxdigit((unsigned char)s[i + 1]) && isxdigit((unsigned char)s[i + 2])) {
+            out += (char)strtol(s.substr(i + 1, 2).c_str(), nullptr, 16);
+            i += 2;
+        } else {
+            out += s[i];
+        }
+    }
+    return out;
+}
+
+// Value of the "id" query parameter, "" when there is none
+inline std::string urlTrackId(const std::string& url) {
+    size_t q = url.find('?');
+    while (q != std::string::npos) {
+        size_t start = q + 1;
+        size_t end = url.find('&', start);
+        std::string param = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        if (param.compare(0, 3, "id=") == 0) return percentDecode(param.substr(3));
+        q = end;
+    }
+    return "";
+}
+
+inline uint64_t trackNameKey(const std::string& artist, const std::string& title) {
+    std::string a = collation::fold(artist), t = collation::fold(title);
+    return fnv1a64(t.data(), t.size(), fnv1a64("\x1f", 1, fnv1a64(a.data(), a.size())));
+}
+
+// M3U / M3U8 text -> entries. Plain M3U is taken as UTF-8 too.
+inline Playlist parsePlaylist(const std::string& text) {
+    Playlist pl;
+    std::istringstream in(text);
+    std::string line, hintArtist, hintTitle;
+    bool first = true;
+    while (std::getline(in, line)) {
+        if (first && line.compare(0, 3, "\xEF\xBB\xBF") == 0) line.erase(0, 3);  // BOM
+        first = false;
+        while (!line.empty() && isspace((unsigned char)line.back())) line.pop_back();
+        size_t lead = 0;
+        while (lead < line.size() && isspace((unsigned char)line[lead])) lead++;
+        line.erase(0, lead);
+        if (line.empty()) continue;
+        if (line[0] == '#') {
+            // #EXTINF:<seconds>[ attrs],Artist - Title
+            if (line.compare(0, 8, "#EXTINF:") == 0) {
+                size_t comma = line.find(',');
+                std::string info = comma == std::string::npos ? "" : line.substr(comma + 1);
+                size_t dash = info.find(" - ");
+                hintArtist = dash == std::string::npos ? "" : info.substr(0, dash);
+                hintTitle = dash == std::string::npos ? "" : info.substr(dash + 3);
+            }
+            continue;
+        }
+        pl.entries.push_back({line, std::move(hintArtist), std::move(hintTitle)});
+        hintArtist.clear();
+        hintTitle.clear();
+    }
+    return pl;
+}
+
+inline bool loadPlaylistFile(const std::string& path, Playlist& pl) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    std::stringstream ss;
+    ss << f.rdbuf();
+    pl = parsePlaylist(ss.str());
+    size_t slash = path.find_last_of("/\\");
+    std::string file = slash == std::string::npos ? path : path.substr(slash + 1);
+    pl.name = file.substr(0, file.rfind('.'));
+    pl.dir = slash == std::string::npos ? "." : path.substr(0, slash);
+    return true;
+}
+
+// True when normalizeTrackPath would return the path unchanged, so the
+// library's (already clean) paths hash without a copy
+inline bool isNormalPath(const std::string& p) {
+#ifdef _WIN32
+    return false;
+#else
+    if (p.empty() || p.back() == '/' || p.find('\\') != std::string::npos) return false;
+    for (size_t i = p.find('/'); i != std::string::npos; i = p.find('/', i + 1)) {
+        size_t next = i + 1;
+        if (next < p.size() && p[next] == '/') return false;
+        if (next < p.size() && p[next] == '.') {
+            size_t len = std::min(p.find('/', next), p.size()) - next;
+            if (len == 1 || (len == 2 && p[next + 1] == '.')) return false;
+        }
+    }
+    return p.compare(0, 2, "./") != 0 && p.compare(0, 3, "../") != 0;
+#endif
+}
+
+// ============================================================
+// Hash indexes over one library: FNV-1a of the normalized key -> track,
+// as sorted flat arrays (one allocation each, binary-searched). Build
+// after the library settles and clear whenever it is re-sorted -- the
+// refs are plain indices. Names are folded per track, the slow part, so
+// that index waits until a playlist has #EXTINF hints.
+// ============================================================
+class PlaylistIndex {
+public:
+    bool empty() const { return !built; }
+    bool hasNames() const { return namesBuilt; }
+
+    void clear() {
+        byPath.clear();
+        byTail.clear();
+        byId.clear();
+        byName.clear();
+        built = namesBuilt = false;
+    }
+
+    void build(const MusicLibrary& lib) {
+        clear();
+        byPath.reserve(lib.totalTracks);
+        byTail.reserve(lib.totalTracks);
+        std::string norm;
+        forEachTrack(lib, [&](const ArtistData&, const TrackData& t, TrackRef ref) {
+            if (!t.id.empty()) byId.add(hash(t.id), ref);
+            if (t.filePath.empty() || t.filePath.find("://") != std::string::npos) return;
+            const std::string& path = isNormalPath(t.filePath) ? t.filePath : (norm = normalizeTrackPath(t.filePath));
+            byPath.add(hash(path), ref);
+            size_t tail = pathTail(path);
+            byTail.add(fnv1a64(path.data() + tail, path.size() - tail), ref);
+        });
+        byPath.seal(false);
+        byId.seal(false);
+        // Same folder/file in two places can't decide anything
+        byTail.seal(true);
+        built = true;
+    }
+
+    void buildNames(const MusicLibrary& lib) {
+        byName.reserve(lib.totalTracks);
+        forEachTrack(lib, [&](const ArtistData& artist, const TrackData& t, TrackRef ref) {
+            // Compilations: the track artist and the star's name both match
+            byName.add(trackNameKey(t.artist.empty() ? artist.name : t.artist, t.title), ref);
+            if (!t.artist.empty() && t.artist != artist.name)
+                byName.add(trackNameKey(artist.name, t.title), ref);
+        });
+        byName.seal(false);
+        namesBuilt = true;
+    }
+
+    TrackRef resolve(const PlaylistEntry& e, const std::string& dir) const {
+        const std::string& loc = e.location;
+        bool fileUrl = loc.compare(0, 7, "file://") == 0;
+        if (!fileUrl && loc.find("://") != std::string::npos) {
+            std::string id = urlTrackId(loc);
+            if (TrackRef r = byId.find(hash(id)); !id.empty() && r.valid()) return r;
+        } else {
+            // Bare Subsonic IDs have no separators or extension
+            if (loc.find_first_of("/\\.") == std::string::npos)
+                if (TrackRef r = byId.find(hash(loc)); r.valid()) return r;
+            std::string path = fileUrl ? percentDecode(loc.substr(7)) : loc;
+            // file:///C:/Music -> C:/Music
+            if (fileUrl && path.size() > 2 && path[0] == '/' && path[2] == ':') path.erase(0, 1);
+            if (path.empty()) return TrackRef();
+            bool absolute = path[0] == '/' || path[0] == '\\' || (path.size() > 1 && path[1] == ':');
+            std::string norm = normalizeTrackPath(absolute ? path : dir + "/" + path);
+            if (TrackRef r = byPath.find(hash(norm)); r.valid()) return r;
+            if (size_t tail = pathTail(norm))
+                if (TrackRef r = byTail.find(fnv1a64(norm.data() + tail, norm.size() - tail)); r.valid()) return r;
+        }
+        if (e.title.empty() || !namesBuilt) return TrackRef();
+        return byName.find(trackNameKey(e.artist, e.title));
+    }
+
+private:
+    struct Table {
+        std::vector<std::pair<uint64_t, TrackRef>> rows;
+        void clear() { rows.clear(); }
+        void reserve(size_t n) { rows.reserve(n); }
+        void add(uint64_t key, TrackRef ref) { rows.push_back({key, ref}); }
+        // Sort by key; repeated keys keep the first track (refs are added
+        // in library order), or none when ambiguous and they disagree
+        void seal(bool ambiguousIsMiss) {
+            std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+                return a.first != b.first ? a.first < b.first : a.second < b.second;
+            });
+            size_t out = 0;
+            for (size_t i = 0; i < rows.size(); ) {
+                size_t j = i + 1;
+                bool agree = true;
+                for (; j < rows.size() && rows[j].first == rows[i].first; j++)
+                    agree = agree && rows[j].second == rows[i].second;
+                rows[out] = rows[i];
+                if (ambiguousIsMiss && !agree) rows[out].second = TrackRef();
+                out++;
+                i = j;
+            }
+            rows.resize(out);
+        }
+        TrackRef find(uint64_t key) const {
+            auto it = std::lower_bound(rows.begin(), rows.end(), key,
+                                       [](const auto& row, uint64_t k) { return row.first < k; });
+            return it != rows.end() && it->first == key ? it->second : TrackRef();
+        }
+    };
+
+    static uint64_t hash(const std::string& s) { return fnv1a64(s.data(), s.size()); }
+
+    template <typename Fn>
+    static void forEachTrack(const MusicLibrary& lib, Fn fn) {
+        for (int ai = 0; ai < (int)lib.artists.size(); ai++) {
+            const ArtistData& artist = lib.artists[ai];
+            for (int bi = 0; bi < (int)artist.albums.size(); bi++) {
+                const auto& tracks = artist.albums[bi].tracks;
+                for (int ti = 0; ti < (int)tracks.size(); ti++) fn(artist, tracks[ti], TrackRef{ai, bi, ti});
+            }
+        }
+    }
+
+    Table byPath, byTail, byId, byName;
+    bool built = false, namesBuilt = false;
+};
+
+// ============================================================
+// PLAY QUEUE - a resolved playlist. tracks lines up with the playlist's
+// entries (misses stay invalid), so the position survives re-resolving.
+// ============================================================
+struct PlayQueue {
+    Playlist playlist;
+    std::vector<TrackRef> tracks;
+    std::vector<int> stars;      // artists in order of first appearance (the constellation)
+    int pos = -1;
+    int resolved = 0;
+
+    bool active() const { return resolved > 0; }
+
+    void resolve(PlaylistIndex& index, const MusicLibrary& lib) {
+        int numArtists = (int)lib.artists.size();
+        if (index.empty()) index.build(lib);
+        if (!index.hasNames())
+            for (auto& e : playlist.entries)
+                if (!e.title.empty()) { index.buildNames(lib); break; }
+        tracks.assign(playlist.entries.size(), TrackRef());
+        stars.clear();
+        resolved = 0;
+        std::vector<bool> seen(numArtists, false);
+        for (size_t i = 0; i < tracks.size(); i++) {
+            TrackRef r = index.resolve(playlist.entries[i], playlist.dir);
+            if (!r.valid() || r.artist >= numArtists) continue;
+            tracks[i] = r;
+            resolved++;
+            if (!seen[r.artist]) {
+                seen[r.artist] = true;
+                stars.push_back(r.artist);
+            }
+        }
+    }
+
+    // Next resolved entry after 'from' (dir +1) or before it (-1); -1 at either end
+    int step(int from, int dir) const {
+        for (int i = from + dir; i >= 0 && i < (int)tracks.size(); i += dir)
+            if (tracks[i].valid()) return i;
+        return -1;
+    }
+
+    void clear() {
+        playlist = Playlist();
+        tracks.clear();
+        stars.clear();
+        pos = -1;
+        resolved = 0;
+    }
+};
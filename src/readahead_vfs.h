@@ -0,0 +1,358 @@
+#pragma once
+
+#include "miniaudio.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include "log.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifndef __ANDROID__
+#include "library_roots.h"   // detectDeviceClass
+#endif
+
+// ============================================================
+// READ-AHEAD VFS - miniaudio file layer for slow storage.
+// Decoders issue small synchronous reads. On NFS/SMB or a spun-down
+// disk each one can stall long enough to starve the stream.
+// Local files are mmapped and paged in ahead of the cursor with
+// madvise. Network files are read in large chunks by an I/O thread
+// into a fixed pool per file, so decoder reads are just copies.
+// ============================================================
+
+struct ReadAheadStats {
+    std::atomic<uint64_t> bytes{0};         // delivered to decoders
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> underruns{0};     // reads that had to wait on storage
+    std::atomic<uint64_t> stallMicros{0};
+};
+
+class ReadAheadVFS {
+public:
+    static constexpr size_t CHUNK = 256 * 1024;
+    static constexpr int CHUNKS = 8;                    // 2 MB window per buffered file
+    static constexpr int64_t MAP_AHEAD = 4 * 1024 * 1024;
+
+    ReadAheadStats stats;
+
+    ~ReadAheadVFS() { stop(); }
+
+    void start() {
+        if (ioThread.joinable()) return;
+        handle.self = this;
+        handle.cb = {};
+        handle.cb.onOpen = onOpen;
+        handle.cb.onClose = onClose;
+        handle.cb.onRead = onRead;
+        handle.cb.onSeek = onSeek;
+        handle.cb.onTell = onTell;
+        handle.cb.onInfo = onInfo;
+        quit = false;
+        ioThread = std::thread([this] { ioLoop(); });
+    }
+
+    void stop() {
+        if (!ioThread.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(m);
+            quit = true;
+        }
+        ioWake.notify_all();
+        ioThread.join();
+    }
+
+    // For ma_engine_config::pResourceManagerVFS
+    ma_vfs* vfs() { return &handle; }
+
+private:
+    struct Chunk {
+        int64_t offset = -1;
+        size_t len = 0;
+        bool ready = false;
+        std::vector<uint8_t> data;
+    };
+
+    struct File {
+        std::string path;
+        int fd = -1;
+        int64_t size = 0;
+        std::atomic<int64_t> cursor{0};
+        // mmap mode (local storage)
+        uint8_t* map = nullptr;
+        std::atomic<int64_t> advised{0};
+        // buffered mode (network storage)
+        Chunk chunks[CHUNKS];
+        int64_t fillPos = 0;
+        int inflight = 0;
+        bool error = false;
+        // Per-file totals for the close log
+        uint64_t underruns = 0;
+        uint64_t stallMicros = 0;
+    };
+
+    // miniaudio casts the ma_vfs* to ma_vfs_callbacks*, so cb goes first
+    struct Handle {
+        ma_vfs_callbacks cb;
+        ReadAheadVFS* self;
+    } handle;
+
+    std::mutex m;
+    std::condition_variable ioWake;     // reader moved / file opened
+    std::condition_variable dataReady;  // chunk landed
+    std::vector<File*> files;
+    std::thread ioThread;
+    bool quit = false;
+
+    static ReadAheadVFS& self(ma_vfs* v) { return *((Handle*)v)->self; }
+
+    static bool isNetworkPath(const std::string& path) {
+#ifdef __ANDROID__
+        (void)path;
+        return false;   // playback is from the local stream cache
+#else
+        return detectDeviceClass(path) == DeviceClass::Network;
+#endif
+    }
+
+    // ---- I/O thread ----
+
+    bool windowFull(File& f) const {
+        int64_t ahead = f.map ? MAP_AHEAD : (int64_t)(CHUNK * CHUNKS);
+        int64_t pos = f.map ? (int64_t)f.advised : f.fillPos;
+        return pos >= f.size || pos >= f.cursor + ahead;
+    }
+
+    // A chunk is reusable once the decoder has moved past it, or it is
+    // beyond the window (left behind by a backwards seek). Failing that,
+    // the one furthest ahead gives way to data the decoder needs sooner.
+    Chunk* freeChunk(File& f) {
+        int64_t cur = f.cursor;
+        Chunk* furthest = nullptr;
+        for (auto& c : f.chunks) {
+            if (c.offset < 0) return &c;
+            if (!c.ready) continue;
+            if (c.offset + (int64_t)c.len <= cur || c.offset >= cur + (int64_t)(CHUNK * CHUNKS)) return &c;
+            if (c.offset > f.fillPos && (!furthest || c.offset > furthest->offset)) furthest = &c;
+        }
+        return furthest;
+    }
+
+    void ioLoop() {
+        std::unique_lock<std::mutex> lock(m);
+        while (!quit) {
+            bool worked = false;
+            for (File* f : files) {
+                if (f->error || windowFull(*f)) continue;
+                if (f->map) {
+                    // Kick the kernel's page-in ahead of the decoder
+                    int64_t from = std::max((int64_t)f->advised, (int64_t)f->cursor);
+                    int64_t page = sysconf(_SC_PAGESIZE);
+                    from -= from % page;
+                    size_t len = (size_t)std::min<int64_t>(CHUNK, f->size - from);
+                    madvise(f->map + from, len, MADV_WILLNEED);
+                    f->advised = from + (int64_t)len;
+                    worked = true;
+                    continue;
+                }
+                // Skip over ranges already buffered or in flight
+                for (bool moved = true; moved; ) {
+                    moved = false;
+                    for (auto& c : f->chunks)
+                        if (c.offset >= 0 && c.offset <= f->fillPos && f->fillPos < c.offset + (int64_t)c.len) {
+                            f->fillPos = c.offset + (int64_t)c.len;
+                            moved = true;
+                        }
+                }
+                if (windowFull(*f)) continue;
+                Chunk* c = freeChunk(*f);
+                if (!c) continue;
+                c->offset = f->fillPos;
+                c->len = (size_t)std::min<int64_t>(CHUNK, f->size - f->fillPos);
+                c->ready = false;
+                c->data.resize(CHUNK);
+                f->fillPos += (int64_t)c->len;
+                f->inflight++;
+
+                lock.unlock();
+                ssize_t n = pread(f->fd, c->data.data(), c->len, c->offset);
+                lock.lock();
+
+                if (n < (ssize_t)c->len) {
+                    // Short read: the file shrank or the share dropped out
+                    if (n <= 0) f->error = true;
+                    c->len = (size_t)std::max<ssize_t>(n, 0);
+                }
+                c->ready = true;
+                f->inflight--;
+                dataReady.notify_all();
+                worked = true;
+                break;  // files may have changed while unlocked
+            }
+            if (!worked) ioWake.wait(lock);
+        }
+    }
+
+    // ---- miniaudio callbacks (resource manager job thread) ----
+
+    static ma_result onOpen(ma_vfs* v, const char* path, ma_uint32 mode, ma_vfs_file* out) {
+        if (!out || !path) return MA_INVALID_ARGS;
+        *out = nullptr;
+        if (mode & MA_OPEN_MODE_WRITE) return MA_INVALID_OPERATION;
+
+        int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return MA_DOES_NOT_EXIST;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); return MA_IO_ERROR; }
+
+        File* f = new File();
+        f->path = path;
+        f->fd = fd;
+        f->size = (int64_t)st.st_size;
+        if (f->size > 0 && !isNetworkPath(path)) {
+            void* p = mmap(nullptr, (size_t)f->size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                f->map = (uint8_t*)p;
+                madvise(p, (size_t)f->size, MADV_SEQUENTIAL);
+            }
+        }
+#ifdef POSIX_FADV_SEQUENTIAL
+        if (!f->map) posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        ReadAheadVFS& s = self(v);
+        {
+            std::lock_guard<std::mutex> lock(s.m);
+            s.files.push_back(f);
+        }
+        s.ioWake.notify_all();
+        *out = (ma_vfs_file)f;
+        return MA_SUCCESS;
+    }
+
+    static ma_result onClose(ma_vfs* v, ma_vfs_file file) {
+        ReadAheadVFS& s = self(v);
+        File* f = (File*)file;
+        {
+            std::unique_lock<std::mutex> lock(s.m);
+            s.dataReady.wait(lock, [&] { return f->inflight == 0; });
+            s.files.erase(std::remove(s.files.begin(), s.files.end(), f), s.files.end());
+        }
+        if (f->underruns > 0) {
+            LOG_INFO("ReadAhead") << f->path << ": " << f->underruns << " underruns, "
+                                  << f->stallMicros / 1000 << " ms stalled";
+        }
+        if (f->map) munmap(f->map, (size_t)f->size);
+        ::close(f->fd);
+        delete f;
+        return MA_SUCCESS;
+    }
+
+    static ma_result onRead(ma_vfs* v, ma_vfs_file file, void* dst, size_t bytes, size_t* bytesRead) {
+        ReadAheadVFS& s = self(v);
+        File* f = (File*)file;
+        uint8_t* out = (uint8_t*)dst;
+        size_t done = 0;
+        bool waited = false;
+        auto t0 = std::chrono::steady_clock::now();
+
+        if (f->map) {
+            int64_t cur = f->cursor;
+            done = (size_t)std::max<int64_t>(0, std::min<int64_t>((int64_t)bytes, f->size - cur));
+            if (done > 0) {
+                // Pages not resident yet mean this copy will fault on storage
+                int64_t page = sysconf(_SC_PAGESIZE);
+                int64_t from = cur - cur % page;
+                size_t span = (size_t)(cur + (int64_t)done - from);
+#ifdef __APPLE__
+                char resident[64];
+#else
+                unsigned char resident[64];
+#endif
+                if (span <= 64 * (size_t)page && mincore(f->map + from, span, resident) == 0) {
+                    for (size_t i = 0; i < (span + page - 1) / page; i++)
+                        if (!(resident[i] & 1)) { waited = true; break; }
+                }
+                memcpy(out, f->map + cur, done);
+                f->cursor = cur + (int64_t)done;
+            }
+            if (f->advised < f->cursor + MAP_AHEAD / 2) {
+                // Under m, or the I/O thread can check windowFull and miss this before it waits
+                std::lock_guard<std::mutex> lock(s.m);
+                s.ioWake.notify_all();
+            }
+        } else {
+            std::unique_lock<std::mutex> lock(s.m);
+            while (done < bytes && f->cursor < f->size && !f->error) {
+                int64_t cur = f->cursor;
+                Chunk* hit = nullptr;
+                for (auto& c : f->chunks)
+                    if (c.offset >= 0 && c.offset <= cur && cur < c.offset + (int64_t)c.len) { hit = &c; break; }
+                if (hit && hit->ready) {
+                    size_t k = std::min(bytes - done, (size_t)(hit->offset + (int64_t)hit->len - cur));
+                    memcpy(out + done, hit->data.data() + (cur - hit->offset), k);
+                    done += k;
+                    f->cursor = cur + (int64_t)k;
+                    continue;
+                }
+                // Not buffered: point the I/O thread here and wait
+                if (!hit) f->fillPos = cur;
+                waited = true;
+                s.ioWake.notify_all();
+                s.dataReady.wait(lock);
+            }
+            s.ioWake.notify_all();  // freed chunks behind the cursor
+            if (f->error && done == 0) return MA_IO_ERROR;
+        }
+
+        if (waited) {
+            uint64_t us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - t0).count();
+            f->underruns++;
+            f->stallMicros += us;
+            s.stats.underruns++;
+            s.stats.stallMicros += us;
+        }
+        s.stats.reads++;
+        s.stats.bytes += done;
+        if (bytesRead) *bytesRead = done;
+        return (done == 0 && bytes > 0) ? MA_AT_END : MA_SUCCESS;
+    }
+
+    static ma_result onSeek(ma_vfs* v, ma_vfs_file file, ma_int64 offset, ma_seek_origin origin) {
+        File* f = (File*)file;
+        int64_t base = origin == ma_seek_origin_start ? 0
+                     : origin == ma_seek_origin_current ? (int64_t)f->cursor : f->size;
+        int64_t pos = base + offset;
+        if (pos < 0 || pos > f->size) return MA_BAD_SEEK;
+        ReadAheadVFS& s = self(v);
+        std::lock_guard<std::mutex> lock(s.m);
+        f->cursor = pos;
+        // Seeking back past the window: advise again from here, or the old
+        // high-water mark keeps windowFull true until playback catches up
+        if (f->map && pos < f->advised - MAP_AHEAD) f->advised = pos;
+        s.ioWake.notify_all();
+        return MA_SUCCESS;
+    }
+
+    static ma_result onTell(ma_vfs*, ma_vfs_file file, ma_int64* pos) {
+        *pos = ((File*)file)->cursor;
+        return MA_SUCCESS;
+    }
+
+    static ma_result onInfo(ma_vfs*, ma_vfs_file file, ma_file_info* info) {
+        info->sizeInBytes = (ma_uint64)((File*)file)->size;
+        return MA_SUCCESS;
+    }
+};
+
+#endif // !_WIN32
@@ -0,0 +1,503 @@
+#pragma once
+
+#ifdef __ANDROID__
+#include <GLES3/gl3.h>
+#else
+#include <GL/glew.h>
+#endif
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "shader.h"
+
+// ============================================================
+// RENDER DEVICE - thin command interface used by the scene code
+// GLRenderDevice forwards to OpenGL / OpenGL ES. NullRenderDevice
+// accepts and counts every command without touching a GL context,
+// so the full frame can be profiled on headless CI machines.
+// ============================================================
+
+enum class BlendMode { Alpha, Additive };
+
+// What a pass does with an attachment's old contents, and what happens
+// to what it drew once it ends. Tile-based GPUs (Mali, Adreno, Tegra)
+// skip the memory round trip for Clear / DontCare loads and DontCare
+// stores; desktop drivers mostly ignore the hints.
+enum class LoadOp { Clear, Load, DontCare };
+enum class StoreOp { Store, DontCare };
+
+struct PassDesc {
+    GLuint fbo = 0;                 // 0 = window
+    int width = 0, height = 0;
+    glm::vec4 clearColor = glm::vec4(0, 0, 0, 1);
+    LoadOp colorLoad = LoadOp::Clear, depthLoad = LoadOp::Clear;
+    StoreOp colorStore = StoreOp::Store;
+    StoreOp depthStore = StoreOp::DontCare;   // depth/stencil rarely outlives its pass
+};
+enum class PrimitiveType { Triangles, LineStrip, Points };
+
+// Every command the scene can issue (used for per-frame counters)
+enum class RenderOp {
+    BeginPass, EndPass, CopyDepth, UseShader, SetUniform, BindTexture, SetBlend,
+    SetDepthWrite, SetDepthTest, SetCullFront, SetLineWidth,
+    UpdateMesh, Draw, ResetState, Count
+};
+
+struct VertexAttrib {
+    GLuint location;
+    GLint components;
+    GLenum type;        // GL_FLOAT, GL_UNSIGNED_BYTE, ...
+    bool normalized;
+    size_t offset;
+};
+
+struct MeshDesc {
+    const void* vertices = nullptr;
+    size_t vertexBytes = 0;
+    int vertexCount = 0;
+    int stride = 0;
+    std::vector<VertexAttrib> attribs;
+    const void* indices = nullptr;   // nullptr = non-indexed
+    int indexCount = 0;
+    GLenum indexType = GL_UNSIGNED_INT;
+    PrimitiveType primitive = PrimitiveType::Triangles;
+    bool dynamic = false;            // contents replaced with updateMesh()
+};
+
+struct Mesh {
+    GLuint vao = 0, vbo = 0, ebo = 0;
+    int count = 0;                   // index count if indexed, else vertex count
+    GLenum indexType = 0;            // 0 = non-indexed
+    PrimitiveType primitive = PrimitiveType::Triangles;
+    size_t capacity = 0;             // vertex buffer size in bytes
+};
+
+// Offscreen color (RGBA8, linear) + depth/stencil (D24S8, nearest);
+// both are textures so later passes can sample them
+struct RenderTarget {
+    GLuint fbo = 0, color = 0, depth = 0;
+    int width = 0, height = 0;
+};
+
+struct RenderStats {
+    uint64_t ops[(int)RenderOp::Count] = {};
+    uint64_t vertices = 0;           // vertices/indices submitted by draws
+    uint64_t uploadBytes = 0;        // dynamic buffer traffic
+    uint64_t attachmentBytes = 0;    // tile loads + stores the pass intents imply (4 B/px each)
+    uint64_t total() const {
+        uint64_t t = 0;
+        for (uint64_t n : ops) t += n;
+        return t;
+    }
+};
+
+inline const char* renderOpName(RenderOp op) {
+    static const char* names[] = {
+        "beginPass", "endPass", "copyDepth", "useShader", "setUniform", "bindTexture", "setBlend",
+        "setDepthWrite", "setDepthTest", "setCullFront", "setLineWidth",
+        "updateMesh", "draw", "resetState"
+    };
+    return names[(int)op];
+}
+
+class RenderDevice {
+public:
+    virtual ~RenderDevice() = default;
+    virtual const char* name() const = 0;
+
+    // --- Resources ---
+    virtual Mesh createMesh(const MeshDesc& desc) = 0;
+    virtual void destroyMesh(Mesh& mesh) = 0;
+    virtual GLuint createTexture(int w, int h, const unsigned char* rgba, bool mipmaps) = 0;
+    virtual void destroyTexture(GLuint& tex) = 0;
+    virtual RenderTarget createTarget(int w, int h, bool color) = 0;
+    virtual void destroyTarget(RenderTarget& t) = 0;
+
+    int liveMeshes() const { return meshCount; }
+    int liveTextures() const { return textureCount; }
+
+    // --- Frame commands (counted, then forwarded to the backend) ---
+    void beginPass(const PassDesc& p) {
+        count(RenderOp::BeginPass);
+        pass = p;
+        uint64_t px = (uint64_t)p.width * p.height * 4;
+        stats.attachmentBytes += px * ((p.colorLoad == LoadOp::Load) + (p.depthLoad == LoadOp::Load));
+        doBeginPass(p);
+    }
+    // Ends the pass begun last; attachments marked DontCare are dropped
+    void endPass() {
+        count(RenderOp::EndPass);
+        uint64_t px = (uint64_t)pass.width * pass.height * 4;
+        stats.attachmentBytes += px * ((pass.colorStore == StoreOp::Store) + (pass.depthStore == StoreOp::Store));
+        doEndPass(pass);
+    }
+    // Depth of framebuffer src (w x h, may be multisampled) into dst,
+    // scaled with nearest sampling. Outside a pass.
+    void copyDepth(GLuint src, int w, int h, const RenderTarget& dst) {
+        count(RenderOp::CopyDepth);
+        stats.attachmentBytes += (uint64_t)w * h * 4 + (uint64_t)dst.width * dst.height * 4;
+        doCopyDepth(src, w, h, dst);
+    }
+    void use(const Shader& s) {
+        count(RenderOp::UseShader); current = &s; doUse(s);
+    }
+    // Uniform setters apply to the shader bound with use()
+    void setMat4(const char* n, const glm::mat4& m) { count(RenderOp::SetUniform); doSetMat4(n, m); }
+    void setVec2(const char* n, float x, float y) { count(RenderOp::SetUniform); doSetVec4(n, 2, x, y, 0, 0); }
+    void setVec3(const char* n, float x, float y, float z) { count(RenderOp::SetUniform); doSetVec4(n, 3, x, y, z, 0); }
+    void setVec4(const char* n, float x, float y, float z, float w) { count(RenderOp::SetUniform); doSetVec4(n, 4, x, y, z, w); }
+    void setFloat(const char* n, float v) { count(RenderOp::SetUniform); doSetVec4(n, 1, v, 0, 0, 0); }
+    void setInt(const char* n, int v) { count(RenderOp::SetUniform); doSetInt(n, v); }
+
+    void bindTexture(GLuint tex, int unit = 0) {
+        count(RenderOp::BindTexture);
+        if (unit == 0) texture = tex;
+        doBindTexture(tex, unit);
+    }
+    void setBlend(BlendMode mode) { count(RenderOp::SetBlend); doSetBlend(mode); }
+    void setDepthWrite(bool on) { count(RenderOp::SetDepthWrite); doSetDepthWrite(on); }
+    void setDepthTest(bool on) { count(RenderOp::SetDepthTest); depthTest = on; doSetDepthTest(on); }
+    void setCullFront(bool on) { count(RenderOp::SetCullFront); doSetCullFront(on); }
+    void setLineWidth(float w) { count(RenderOp::SetLineWidth); doSetLineWidth(w); }
+
+    // Replace the contents of a dynamic mesh (grows the buffer when needed)
+    void updateMesh(Mesh& mesh, const void* data, size_t bytes, int vertexCount) {
+        count(RenderOp::UpdateMesh);
+        stats.uploadBytes += bytes;
+        mesh.count = vertexCount;
+        doUpdateMesh(mesh, data, bytes);
+    }
+    void draw(const Mesh& mesh, int first = 0, int n = -1) {
+        if (n < 0) n = mesh.count - first;
+        if (n <= 0) return;
+        count(RenderOp::Draw);
+        stats.vertices += (uint64_t)n;
+        doDraw(mesh, first, n);
+    }
+
+    // Restore the default state expected by ImGui and the next frame
+    void resetState() { count(RenderOp::ResetState); current = nullptr; depthTest = true; doResetState(); }
+
+    // State as the scene left it (for code that defers draws)
+    GLuint boundTexture() const { return texture; }
+    bool depthTesting() const { return depthTest; }
+
+    RenderStats stats;
+    void resetStats() { stats = RenderStats(); }
+
+protected:
+    const Shader* current = nullptr;
+    PassDesc pass;
+    GLuint texture = 0;         // bound on unit 0
+    bool depthTest = true;
+    int meshCount = 0, textureCount = 0;
+
+    void count(RenderOp op) { stats.ops[(int)op]++; }
+
+    virtual void doBeginPass(const PassDesc& p) = 0;
+    virtual void doEndPass(const PassDesc& p) = 0;
+    virtual void doCopyDepth(GLuint src, int w, int h, const RenderTarget& dst) = 0;
+    virtual void doUse(const Shader& s) = 0;
+    virtual void doSetMat4(const char* n, const glm::mat4& m) = 0;
+    virtual void doSetVec4(const char* n, int components, float x, float y, float z, float w) = 0;
+    virtual void doSetInt(const char* n, int v) = 0;
+    virtual void doBindTexture(GLuint tex, int unit) = 0;
+    virtual void doSetBlend(BlendMode mode) = 0;
+    virtual void doSetDepthWrite(bool on) = 0;
+    virtual void doSetDepthTest(bool on) = 0;
+    virtual void doSetCullFront(bool on) = 0;
+    virtual void doSetLineWidth(float w) = 0;
+    virtual void doUpdateMesh(Mesh& mesh, const void* data, size_t bytes) = 0;
+    virtual void doDraw(const Mesh& mesh, int first, int n) = 0;
+    virtual void doResetState() = 0;
+};
+
+// ============================================================
+// GL / GLES BACKEND
+// ============================================================
+class GLRenderDevice : public RenderDevice {
+public:
+    // Needs a current context (GLEW initialised on desktop)
+    GLRenderDevice() {
+#ifdef __ANDROID__
+        canInvalidate = true;   // core in GLES 3.0
+#else
+        canInvalidate = GLEW_VERSION_4_3 || GLEW_ARB_invalidate_subdata;
+#endif
+    }
+
+    const char* name() const override { return "gl"; }
+
+    Mesh createMesh(const MeshDesc& d) override {
+        Mesh m;
+        m.primitive = d.primitive;
+        m.capacity = d.vertexBytes;
+        glGenVertexArrays(1, &m.vao);
+        glGenBuffers(1, &m.vbo);
+        glBindVertexArray(m.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
+        glBufferData(GL_ARRAY_BUFFER, d.vertexBytes, d.vertices, d.dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+        if (d.indices) {
+            size_t indexSize = (d.indexType == GL_UNSIGNED_SHORT) ? 2 : 4;
+            glGenBuffers(1, &m.ebo);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.ebo);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, d.indexCount * indexSize, d.indices, GL_STATIC_DRAW);
+            m.indexType = d.indexType;
+            m.count = d.indexCount;
+        } else {
+            m.count = d.vertexCount;
+        }
+        for (auto& a : d.attribs) {
+            glVertexAttribPointer(a.location, a.components, a.type, a.normalized ? GL_TRUE : GL_FALSE,
+                d.stride, (void*)a.offset);
+            glEnableVertexAttribArray(a.location);
+        }
+        glBindVertexArray(0);
+        meshCount++;
+        return m;
+    }
+
+    void destroyMesh(Mesh& m) override {
+        if (!m.vao) return;
+        glDeleteVertexArrays(1, &m.vao);
+        glDeleteBuffers(1, &m.vbo);
+        if (m.ebo) glDeleteBuffers(1, &m.ebo);
+        m = Mesh();
+        meshCount--;
+    }
+
+    GLuint createTexture(int w, int h, const unsigned char* rgba, bool mipmaps) override {
+        GLuint tex;
+        glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+        if (mipmaps) glGenerateMipmap(GL_TEXTURE_2D);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        textureCount++;
+        return tex;
+    }
+
+    void destroyTexture(GLuint& tex) override {
+        if (!tex) return;
+        glDeleteTextures(1, &tex);
+        tex = 0;
+        textureCount--;
+    }
+
+    RenderTarget createTarget(int w, int h, bool color) override {
+        RenderTarget t;
+        t.width = w;
+        t.height = h;
+        auto makeTexture = [&](GLenum internal, GLenum format, GLenum type, GLint filter) {
+            GLuint tex;
+            glGenTextures(1, &tex);
+            glBindTexture(GL_TEXTURE_2D, tex);
+            glTexImage2D(GL_TEXTURE_2D, 0, internal, w, h, 0, format, type, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            return tex;
+        };
+        glGenFramebuffers(1, &t.fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, t.fbo);
+        if (color) {
+            t.color = makeTexture(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, GL_LINEAR);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, t.color, 0);
+        } else {
+            GLenum none = GL_NONE;
+            glDrawBuffers(1, &none);
+        }
+        // Depth textures aren't filterable in GLES 3.0
+        t.depth = makeTexture(GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, t.depth, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return t;
+    }
+
+    void destroyTarget(RenderTarget& t) override {
+        if (!t.fbo) return;
+        glDeleteFramebuffers(1, &t.fbo);
+        if (t.color) glDeleteTextures(1, &t.color);
+        glDeleteTextures(1, &t.depth);
+        t = RenderTarget();
+    }
+
+protected:
+    bool canInvalidate = false;
+
+    // Drops color and/or depth+stencil of the bound framebuffer
+    void invalidate(GLuint fbo, bool color, bool depth) {
+        if (!canInvalidate || (!color && !depth)) return;
+        GLenum att[3];
+        GLsizei n = 0;
+        if (color) att[n++] = fbo ? GL_COLOR_ATTACHMENT0 : GL_COLOR;
+        if (depth) {
+            att[n++] = fbo ? GL_DEPTH_ATTACHMENT : GL_DEPTH;
+            att[n++] = fbo ? GL_STENCIL_ATTACHMENT : GL_STENCIL;
+        }
+        glInvalidateFramebuffer(GL_FRAMEBUFFER, n, att);
+    }
+
+    void doBeginPass(const PassDesc& p) override {
+        glBindFramebuffer(GL_FRAMEBUFFER, p.fbo);
+        glViewport(0, 0, p.width, p.height);
+        invalidate(p.fbo, p.colorLoad == LoadOp::DontCare, p.depthLoad == LoadOp::DontCare);
+        GLbitfield clear = 0;
+        if (p.colorLoad == LoadOp::Clear) {
+            const glm::vec4& c = p.clearColor;
+            glClearColor(c.r, c.g, c.b, c.a);
+            clear |= GL_COLOR_BUFFER_BIT;
+        }
+        if (p.depthLoad == LoadOp::Clear) clear |= GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
+        if (clear) glClear(clear);
+    }
+    void doEndPass(const PassDesc& p) override {
+        // Before anything binds another target, so a tiler never writes them back
+        invalidate(p.fbo, p.colorStore == StoreOp::DontCare, p.depthStore == StoreOp::DontCare);
+    }
+    void doCopyDepth(GLuint src, int w, int h, const RenderTarget& dst) override {
+        // A multisampled source resolves only at 1:1; formats must match (D24S8)
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, src);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, dst.fbo);
+        glBlitFramebuffer(0, 0, w, h, 0, 0, dst.width, dst.height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+    void doUse(const Shader& s) override { s.use(); }
+    void doSetMat4(const char* n, const glm::mat4& m) override {
+        current->setMat4(n, glm::value_ptr(m));
+    }
+    void doSetVec4(const char* n, int components, float x, float y, float z, float w) override {
+        switch (components) {
+            case 1: current->setFloat(n, x); break;
+            case 2: current->setVec2(n, x, y); break;
+            case 3: current->setVec3(n, x, y, z); break;
+            default: current->setVec4(n, x, y, z, w); break;
+        }
+    }
+    void doSetInt(const char* n, int v) override { current->setInt(n, v); }
+    void doBindTexture(GLuint tex, int unit) override {
+        if (unit) glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, tex);
+        if (unit) glActiveTexture(GL_TEXTURE0);
+    }
+    void doSetBlend(BlendMode mode) override {
+        glBlendFunc(GL_SRC_ALPHA, mode == BlendMode::Additive ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+    }
+    void doSetDepthWrite(bool on) override { glDepthMask(on ? GL_TRUE : GL_FALSE); }
+    void doSetDepthTest(bool on) override { if (on) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST); }
+    void doSetCullFront(bool on) override {
+        if (on) { glCullFace(GL_FRONT); glEnable(GL_CULL_FACE); }
+        else glDisable(GL_CULL_FACE);
+    }
+    void doSetLineWidth(float w) override { glLineWidth(w); }
+    void doUpdateMesh(Mesh& m, const void* data, size_t bytes) override {
+        glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
+        if (bytes > m.capacity) {
+            glBufferData(GL_ARRAY_BUFFER, bytes, data, GL_DYNAMIC_DRAW);
+            m.capacity = bytes;
+        } else {
+            glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, data);
+        }
+    }
+    void doDraw(const Mesh& m, int first, int n) override {
+        GLenum mode = m.primitive == PrimitiveType::LineStrip ? GL_LINE_STRIP :
+                      m.primitive == PrimitiveType::Points ? GL_POINTS : GL_TRIANGLES;
+        glBindVertexArray(m.vao);
+        if (m.indexType) {
+            size_t indexSize = (m.indexType == GL_UNSIGNED_SHORT) ? 2 : 4;
+            glDrawElements(mode, n, m.indexType, (void*)(first * indexSize));
+        } else {
+            glDrawArrays(mode, first, n);
+        }
+        glBindVertexArray(0);
+    }
+    void doResetState() override {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDepthMask(GL_TRUE);
+        glEnable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glActiveTexture(GL_TEXTURE0);
+        glUseProgram(0);
+    }
+};
+
+// ============================================================
+// NULL BACKEND - counts (and optionally records) every command
+// Resource handles are fake but unique so scene code can't tell.
+// ============================================================
+class NullRenderDevice : public RenderDevice {
+public:
+    bool recording = false;
+    std::vector<RenderOp> recorded;   // command stream when recording
+
+    const char* name() const override { return "null"; }
+
+    Mesh createMesh(const MeshDesc& d) override {
+        Mesh m;
+        m.vao = nextHandle++;
+        m.vbo = nextHandle++;
+        m.ebo = d.indices ? nextHandle++ : 0;
+        m.indexType = d.indices ? d.indexType : 0;
+        m.count = d.indices ? d.indexCount : d.vertexCount;
+        m.primitive = d.primitive;
+        m.capacity = d.vertexBytes;
+        meshCount++;
+        return m;
+    }
+    void destroyMesh(Mesh& m) override {
+        if (!m.vao) return;
+        m = Mesh();
+        meshCount--;
+    }
+    GLuint createTexture(int, int, const unsigned char*, bool) override {
+        textureCount++;
+        return nextHandle++;
+    }
+    void destroyTexture(GLuint& tex) override {
+        if (!tex) return;
+        tex = 0;
+        textureCount--;
+    }
+    RenderTarget createTarget(int w, int h, bool color) override {
+        RenderTarget t;
+        t.fbo = nextHandle++;
+        t.color = color ? nextHandle++ : 0;
+        t.depth = nextHandle++;
+        t.width = w;
+        t.height = h;
+        return t;
+    }
+    void destroyTarget(RenderTarget& t) override { t = RenderTarget(); }
+
+protected:
+    GLuint nextHandle = 1;
+
+    void rec(RenderOp op) { if (recording) recorded.push_back(op); }
+
+    void doBeginPass(const PassDesc&) override { rec(RenderOp::BeginPass); }
+    void doEndPass(const PassDesc&) override { rec(RenderOp::EndPass); }
+    void doCopyDepth(GLuint, int, int, const RenderTarget&) override { rec(RenderOp::CopyDepth); }
+    void doUse(const Shader&) override { rec(RenderOp::UseShader); }
+    void doSetMat4(const char*, const glm::mat4&) override { rec(RenderOp::SetUniform); }
+    void doSetVec4(const char*, int, float, float, float, float) override { rec(RenderOp::SetUniform); }
+    void doSetInt(const char*, int) override { rec(RenderOp::SetUniform); }
+    void doBindTexture(GLuint, int) override { rec(RenderOp::BindTexture); }
+    void doSetBlend(BlendMode) override { rec(RenderOp::SetBlend); }
+    void doSetDepthWrite(bool) override { rec(RenderOp::SetDepthWrite); }
+    void doSetDepthTest(bool) override { rec(RenderOp::SetDepthTest); }
+    void doSetCullFront(bool) override { rec(RenderOp::SetCullFront); }
+    void doSetLineWidth(float) override { rec(RenderOp::SetLineWidth); }
+    void doUpdateMesh(Mesh& m, const void*, size_t bytes) override {
+        if (bytes > m.capacity) m.capacity = bytes;
+        rec(RenderOp::UpdateMesh);
+    }
+    void doDraw(const Mesh&, int, int) override { rec(RenderOp::Draw); }
+    void doResetState() override { rec(RenderOp::ResetState); }
+};
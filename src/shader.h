@@ -8,7 +8,7 @@
 #include <string>
 #include <fstream>
 #include <sstream>
-#include <iostream>
+#include "log.h"
 
 class Shader {
 public:
@@ -33,7 +33,7 @@ public:
         if (!ok) {
             char log[512];
             glGetProgramInfoLog(id, 512, nullptr, log);
-            std::cerr << "[Shader] Link error: " << log << std::endl;
+            LOG_ERROR("Shader") << "Link error: " << log;
             return false;
         }
 
@@ -67,7 +67,7 @@ private:
     std::string readFile(const std::string& path) {
         std::ifstream f(path);
         if (!f.is_open()) {
-            std::cerr << "[Shader] Cannot open: " << path << std::endl;
+            LOG_ERROR("Shader") << "Cannot open: " << path;
             return "";
         }
         std::stringstream ss;
@@ -85,7 +85,7 @@ private:
         if (!ok) {
             char log[512];
             glGetShaderInfoLog(s, 512, nullptr, log);
-            std::cerr << "[Shader] Compile error: " << log << std::endl;
+            LOG_ERROR("Shader") << "Compile error: " << log;
             return 0;
         }
         return s;
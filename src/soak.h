@@ -0,0 +1,163 @@
+#pragma once
+
+#include "log.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+
+#if defined(__linux__) || defined(__ANDROID__)
+#include <unistd.h>
+#endif
+
+// ============================================================
+// SOAK - long-run health check for kiosk installs. The app runs for a
+// set wall-clock time (optionally headless, optionally with the scene
+// clock accelerated so weeks of elapsedTime pass in hours) and samples:
+// resident memory, live meshes/textures, frame-time percentiles, the
+// meteor/comet population, and orbit precision -- how far a body drawn
+// from the float scene clock is from where an exact clock puts it.
+// Samples after the warm-up are split into thirds; the run fails if
+// the last third has drifted from the first beyond the thresholds.
+// ============================================================
+
+struct SoakConfig {
+    double seconds = 0;             // wall-clock length; 0 = off
+    double accel = 1.0;             // scene clock multiplier
+    double clockStart = 0;          // start elapsedTime here (e.g. 30 days in)
+    bool headless = false;          // null render device, no window
+    double interval = 10.0;         // seconds between samples
+    std::string csv;                // optional per-sample CSV
+    // Failure thresholds
+    double maxRssGrowthMB = 32.0;
+    int maxObjectGrowth = 8;        // meshes + textures
+    double maxP99Ratio = 1.5;       // last p99 vs first p99 (plus 1 ms slack)
+    double maxOrbitError = 0.01;    // world units
+
+    bool enabled() const { return seconds > 0; }
+};
+
+struct SoakSample {
+    double wallSec = 0, sceneSec = 0;
+    int64_t rssKB = 0;              // 0 where unavailable
+    int meshes = 0, textures = 0;
+    int particles = 0;              // meteors + comets
+    double p50 = 0, p95 = 0, p99 = 0;
+    double clockDrift = 0;          // |elapsedTime - sceneClock|, seconds
+    double orbitError = 0;          // worst body position error, world units
+};
+
+inline int64_t processRssKB() {
+#if defined(__linux__) || defined(__ANDROID__)
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    long pages = 0, resident = 0;
+    int n = fscanf(f, "%ld %ld", &pages, &resident);
+    fclose(f);
+    return n == 2 ? (int64_t)resident * sysconf(_SC_PAGESIZE) / 1024 : 0;
+#else
+    return 0;
+#endif
+}
+
+class SoakMonitor {
+public:
+    explicit SoakMonitor(const SoakConfig& cfg) : cfg(cfg) {
+        if (!cfg.csv.empty()) {
+            csv = fopen(cfg.csv.c_str(), "w");
+            if (csv) fprintf(csv, "wall_s,scene_s,rss_kb,meshes,textures,particles,p50_ms,p95_ms,p99_ms,clock_drift_s,orbit_error\n");
+            else LOG_WARN("Soak") << "Cannot open " << cfg.csv;
+        }
+    }
+    ~SoakMonitor() { if (csv) fclose(csv); }
+
+    void frame(double ms) { frameMs.push_back(ms); }
+
+    // Fills in the frame-time percentiles and resets the window
+    void sample(SoakSample s) {
+        if (!frameMs.empty()) {
+            std::sort(frameMs.begin(), frameMs.end());
+            auto pct = [&](double p) { return frameMs[std::min(frameMs.size() - 1, (size_t)(p * frameMs.size()))]; };
+            s.p50 = pct(0.50);
+            s.p95 = pct(0.95);
+            s.p99 = pct(0.99);
+            frameMs.clear();
+        }
+        samples.push_back(s);
+        LOG_INFO("Soak") << "t=" << (int)s.wallSec << "s scene=" << (int64_t)s.sceneSec << "s rss=" << s.rssKB / 1024
+                         << "MB meshes=" << s.meshes << " tex=" << s.textures << " particles=" << s.particles
+                         << " p50/p95/p99=" << s.p50 << "/" << s.p95 << "/" << s.p99
+                         << "ms drift=" << s.clockDrift << "s orbitErr=" << s.orbitError;
+        if (csv) {
+            fprintf(csv, "%.1f,%.0f,%lld,%d,%d,%d,%.3f,%.3f,%.3f,%.6f,%.6f\n", s.wallSec, s.sceneSec,
+                    (long long)s.rssKB, s.meshes, s.textures, s.particles, s.p50, s.p95, s.p99,
+                    s.clockDrift, s.orbitError);
+            fflush(csv);
+        }
+    }
+
+    // Verdict over the whole run; logs every failed check
+    bool passed() const {
+        size_t warm = samples.size() / 5;
+        size_t n = samples.size() - warm;
+        if (n < 3) {
+            LOG_WARN("Soak") << "Only " << samples.size() << " samples; run longer for a trend";
+            return true;
+        }
+        size_t third = n / 3;
+        auto first = [&](auto field) { return median(warm, warm + third, field); };
+        auto last = [&](auto field) { return median(samples.size() - third, samples.size(), field); };
+        bool ok = true;
+        auto fail = [&](const std::string& what) { LOG_ERROR("Soak") << "FAIL " << what; ok = false; };
+
+        double rss0 = first([](const SoakSample& s) { return (double)s.rssKB; });
+        double rss1 = last([](const SoakSample& s) { return (double)s.rssKB; });
+        if (rss0 > 0 && (rss1 - rss0) / 1024.0 > cfg.maxRssGrowthMB)
+            fail("RSS grew " + fmt((rss1 - rss0) / 1024.0) + " MB");
+
+        double obj0 = first([](const SoakSample& s) { return (double)(s.meshes + s.textures); });
+        double obj1 = last([](const SoakSample& s) { return (double)(s.meshes + s.textures); });
+        if (obj1 - obj0 > cfg.maxObjectGrowth)
+            fail("live GL objects grew by " + fmt(obj1 - obj0));
+
+        double par0 = first([](const SoakSample& s) { return (double)s.particles; });
+        double par1 = last([](const SoakSample& s) { return (double)s.particles; });
+        if (par1 > par0 * 2 + 32)
+            fail("meteor/comet population grew " + fmt(par0) + " -> " + fmt(par1));
+
+        double p0 = first([](const SoakSample& s) { return s.p99; });
+        double p1 = last([](const SoakSample& s) { return s.p99; });
+        if (p1 > p0 * cfg.maxP99Ratio + 1.0)
+            fail("p99 frame time " + fmt(p0) + " -> " + fmt(p1) + " ms");
+
+        double orbit = 0, drift = 0;
+        for (auto& s : samples) { orbit = std::max(orbit, s.orbitError); drift = std::max(drift, s.clockDrift); }
+        if (orbit > cfg.maxOrbitError)
+            fail("orbit error " + fmt(orbit) + " units (scene clock drift " + fmt(drift) + " s)");
+
+        if (ok) LOG_INFO("Soak") << "PASS (" << samples.size() << " samples)";
+        return ok;
+    }
+
+private:
+    SoakConfig cfg;
+    std::vector<double> frameMs;
+    std::vector<SoakSample> samples;
+    FILE* csv = nullptr;
+
+    template <typename F>
+    double median(size_t from, size_t to, F field) const {
+        std::vector<double> v;
+        for (size_t i = from; i < to; i++) v.push_back(field(samples[i]));
+        if (v.empty()) return 0;
+        std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+        return v[v.size() / 2];
+    }
+
+    static std::string fmt(double v) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.3g", v);
+        return buf;
+    }
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <algorithm>
+#include "render_device.h"
+#include "shader.h"
+
+// ============================================================
+// SOFT PARTICLES - the additive sprites (nebula, coronas, flares,
+// orbital particles, atmospheres, meteors, comets) are soft blobs that
+// cover large parts of the screen several times over. With a divisor
+// of 2 or 4 the scene pass only collects them, batched per texture. They
+// are then drawn into a target with 1/4 or 1/16 of the pixels and added
+// back to the frame:
+//   1. the scene's depth is resolved into a full-size texture and
+//      scaled down into the particle target
+//   2. sprites are drawn there, depth-tested against the scene. Sprites
+//      the scene drew with the depth test off are the sky layers drawn
+//      before any geometry, so they are pushed to the far plane
+//   3. the upsample filters bilinearly, except where the four particle
+//      texels around a pixel straddle a depth edge. There it takes the
+//      texel whose depth matches the pixel's, so glows keep their edges
+//      at planets
+// Additive blending doesn't depend on order, so batching changes
+// nothing but where the sprites land relative to alpha-blended rings.
+// ============================================================
+
+// Vertex layout shared with BillboardQuad: pos, uv, color, size
+static constexpr int SPRITE_FLOATS = 10;
+
+inline std::vector<VertexAttrib> spriteAttribs() {
+    return { {0, 3, GL_FLOAT, false, 0},
+             {1, 2, GL_FLOAT, false, 3 * sizeof(float)},
+             {2, 4, GL_FLOAT, false, 5 * sizeof(float)},
+             {3, 1, GL_FLOAT, false, 9 * sizeof(float)} };
+}
+
+// --particle-res N: 1, 2 or 4
+inline int particleDivisor(int n) {
+    return n >= 4 ? 4 : n >= 2 ? 2 : 1;
+}
+
+struct SoftParticles {
+    int divisor = 1;                 // 1 = sprites drawn in place at full resolution
+
+    bool enabled() const { return divisor > 1; }
+
+    void create(RenderDevice& gfx) {
+        MeshDesc d;
+        d.vertexBytes = 1024 * 6 * SPRITE_FLOATS * sizeof(float);
+        d.stride = SPRITE_FLOATS * sizeof(float);
+        d.attribs = spriteAttribs();
+        d.dynamic = true;
+        sprites = gfx.createMesh(d);
+
+        float qv[] = { -1,-1,0,0, 1,-1,1,0, 1,1,1,1, -1,-1,0,0, 1,1,1,1, -1,1,0,1 };
+        MeshDesc q;
+        q.vertices = qv; q.vertexBytes = sizeof(qv); q.vertexCount = 6; q.stride = 4 * sizeof(float);
+        q.attribs = { {0, 2, GL_FLOAT, false, 0}, {1, 2, GL_FLOAT, false, 2 * sizeof(float)} };
+        quad = gfx.createMesh(q);
+    }
+
+    // Start collecting; batches keep their capacity between frames
+    void begin() {
+        for (auto& b : batches) b.verts.clear();
+    }
+
+    // One sprite (6 vertices); tex and sky as the scene had them set
+    void add(GLuint tex, bool sky, const float* v) {
+        Batch* batch = nullptr;
+        for (auto& b : batches)
+            if (b.tex == tex && b.sky == sky) { batch = &b; break; }
+        if (!batch) {
+            batches.push_back({tex, sky, {}});
+            batch = &batches.back();
+        }
+        batch->verts.insert(batch->verts.end(), v, v + 6 * SPRITE_FLOATS);
+    }
+
+    // Draws what was collected and adds it onto framebuffer dst (w x h),
+    // whose depth the scene pass stored
+    void composite(RenderDevice& gfx, const Shader& billboard, const Shader& upsample, GLuint dst, int w, int h,
+                   const glm::mat4& view, const glm::mat4& proj, float nearPlane, float farPlane) {
+        int lw = std::max(1, w / divisor), lh = std::max(1, h / divisor);
+        if (sceneDepth.width != w || sceneDepth.height != h || target.width != lw || target.height != lh) {
+            gfx.destroyTarget(sceneDepth);
+            gfx.destroyTarget(target);
+            sceneDepth = gfx.createTarget(w, h, false);
+            target = gfx.createTarget(lw, lh, true);
+        }
+        gfx.copyDepth(dst, w, h, sceneDepth);
+        gfx.copyDepth(sceneDepth.fbo, w, h, target);
+
+        PassDesc low;
+        low.fbo = target.fbo;
+        low.width = lw;
+        low.height = lh;
+        low.clearColor = glm::vec4(0.0f);
+        low.depthLoad = LoadOp::Load;
+        low.depthStore = StoreOp::Store;     // sampled by the upsample
+        gfx.beginPass(low);
+        gfx.setDepthTest(true);
+        gfx.setDepthWrite(false);
+        gfx.setBlend(BlendMode::Additive);
+        gfx.use(billboard);
+        gfx.setMat4("uView", view);
+        // Clip z = w: everything lands just short of the cleared depth
+        glm::mat4 skyProj = proj;
+        for (int c = 0; c < 4; c++) skyProj[c][2] = skyProj[c][3] * (1.0f - 1e-6f);
+        for (auto& b : batches) {
+            if (b.verts.empty()) continue;
+            gfx.setMat4("uProjection", b.sky ? skyProj : proj);
+            gfx.bindTexture(b.tex);
+            gfx.updateMesh(sprites, b.verts.data(), b.verts.size() * sizeof(float),
+                           (int)(b.verts.size() / SPRITE_FLOATS));
+            gfx.draw(sprites);
+        }
+        gfx.endPass();
+
+        PassDesc back;
+        back.fbo = dst;
+        back.width = w;
+        back.height = h;
+        back.colorLoad = LoadOp::Load;
+        back.depthLoad = LoadOp::DontCare;
+        gfx.beginPass(back);
+        gfx.setDepthTest(false);
+        gfx.use(upsample);
+        gfx.bindTexture(target.color, 0);
+        gfx.bindTexture(target.depth, 1);
+        gfx.bindTexture(sceneDepth.depth, 2);
+        gfx.setInt("uParticles", 0);
+        gfx.setInt("uLowDepth", 1);
+        gfx.setInt("uDepth", 2);
+        gfx.setVec2("uLowTexel", 1.0f / lw, 1.0f / lh);
+        gfx.setVec2("uClip", nearPlane, farPlane);
+        gfx.draw(quad);
+        gfx.endPass();
+        // Unbound before the next frame renders into them
+        gfx.bindTexture(0, 1);
+        gfx.bindTexture(0, 2);
+    }
+
+private:
+    struct Batch {
+        GLuint tex;
+        bool sky;
+        std::vector<float> verts;
+    };
+    std::vector<Batch> batches;
+    Mesh sprites, quad;
+    RenderTarget sceneDepth;         // full size, depth only
+    RenderTarget target;             // particles + their depth, w / divisor
+};
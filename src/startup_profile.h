@@ -0,0 +1,117 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// ============================================================
+// STARTUP PROFILE - wall time of each launch phase, measured from
+// main(), plus two milestones: the first presented frame and the
+// first frame of a built galaxy (time to interactive). Phases are
+// scoped and may nest; everything runs on the main thread. Recording
+// stops once the app is interactive, so later rebuilds aren't listed.
+//   StartupScope phase("shaders");  ...  phase.next("textures");
+//   StartupProfile::get().mark("first frame");
+// ============================================================
+
+class StartupProfile {
+public:
+    struct Phase { std::string name; int depth; double startMs, durMs; };
+    struct Milestone { std::string name; double ms; };
+
+    static StartupProfile& get() {
+        static StartupProfile profile;
+        return profile;
+    }
+
+    void start() { t0 = Clock::now(); }
+    double now() const { return std::chrono::duration<double, std::milli>(Clock::now() - t0).count(); }
+
+    bool recording() const { return !finished; }
+    void finish() { finished = true; }
+
+    // -1 once finished; close() ignores it
+    int open(const char* name) {
+        if (finished) return -1;
+        phases.push_back({name, depth++, now(), -1});
+        return (int)phases.size() - 1;
+    }
+    void close(int i) {
+        if (i < 0) return;
+        phases[i].durMs = now() - phases[i].startMs;
+        depth--;
+    }
+
+    // First call per name wins
+    void mark(const char* name) {
+        if (!finished && at(name) < 0) milestones.push_back({name, now()});
+    }
+    double at(const std::string& name) const {
+        for (auto& m : milestones) if (m.name == name) return m.ms;
+        return -1;
+    }
+
+    void report() const {
+        printf("[Startup] %-28s %9s %9s\n", "phase", "start ms", "ms");
+        for (auto& p : phases)
+            printf("[Startup] %*s%-*s %9.1f %9.1f\n", p.depth * 2, "", 28 - p.depth * 2, p.name.c_str(), p.startMs, p.durMs);
+        for (auto& m : milestones)
+            printf("[Startup] %-28s %9.1f\n", m.name.c_str(), m.ms);
+        fflush(stdout);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point t0 = Clock::now();
+    std::vector<Phase> phases;
+    std::vector<Milestone> milestones;
+    int depth = 0;
+    bool finished = false;
+};
+
+class StartupScope {
+public:
+    explicit StartupScope(const char* name) : index(StartupProfile::get().open(name)) {}
+    ~StartupScope() { StartupProfile::get().close(index); }
+    // Ends this phase and starts its successor at the same depth
+    void next(const char* name) {
+        StartupProfile::get().close(index);
+        index = StartupProfile::get().open(name);
+    }
+    StartupScope(const StartupScope&) = delete;
+    StartupScope& operator=(const StartupScope&) = delete;
+private:
+    int index;
+};
+
+// --startup-budget TTI_MS[,FIRST_FRAME_MS]; 0 = unchecked
+struct StartupBudget {
+    double interactiveMs = 0, firstFrameMs = 0;
+
+    bool enabled() const { return interactiveMs > 0 || firstFrameMs > 0; }
+
+    static StartupBudget parse(const std::string& s) {
+        StartupBudget b;
+        b.interactiveMs = atof(s.c_str());
+        size_t comma = s.find(',');
+        if (comma != std::string::npos) b.firstFrameMs = atof(s.c_str() + comma + 1);
+        return b;
+    }
+
+    bool check(const StartupProfile& p) const {
+        bool ok = true;
+        auto one = [&](const char* name, double budget) {
+            if (budget <= 0) return;
+            double ms = p.at(name);
+            bool pass = ms >= 0 && ms <= budget;
+            printf("[Startup] %s %.1f ms / budget %.1f ms: %s\n", name, ms, budget, pass ? "ok" : "OVER BUDGET");
+            ok = ok && pass;
+        };
+        one("first frame", firstFrameMs);
+        one("interactive", interactiveMs);
+        fflush(stdout);
+        return ok;
+    }
+};
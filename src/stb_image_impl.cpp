@@ -1,2 +1,6 @@
 #define STB_IMAGE_IMPLEMENTATION
+// x86 gets SSE2 automatically; NEON (Android, ARM NAS) has to be asked for
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(STBI_NEON)
+#define STBI_NEON
+#endif
 #include "stb_image.h"
@@ -0,0 +1,323 @@
+#pragma once
+
+#ifdef __ANDROID__
+#include <GLES3/gl3.h>
+#else
+#include <GL/glew.h>
+#endif
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include "log.h"
+#include <algorithm>
+
+// ============================================================
+// VIDEO EXPORT - offline, fixed-timestep rendering to Y4M
+// The scene is drawn into an offscreen FBO at any resolution,
+// read back through a ring of PBOs (fenced, never stalls on the
+// frame just issued) and handed to a writer thread that converts
+// RGBA -> YUV 4:2:0 and streams it to a file or an encoder pipe:
+//   --export out.y4m
+//   --export "|ffmpeg -y -i - -c:v libx264 -crf 16 out.mp4"
+// ============================================================
+
+struct ExportSettings {
+    std::string output;          // empty = export disabled, leading '|' = pipe
+    int width = 1920, height = 1080;
+    int fps = 60;
+    float seconds = 10.0f;
+    int samples = 4;             // MSAA for the offscreen target
+    unsigned seed = 1;           // srand() seed so meteors/comets repeat
+
+    bool enabled() const { return !output.empty(); }
+    int frameCount() const { return std::max(1, (int)(seconds * fps + 0.5f)); }
+};
+
+// Parses "3840x2160"; Y4M 4:2:0 needs even dimensions
+inline bool parseExportSize(const std::string& s, int& w, int& h) {
+    if (sscanf(s.c_str(), "%dx%d", &w, &h) != 2 || w <= 0 || h <= 0) return false;
+    w = (w + 1) & ~1;
+    h = (h + 1) & ~1;
+    return true;
+}
+
+// ============================================================
+// Y4M WRITER - owns the output stream and a bounded buffer pool
+// ============================================================
+class Y4mWriter {
+public:
+    ~Y4mWriter() { close(); }
+
+    bool open(const std::string& target, int w, int h, int fps, int poolSize = 4) {
+        width = w; height = h;
+        if (!target.empty() && target[0] == '|') {
+#ifdef _WIN32
+            out = _popen(target.c_str() + 1, "wb");
+#else
+            // An encoder that exits early fails the next fwrite (the error
+            // path below); main() ignores SIGPIPE for the whole process
+            out = popen(target.c_str() + 1, "w");
+#endif
+            isPipe = true;
+        } else {
+            out = fopen(target.c_str(), "wb");
+        }
+        if (!out) {
+            LOG_ERROR("Export") << "Cannot open " << target;
+            return false;
+        }
+        fprintf(out, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", w, h, fps);
+
+        size_t rgbaBytes = (size_t)w * h * 4;
+        for (int i = 0; i < poolSize; i++) freeBufs.push_back(std::vector<uint8_t>(rgbaBytes));
+        yuv.resize((size_t)w * h * 3 / 2);
+        running = true;
+        worker = std::thread([this]() { run(); });
+        return true;
+    }
+
+    // Blocks while every buffer is in flight -- back-pressure instead of dropping frames
+    std::vector<uint8_t> acquire() {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this]() { return !freeBufs.empty(); });
+        std::vector<uint8_t> buf = std::move(freeBufs.back());
+        freeBufs.pop_back();
+        return buf;
+    }
+
+    // Rows are bottom-up (straight from glReadPixels)
+    void submit(std::vector<uint8_t>&& rgba) {
+        std::lock_guard<std::mutex> lock(mtx);
+        pending.push_back(std::move(rgba));
+        cv.notify_all();
+    }
+
+    // Hands an acquired buffer back unwritten; the frame is missing from
+    // the output, which framesWritten() reports
+    void discard(std::vector<uint8_t>&& rgba) {
+        std::lock_guard<std::mutex> lock(mtx);
+        freeBufs.push_back(std::move(rgba));
+        cv.notify_all();
+    }
+
+    void close() {
+        if (worker.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                running = false;
+                cv.notify_all();
+            }
+            worker.join();
+        }
+        if (out) {
+#ifdef _WIN32
+            if (isPipe) _pclose(out); else fclose(out);
+#else
+            if (isPipe) pclose(out); else fclose(out);
+#endif
+            out = nullptr;
+        }
+    }
+
+    int framesWritten() const { return written; }
+    bool failed() const { return writeError; }
+
+private:
+    FILE* out = nullptr;
+    bool isPipe = false;
+    int width = 0, height = 0;
+    std::vector<std::vector<uint8_t>> freeBufs;
+    std::deque<std::vector<uint8_t>> pending;
+    std::vector<uint8_t> yuv;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::thread worker;
+    bool running = false;
+    bool writeError = false;
+    int written = 0;
+
+    void run() {
+        for (;;) {
+            std::vector<uint8_t> frame;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [this]() { return !pending.empty() || !running; });
+                if (pending.empty()) return;  // stopped and drained
+                frame = std::move(pending.front());
+                pending.pop_front();
+            }
+            convert(frame.data());
+            if (fwrite("FRAME\n", 1, 6, out) != 6 ||
+                fwrite(yuv.data(), 1, yuv.size(), out) != yuv.size()) {
+                if (!writeError) LOG_WARN("Export") << "Write failed at frame " << written;
+                writeError = true;
+            }
+            written++;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                freeBufs.push_back(std::move(frame));
+                cv.notify_all();
+            }
+        }
+    }
+
+    // BT.601 full range (JFIF), matching the C420jpeg tag; chroma from 2x2 averages
+    void convert(const uint8_t* rgba) {
+        uint8_t* Y = yuv.data();
+        uint8_t* U = Y + (size_t)width * height;
+        uint8_t* V = U + (size_t)(width / 2) * (height / 2);
+        for (int y = 0; y < height; y++) {
+            const uint8_t* row = rgba + (size_t)(height - 1 - y) * width * 4;
+            uint8_t* yRow = Y + (size_t)y * width;
+            for (int x = 0; x < width; x++) {
+                const uint8_t* p = row + x * 4;
+                yRow[x] = (uint8_t)((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+            }
+        }
+        for (int y = 0; y < height / 2; y++) {
+            const uint8_t* r0 = rgba + (size_t)(height - 1 - 2 * y) * width * 4;
+            const uint8_t* r1 = r0 - (size_t)width * 4;
+            for (int x = 0; x < width / 2; x++) {
+                const uint8_t* a = r0 + x * 8; const uint8_t* b = r1 + x * 8;
+                int r = (a[0] + a[4] + b[0] + b[4] + 2) >> 2;
+                int g = (a[1] + a[5] + b[1] + b[5] + 2) >> 2;
+                int bl = (a[2] + a[6] + b[2] + b[6] + 2) >> 2;
+                int u = ((-43 * r - 85 * g + 128 * bl + 128) >> 8) + 128;
+                int v = ((128 * r - 107 * g - 21 * bl + 128) >> 8) + 128;
+                U[(size_t)y * (width / 2) + x] = (uint8_t)std::min(255, std::max(0, u));
+                V[(size_t)y * (width / 2) + x] = (uint8_t)std::min(255, std::max(0, v));
+            }
+        }
+    }
+};
+
+// ============================================================
+// FRAME EXPORTER - offscreen target + asynchronous PBO readback
+// ============================================================
+class FrameExporter {
+public:
+    static const int RING = 3;   // frames in flight between render and map
+
+    ~FrameExporter() { destroy(); }
+
+    bool create(const ExportSettings& s) {
+        width = s.width; height = s.height;
+
+        // Multisampled render target, resolved into a plain one for readback
+        GLint maxSamples = 0;
+        glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+        int samples = std::min(s.samples, (int)maxSamples);
+        glGenFramebuffers(1, &msaaFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, msaaFBO);
+        glGenRenderbuffers(2, msaaRB);
+        glBindRenderbuffer(GL_RENDERBUFFER, msaaRB[0]);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, msaaRB[0]);
+        glBindRenderbuffer(GL_RENDERBUFFER, msaaRB[1]);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH24_STENCIL8, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, msaaRB[1]);
+        bool ok = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+        glGenFramebuffers(1, &resolveFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, resolveFBO);
+        glGenRenderbuffers(1, &resolveRB);
+        glBindRenderbuffer(GL_RENDERBUFFER, resolveRB);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, resolveRB);
+        ok = ok && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        if (!ok) {
+            LOG_ERROR("Export") << "Offscreen target " << width << "x" << height << " incomplete";
+            return false;
+        }
+
+        glGenBuffers(RING, pbo);
+        for (int i = 0; i < RING; i++) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[i]);
+            glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)width * height * 4, nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        LOG_INFO("Export") << "Offscreen " << width << "x" << height << ", " << samples << "x MSAA, "
+                           << RING << " PBOs";
+        return true;
+    }
+
+    void destroy() {
+        for (int i = 0; i < RING; i++) if (fence[i]) { glDeleteSync(fence[i]); fence[i] = 0; }
+        if (pbo[0]) { glDeleteBuffers(RING, pbo); memset(pbo, 0, sizeof(pbo)); }
+        if (msaaFBO) { glDeleteFramebuffers(1, &msaaFBO); glDeleteRenderbuffers(2, msaaRB); msaaFBO = 0; }
+        if (resolveFBO) { glDeleteFramebuffers(1, &resolveFBO); glDeleteRenderbuffers(1, &resolveRB); resolveFBO = 0; }
+    }
+
+    // Render target for the frame being exported
+    GLuint target() const { return msaaFBO; }
+
+    // Resolve + queue readback of the frame just rendered. Maps the
+    // oldest PBO only once the ring is full, so the GPU stays ahead.
+    void capture(Y4mWriter& writer) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, msaaFBO);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, resolveFBO);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+        int slot = issued % RING;
+        if (issued >= RING) drain(writer, slot);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, resolveFBO);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[slot]);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        fence[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        issued++;
+    }
+
+    // Collect every frame still in flight (call once after the last capture)
+    void flush(Y4mWriter& writer) {
+        int first = std::max(0, issued - RING);
+        for (int f = first; f < issued; f++) drain(writer, f % RING);
+        issued = 0;
+    }
+
+    int framesIssued() const { return issued; }
+
+private:
+    int width = 0, height = 0;
+    GLuint msaaFBO = 0, msaaRB[2] = {0, 0};
+    GLuint resolveFBO = 0, resolveRB = 0;
+    GLuint pbo[RING] = {0};
+    GLsync fence[RING] = {0};
+    int issued = 0;
+
+    void drain(Y4mWriter& writer, int slot) {
+        if (!fence[slot]) return;
+        // Normally already signalled: this frame was issued RING frames ago
+        while (glClientWaitSync(fence[slot], GL_SYNC_FLUSH_COMMANDS_BIT, 100000000) == GL_TIMEOUT_EXPIRED) {}
+        glDeleteSync(fence[slot]);
+        fence[slot] = 0;
+
+        size_t bytes = (size_t)width * height * 4;
+        std::vector<uint8_t> buf = writer.acquire();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[slot]);
+        const void* src = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)bytes, GL_MAP_READ_BIT);
+        if (src) {
+            memcpy(buf.data(), src, bytes);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if (!src) {
+            // The buffer holds a stale frame; leave a gap rather than repeat it
+            LOG_ERROR("Export") << "Readback map failed (GL error " << (unsigned)glGetError() << "); frame dropped";
+            writer.discard(std::move(buf));
+            return;
+        }
+        writer.submit(std::move(buf));
+    }
+};
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include "log.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+// ============================================================
+// VIDEO WALL - several machines render one galaxy. The master runs
+// the simulation and multicasts its state every frame (camera, scene
+// clock, selection, audio levels, the frame's RNG seed); followers
+// apply it and draw their tile of the shared frustum (Camera tiles).
+// Swaps are a barrier on the master's frame counter: a follower sends
+// READY(n) once frame n is drawn, the master sends SWAP(n) when every
+// live follower has -- or after --wall-barrier-ms, so one dead PC
+// can't stall the wall. Followers join and leave without configuration.
+// One host: run several processes with --wall-iface 127.0.0.1.
+// ============================================================
+
+enum class WallMsg : uint32_t { State = 1, Ready = 2, Swap = 3 };
+static constexpr uint32_t WALL_MAGIC = 0x4C415750;  // "PWAL"
+static constexpr uint32_t WALL_VERSION = 1;
+
+// Sent as-is: every node runs the same build on a little-endian CPU
+struct WallState {
+    uint32_t magic, type, version, pad;
+    uint64_t frame;
+    double sceneClock;
+    float dt;
+    uint32_t seed;                  // srand() before this frame's meteors/comets
+    float nextMeteorTime, nextCometTime;  // spawn timers before the update
+    // Camera after its update
+    float position[3], target[3], targetPos[3], targetLookAt[3];
+    float orbitYaw, orbitPitch, orbitDist, targetOrbitDist, fov;
+    int32_t autoRotate;
+    int32_t selectedArtist, selectedAlbum, openCluster, currentLevel;
+    int32_t playingArtist, playingAlbum, playingTrack;
+    float audioLevel, audioPeak, audioBass, audioWave, audioProgress;
+    int32_t audioPlaying;
+    uint32_t libraryArtists, libraryTracks;  // followers check they have the same library
+};
+
+struct WallSync {
+    uint32_t magic, type;
+    uint64_t frame;
+    uint32_t node, pad;
+};
+
+struct WallConfig {
+    enum Role { Off, Master, Follower } role = Off;
+    std::string group = "239.255.80.71";
+    int port = 47100;
+    std::string iface;              // interface address to send/join on; "" = default route
+    int cols = 1, rows = 1;         // --wall-grid 3x2
+    int col = 0, row = 0;           // --wall-tile 2,1 (row 0 at the top)
+    int barrierMs = 30;             // master: longest wait for READY
+
+    bool enabled() const { return role != Off; }
+};
+
+// "3x2" or "2,1"
+inline bool parseWallPair(const std::string& s, int& a, int& b) {
+    size_t sep = s.find_first_of("x,");
+    if (sep == std::string::npos) return false;
+    a = atoi(s.c_str());
+    b = atoi(s.c_str() + sep + 1);
+    return true;
+}
+
+// Same seed on every node for a frame
+inline uint32_t wallFrameSeed(uint64_t frame) {
+    uint64_t x = frame * 0x9E3779B97F4A7C15ull;
+    x ^= x >> 31;
+    return (uint32_t)x ^ (uint32_t)(x >> 32);
+}
+
+#ifndef _WIN32
+class VideoWall {
+public:
+    ~VideoWall() { close(); }
+
+    bool open(const WallConfig& config) {
+        cfg = config;
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0) { LOG_ERROR("Wall") << "socket() failed"; return false; }
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+#ifdef SO_REUSEPORT
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));  // several nodes on one host
+#endif
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_port = htons((uint16_t)cfg.port);
+        local.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (bind(fd, (sockaddr*)&local, sizeof(local)) < 0) {
+            LOG_ERROR("Wall") << "Cannot bind port " << cfg.port;
+            close();
+            return false;
+        }
+
+        ip_mreq mreq{};
+        in_addr iface{};
+        iface.s_addr = htonl(INADDR_ANY);
+        if (!cfg.iface.empty()) inet_pton(AF_INET, cfg.iface.c_str(), &iface);
+        if (inet_pton(AF_INET, cfg.group.c_str(), &mreq.imr_multiaddr) != 1) {
+            LOG_ERROR("Wall") << "Bad multicast group " << cfg.group;
+            close();
+            return false;
+        }
+        mreq.imr_interface = iface;
+        if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+            LOG_ERROR("Wall") << "Cannot join " << cfg.group << (cfg.iface.empty() ? "" : " on " + cfg.iface);
+            close();
+            return false;
+        }
+        if (!cfg.iface.empty()) setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface));
+        unsigned char ttl = 1, loop = 1;
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+
+        dst = sockaddr_in{};
+        dst.sin_family = AF_INET;
+        dst.sin_port = htons((uint16_t)cfg.port);
+        dst.sin_addr = mreq.imr_multiaddr;
+        node = std::random_device()() ^ (uint32_t)getpid();
+        LOG_INFO("Wall") << (cfg.role == WallConfig::Master ? "Master" : "Follower") << " on " << cfg.group << ":"
+                         << cfg.port << ", tile " << cfg.col << "," << cfg.row << " of " << cfg.cols << "x" << cfg.rows;
+        return true;
+    }
+
+    void close() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+    bool isOpen() const { return fd >= 0; }
+    size_t followers() const { return peers.size(); }
+
+    // --- Master ---
+    void sendState(WallState s) {
+        s.magic = WALL_MAGIC;
+        s.type = (uint32_t)WallMsg::State;
+        s.version = WALL_VERSION;
+        sendto(fd, &s, sizeof(s), 0, (sockaddr*)&dst, sizeof(dst));
+    }
+
+    // Waits until every live follower has drawn frame; followers silent
+    // for two seconds are dropped. Returns how many made it in time.
+    int awaitReady(uint64_t frame) {
+        pump(0);  // new followers announce themselves with their first READY
+        auto now = Clock::now();
+        for (auto it = peers.begin(); it != peers.end(); )
+            it = now - it->second.seen > std::chrono::seconds(2) ? peers.erase(it) : std::next(it);
+        auto deadline = now + std::chrono::milliseconds(cfg.barrierMs);
+        for (;;) {
+            int ready = 0;
+            for (auto& p : peers) ready += p.second.frame >= frame;
+            if (ready == (int)peers.size()) return ready;
+            int left = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            if (left <= 0) {
+                if (++lateFrames % 300 == 1)
+                    LOG_WARN("Wall") << (int)peers.size() - ready << " follower(s) missed the swap (" << lateFrames << " frames)";
+                return ready;
+            }
+            pump(left);
+        }
+    }
+
+    void sendSwap(uint64_t frame) { sendSync(WallMsg::Swap, frame); }
+
+    // --- Follower ---
+    // Every state that arrived since the last call, oldest first; waits
+    // up to timeoutMs for the first
+    bool receiveStates(std::vector<WallState>& out, int timeoutMs) {
+        auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (pending.empty()) {
+            int left = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            if (left <= 0 || !pump(left)) break;
+        }
+        pump(0);
+        out.swap(pending);
+        pending.clear();
+        return !out.empty();
+    }
+
+    void sendReady(uint64_t frame) { sendSync(WallMsg::Ready, frame); }
+
+    bool awaitSwap(uint64_t frame, int timeoutMs) {
+        auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (swapFrame < frame) {
+            int left = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            if (left <= 0) return false;
+            pump(left);
+        }
+        return true;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Peer { uint64_t frame = 0; Clock::time_point seen; };
+
+    WallConfig cfg;
+    int fd = -1;
+    sockaddr_in dst{};
+    uint32_t node = 0;
+    std::vector<WallState> pending;
+    std::map<uint32_t, Peer> peers;
+    uint64_t swapFrame = 0;
+    uint64_t lateFrames = 0;
+
+    void sendSync(WallMsg type, uint64_t frame) {
+        WallSync m{WALL_MAGIC, (uint32_t)type, frame, node, 0};
+        sendto(fd, &m, sizeof(m), 0, (sockaddr*)&dst, sizeof(dst));
+    }
+
+    // Reads every waiting packet; waits up to timeoutMs for the first
+    bool pump(int timeoutMs) {
+        pollfd p{fd, POLLIN, 0};
+        if (poll(&p, 1, timeoutMs) <= 0) return false;
+        char buf[sizeof(WallState) + 64];
+        for (;;) {
+            ssize_t n = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+            if (n < 0) break;
+            uint32_t magic, type;
+            if (n < 8) continue;
+            memcpy(&magic, buf, 4);
+            memcpy(&type, buf + 4, 4);
+            if (magic != WALL_MAGIC) continue;
+            if (cfg.role == WallConfig::Follower && type == (uint32_t)WallMsg::State && n == (ssize_t)sizeof(WallState)) {
+                WallState s;
+                memcpy(&s, buf, sizeof(s));
+                if (s.version == WALL_VERSION) pending.push_back(s);
+            } else if (n == (ssize_t)sizeof(WallSync)) {
+                WallSync m;
+                memcpy(&m, buf, sizeof(m));
+                if (cfg.role == WallConfig::Follower && type == (uint32_t)WallMsg::Swap) {
+                    swapFrame = std::max(swapFrame, m.frame);
+                } else if (cfg.role == WallConfig::Master && type == (uint32_t)WallMsg::Ready) {
+                    Peer& peer = peers[m.node];
+                    peer.frame = std::max(peer.frame, m.frame);
+                    peer.seen = Clock::now();
+                }
+            }
+        }
+        return true;
+    }
+};
+#else
+// Multicast sockets are POSIX-only here (as is the cast server)
+class VideoWall {
+public:
+    bool open(const WallConfig&) { LOG_ERROR("Wall") << "Video wall mode is not supported on Windows"; return false; }
+    bool isOpen() const { return false; }
+    size_t followers() const { return 0; }
+    void sendState(WallState) {}
+    int awaitReady(uint64_t) { return 0; }
+    void sendSwap(uint64_t) {}
+    bool receiveStates(std::vector<WallState>& out, int) { out.clear(); return false; }
+    void sendReady(uint64_t) {}
+    bool awaitSwap(uint64_t, int) { return false; }
+};
+#endif
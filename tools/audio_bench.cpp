@@ -0,0 +1,330 @@
+// ============================================================
+// AUDIO BENCH - playback path numbers without sound hardware.
+// Runs ma_engine on miniaudio's null backend and, per file and per
+// loading mode, measures:
+//   init / first sample  time to open the source and get audio out
+//   decode x RT          how many times faster than realtime it decodes
+//   seek avg / max       seek + first sample after the seek
+//   mem                  resident memory added while the source is open
+// Modes are the resource manager flags AudioPlayer can choose between:
+// stream (pages from disk on job threads, what the player uses),
+// file (whole encoded file in memory) and decode (decoded up front,
+// so its cost shows in init rather than decode).
+//
+//   planetary_audio_bench                       generated corpus
+//   planetary_audio_bench a.flac b.mp3          your own files
+//   --seconds N   corpus length (default 60)    --runs N   best of N (3)
+//   --seeks N     seeks per file (default 20)   --csv FILE append rows
+//   --corpus DIR  where to generate / reuse the corpus
+//   --vfs readahead  load through ReadAheadVFS, like the player does
+//
+// The corpus is a WAV written with ma_encoder; MP3, FLAC, Ogg and Opus
+// copies are made with ffmpeg when it is on PATH. Formats this build
+// of miniaudio can't decode are reported as such rather than skipped.
+// ============================================================
+
+#include "miniaudio.h"
+#ifndef _WIN32
+#include "readahead_vfs.h"
+#include <unistd.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cstdint>
+
+namespace fs = std::filesystem;
+
+static double nowMs() {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Resident set size in KB (Linux); 0 where unavailable
+static int64_t rssKB() {
+#ifdef __linux__
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    long pages = 0, resident = 0;
+    int n = fscanf(f, "%ld %ld", &pages, &resident);
+    fclose(f);
+    return n == 2 ? (int64_t)resident * sysconf(_SC_PAGESIZE) / 1024 : 0;
+#else
+    return 0;
+#endif
+}
+
+// ============================================================
+// CORPUS
+// ============================================================
+
+// Deterministic stereo test signal: a sweep on the left, a chord plus
+// noise on the right, so lossy encoders have real work to do
+static bool writeTestWav(const std::string& path, int seconds, ma_uint32 rate = 44100) {
+    ma_encoder_config cfg = ma_encoder_config_init(ma_encoding_format_wav, ma_format_s16, 2, rate);
+    ma_encoder enc;
+    if (ma_encoder_init_file(path.c_str(), &cfg, &enc) != MA_SUCCESS) return false;
+    std::vector<int16_t> block(4096 * 2);
+    uint32_t noise = 12345;
+    double phase = 0;
+    ma_uint64 total = (ma_uint64)seconds * rate;
+    for (ma_uint64 f = 0; f < total; ) {
+        ma_uint64 n = std::min<ma_uint64>(4096, total - f);
+        for (ma_uint64 i = 0; i < n; i++) {
+            double t = (double)(f + i) / rate;
+            double sweep = 110.0 * std::pow(16.0, std::fmod(t, 10.0) / 10.0);
+            phase += 2.0 * M_PI * sweep / rate;
+            noise = noise * 1664525u + 1013904223u;
+            double chord = std::sin(2 * M_PI * 220 * t) + std::sin(2 * M_PI * 277.18 * t) + std::sin(2 * M_PI * 329.63 * t);
+            double l = 0.5 * std::sin(phase);
+            double r = 0.15 * chord + 0.1 * ((double)(noise >> 16) / 32768.0 - 1.0);
+            block[i * 2 + 0] = (int16_t)(l * 32000);
+            block[i * 2 + 1] = (int16_t)(r * 32000);
+        }
+        ma_uint64 written = 0;
+        ma_encoder_write_pcm_frames(&enc, block.data(), n, &written);
+        f += n;
+    }
+    ma_encoder_uninit(&enc);
+    return true;
+}
+
+static std::vector<std::string> buildCorpus(const std::string& dir, int seconds) {
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    std::string base = (fs::path(dir) / ("corpus_" + std::to_string(seconds) + "s")).string();
+    std::string wav = base + ".wav";
+    if (!fs::exists(wav) && !writeTestWav(wav, seconds)) {
+        std::cerr << "[AudioBench] Cannot write " << wav << std::endl;
+        return {};
+    }
+    std::vector<std::string> files = { wav };
+
+    struct Codec { const char* ext; const char* args; };
+    static const Codec codecs[] = {
+        { "mp3",  "-c:a libmp3lame -b:a 320k" },
+        { "flac", "-c:a flac" },
+        { "ogg",  "-c:a libvorbis -q:a 6" },
+        { "opus", "-c:a libopus -b:a 160k" },
+    };
+#ifdef _WIN32
+    bool ffmpeg = std::system("ffmpeg -version > NUL 2>&1") == 0;
+#else
+    bool ffmpeg = std::system("ffmpeg -version > /dev/null 2>&1") == 0;
+#endif
+    if (!ffmpeg) std::cout << "[AudioBench] ffmpeg not found: corpus is WAV only" << std::endl;
+    for (auto& c : codecs) {
+        std::string out = base + "." + c.ext;
+        if (!fs::exists(out) && ffmpeg) {
+            std::string cmd = "ffmpeg -v error -y -i \"" + wav + "\" " + c.args + " \"" + out + "\"";
+            if (std::system(cmd.c_str()) != 0) {
+                std::cout << "[AudioBench] ffmpeg could not encode " << c.ext << std::endl;
+                fs::remove(out, ec);
+            }
+        }
+        if (fs::exists(out)) files.push_back(out);
+    }
+    return files;
+}
+
+// ============================================================
+// MEASUREMENT
+// ============================================================
+
+struct Mode { const char* name; ma_uint32 flags; };
+static const Mode MODES[] = {
+    { "stream", MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_STREAM },
+    { "file",   0 },
+    { "decode", MA_RESOURCE_MANAGER_DATA_SOURCE_FLAG_DECODE },
+};
+
+struct Result {
+    bool ok = false;
+    double initMs = 0, firstMs = 0;
+    double decodeMs = 0;
+    ma_uint64 frames = 0;
+    double seekAvgMs = 0, seekMaxMs = 0;
+    int64_t memKB = 0;
+};
+
+// Read until at least one frame comes out (stream pages may still be
+// loading on a job thread); false at end of data or on timeout
+static bool readSome(ma_data_source* ds, float* buf, ma_uint64 want, ma_uint64& got) {
+    double deadline = nowMs() + 5000;
+    for (;;) {
+        got = 0;
+        ma_result r = ma_data_source_read_pcm_frames(ds, buf, want, &got);
+        if (got > 0) return true;
+        if (r == MA_AT_END || (r != MA_SUCCESS && r != MA_BUSY) || nowMs() > deadline) return false;
+        std::this_thread::yield();
+    }
+}
+
+static Result measure(ma_resource_manager* rm, const std::string& path, const Mode& mode,
+                      ma_uint32 channels, int seeks) {
+    Result res;
+    std::vector<float> buf(4096 * channels);
+    int64_t base = rssKB();
+
+    double t0 = nowMs();
+    ma_resource_manager_data_source src;
+    if (ma_resource_manager_data_source_init(rm, path.c_str(), mode.flags, nullptr, &src) != MA_SUCCESS)
+        return res;
+    ma_data_source* ds = (ma_data_source*)&src;
+    res.initMs = nowMs() - t0;
+
+    ma_uint64 got = 0;
+    if (!readSome(ds, buf.data(), 1024, got)) {
+        ma_resource_manager_data_source_uninit(&src);
+        return res;
+    }
+    res.firstMs = nowMs() - t0;
+    int64_t peak = rssKB();
+
+    // Decode the rest
+    double t1 = nowMs();
+    res.frames = got;
+    while (readSome(ds, buf.data(), 4096, got)) {
+        res.frames += got;
+        if ((res.frames & 0xFFFF) < 4096) peak = std::max(peak, rssKB());
+    }
+    res.decodeMs = nowMs() - t1 + (res.firstMs - res.initMs);
+    peak = std::max(peak, rssKB());
+    res.memKB = base > 0 ? std::max<int64_t>(0, peak - base) : 0;
+
+    // Seeks spread over the file by the golden ratio (deterministic,
+    // no two adjacent), each timed until audio comes out again
+    double total = 0;
+    int done = 0;
+    for (int i = 0; i < seeks && res.frames > 4096; i++) {
+        ma_uint64 target = (ma_uint64)(std::fmod(0.5 + i * 0.6180339887, 1.0) * (double)(res.frames - 4096));
+        double ts = nowMs();
+        if (ma_data_source_seek_to_pcm_frame(ds, target) != MA_SUCCESS) continue;
+        if (!readSome(ds, buf.data(), 1024, got)) continue;
+        double dt = nowMs() - ts;
+        total += dt;
+        res.seekMaxMs = std::max(res.seekMaxMs, dt);
+        done++;
+    }
+    res.seekAvgMs = done ? total / done : 0;
+
+    ma_resource_manager_data_source_uninit(&src);
+    res.ok = true;
+    return res;
+}
+
+// Fastest of the runs for timings, largest for memory
+static void keepBest(Result& best, const Result& r) {
+    if (!best.ok) { best = r; return; }
+    if (!r.ok) return;
+    best.initMs = std::min(best.initMs, r.initMs);
+    best.firstMs = std::min(best.firstMs, r.firstMs);
+    best.decodeMs = std::min(best.decodeMs, r.decodeMs);
+    best.seekAvgMs = std::min(best.seekAvgMs, r.seekAvgMs);
+    best.seekMaxMs = std::min(best.seekMaxMs, r.seekMaxMs);
+    best.memKB = std::max(best.memKB, r.memKB);
+}
+
+int main(int argc, char** argv) {
+    int seconds = 60, runs = 3, seeks = 20;
+    bool readAhead = false;
+    std::string corpusDir = (fs::temp_directory_path() / "planetary_audio_corpus").string();
+    std::string csvPath;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool more = i + 1 < argc;
+        if (a == "--seconds" && more) seconds = std::max(1, atoi(argv[++i]));
+        else if (a == "--runs" && more) runs = std::max(1, atoi(argv[++i]));
+        else if (a == "--seeks" && more) seeks = std::max(0, atoi(argv[++i]));
+        else if (a == "--corpus" && more) corpusDir = argv[++i];
+        else if (a == "--csv" && more) csvPath = argv[++i];
+        else if (a == "--vfs" && more) readAhead = std::string(argv[++i]) == "readahead";
+        else if (a.rfind("--", 0) == 0) {
+            std::cerr << "[AudioBench] Unknown option " << a << std::endl;
+            return 2;
+        }
+        else files.push_back(a);
+    }
+    if (files.empty()) files = buildCorpus(corpusDir, seconds);
+    if (files.empty()) return 1;
+
+    // Engine on the null backend: same resource manager, decoders and
+    // output format conversion as the player, no sound hardware needed
+    ma_backend backends[] = { ma_backend_null };
+    ma_context context;
+    if (ma_context_init(backends, 1, nullptr, &context) != MA_SUCCESS) {
+        std::cerr << "[AudioBench] Null backend unavailable" << std::endl;
+        return 1;
+    }
+    ma_engine_config config = ma_engine_config_init();
+    config.pContext = &context;
+#ifndef _WIN32
+    ReadAheadVFS vfs;
+    if (readAhead) {
+        vfs.start();
+        config.pResourceManagerVFS = vfs.vfs();
+    }
+#else
+    if (readAhead) std::cout << "[AudioBench] --vfs readahead is POSIX only; using the default VFS" << std::endl;
+#endif
+    ma_engine engine;
+    if (ma_engine_init(&config, &engine) != MA_SUCCESS) {
+        std::cerr << "[AudioBench] Failed to init miniaudio engine" << std::endl;
+        return 1;
+    }
+    ma_resource_manager* rm = ma_engine_get_resource_manager(&engine);
+    ma_uint32 channels = ma_engine_get_channels(&engine);
+    ma_uint32 rate = ma_engine_get_sample_rate(&engine);
+
+    std::cout << "[AudioBench] Null device " << rate << " Hz, " << channels << " ch, "
+              << (readAhead ? "read-ahead VFS" : "default VFS") << ", best of " << runs
+              << " (warm cache after the first)" << std::endl;
+    printf("%-24s %-7s %9s %9s %9s %9s %9s %9s\n",
+           "file", "mode", "init ms", "first ms", "decode xRT", "seek avg", "seek max", "mem KB");
+
+    FILE* csv = nullptr;
+    if (!csvPath.empty()) {
+        bool fresh = !fs::exists(csvPath);
+        csv = fopen(csvPath.c_str(), "a");
+        if (csv && fresh) fprintf(csv, "file,mode,vfs,init_ms,first_ms,decode_x_realtime,seek_avg_ms,seek_max_ms,mem_kb\n");
+    }
+
+    for (auto& path : files) {
+        std::string name = fs::path(path).filename().string();
+        for (auto& mode : MODES) {
+            Result best;
+            for (int r = 0; r < runs; r++) keepBest(best, measure(rm, path, mode, channels, seeks));
+            if (!best.ok) {
+                printf("%-24s %-7s %s\n", name.c_str(), mode.name, "no decoder in this build");
+                continue;
+            }
+            double audioMs = (double)best.frames * 1000.0 / rate;
+            double xrt = best.decodeMs > 0 ? audioMs / best.decodeMs : 0;
+            printf("%-24s %-7s %9.2f %9.2f %9.0f %9.2f %9.2f %9lld\n", name.c_str(), mode.name,
+                   best.initMs, best.firstMs, xrt, best.seekAvgMs, best.seekMaxMs, (long long)best.memKB);
+            if (csv)
+                fprintf(csv, "%s,%s,%s,%.3f,%.3f,%.1f,%.3f,%.3f,%lld\n", name.c_str(), mode.name,
+                        readAhead ? "readahead" : "default", best.initMs, best.firstMs, xrt,
+                        best.seekAvgMs, best.seekMaxMs, (long long)best.memKB);
+        }
+    }
+    if (csv) fclose(csv);
+
+    ma_engine_uninit(&engine);
+#ifndef _WIN32
+    if (readAhead) vfs.stop();
+#endif
+    ma_context_uninit(&context);
+    return 0;
+}
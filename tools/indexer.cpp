@@ -0,0 +1,414 @@
+// ============================================================
+// PLANETARY INDEXER - builds galaxy snapshots (src/galaxy_snapshot.h)
+// for thin clients on a machine that has CPU to spare, e.g. the NAS
+// next to the Shield. It scans local roots with the app's scanner and
+// tag caches and/or syncs a Subsonic server. Then it pins the star
+// layout, shrinks covers into the art pack and measures the tempo and
+// loudness of every local track. The result is served over HTTP, and
+// the audio of local roots is served with it. A rescan publishes a new
+// generation only if something changed, with art deltas from each of
+// the previous DELTA_GENERATIONS generations.
+//
+//   planetary-indexer /music hdd=/mnt/archive     roots, as in planetary.cfg
+//   --subsonic URL    also sync a Subsonic / Navidrome server (libcurl builds)
+//   --out DIR         snapshot directory (default ./planetary-index)
+//   --port N          HTTP port (default 47200)
+//   --art-size PX     thumbnail edge (default 128, at most COVER_MAX_SIZE)
+//   --rescan SECONDS  rescan interval (default 3600; 0 = build once, then serve)
+//   --no-analysis     skip tempo / loudness
+//   --local-paths     publish file paths rather than /track URLs, for
+//                     clients that mount the same share at the same place
+//   --once            build, publish and exit
+//
+// Clients: planetary --snapshot http://nas:47200
+// ============================================================
+
+#include "music_data.h"
+#include "library_roots.h"
+#include "galaxy_layout.h"
+#include "galaxy_snapshot.h"
+#include "media_server.h"
+#include "miniaudio.h"
+#ifdef PLANETARY_HAVE_CURL
+#include "navidrome_client.h"
+#endif
+
+#include <string>
+#include <vector>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cstdint>
+
+static const int DELTA_GENERATIONS = 8;
+
+struct IndexerConfig {
+    std::vector<LibraryRoot> roots;
+    std::string subsonic;
+    std::string out = "planetary-index";
+    int port = 47200;
+    int artSize = 128;
+    int rescanSec = 3600;
+    bool analysis = true;
+    bool localPaths = false;
+    bool once = false;
+};
+
+static double secondsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// fn(i) for i in [0, n) on every core
+static void parallelFor(size_t n, const std::function<void(size_t)>& fn) {
+    std::atomic<size_t> next{0};
+    auto worker = [&] { for (size_t i; (i = next++) < n; ) fn(i); };
+    std::vector<std::thread> pool;
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 1; i < cores && i < n; i++) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+}
+
+// 30 s from the middle of the track at 11 kHz mono: loudness is the RMS
+// in dBFS, tempo the strongest 70-180 bpm period in the autocorrelation
+// of the onset envelope (rises in log energy per 23 ms hop)
+static bool analyzeTrack(const std::string& path, float duration, float& bpm, float& loudness) {
+    const int RATE = 11025, HOP = 256;
+    ma_decoder_config cfg = ma_decoder_config_init(ma_format_f32, 1, RATE);
+    ma_decoder dec;
+    if (ma_decoder_init_file(path.c_str(), &cfg, &dec) != MA_SUCCESS) return false;
+    if (duration > 60) ma_decoder_seek_to_pcm_frame(&dec, (ma_uint64)((duration * 0.5f - 15.0f) * RATE));
+    std::vector<float> pcm((size_t)RATE * 30);
+    ma_uint64 got = 0;
+    ma_decoder_read_pcm_frames(&dec, pcm.data(), pcm.size(), &got);
+    ma_decoder_uninit(&dec);
+    if (got < (ma_uint64)RATE * 5) return false;
+
+    double power = 0;
+    for (ma_uint64 i = 0; i < got; i++) power += (double)pcm[i] * pcm[i];
+    loudness = std::min(-0.1f, (float)(10.0 * log10(power / (double)got + 1e-10)));
+
+    size_t frames = (size_t)(got / HOP);
+    std::vector<float> onset(frames, 0.0f);
+    float prev = 0;
+    for (size_t f = 0; f < frames; f++) {
+        double e = 0;
+        for (int i = 0; i < HOP; i++) e += (double)pcm[f * HOP + i] * pcm[f * HOP + i];
+        float le = (float)log(e + 1e-9);
+        if (f > 0) onset[f] = std::max(0.0f, le - prev);
+        prev = le;
+    }
+    const float fps = (float)RATE / HOP;
+    int lagMin = (int)(60.0f * fps / 180.0f), lagMax = (int)(60.0f * fps / 70.0f) + 1;
+    std::vector<float> ac(lagMax + 2, 0.0f);
+    int best = 0;
+    for (int lag = lagMin - 1; lag <= lagMax + 1 && lag < (int)frames; lag++) {
+        double s = 0;
+        for (size_t i = 0; i + lag < frames; i++) s += onset[i] * onset[i + lag];
+        ac[lag] = (float)(s / (double)(frames - lag));
+        if (lag >= lagMin && lag <= lagMax && (best == 0 || ac[lag] > ac[best])) best = lag;
+    }
+    if (best == 0 || ac[best] <= 0) return true;   // loudness only: no clear beat
+    // Parabolic peak for a lag between hops
+    float a = ac[best - 1], b = ac[best], c = ac[best + 1];
+    float shift = (a - 2 * b + c) != 0 ? 0.5f * (a - c) / (a - 2 * b + c) : 0.0f;
+    bpm = 60.0f * fps / ((float)best + std::clamp(shift, -0.5f, 0.5f));
+    return true;
+}
+
+class Indexer {
+public:
+    explicit Indexer(const IndexerConfig& cfg) : cfg(cfg) {
+        dir = cfg.out + "/";
+        fs::create_directories(dir + "art");
+        fs::create_directories(dir + "tags");
+        prevSnap.open(dir + "galaxy.snap");
+        prevArt.open(dir + "art.pack");
+        std::ifstream in(dir + "galaxy.snap", std::ios::binary);
+        published.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // One scan; publishes a new generation when the library changed
+    void run() {
+        auto t0 = std::chrono::steady_clock::now();
+        MusicLibrary lib = scan();
+        double scanSec = secondsSince(t0);
+
+        // Star layout, in the order clients would lay it out
+        GenreAngles genres;
+        for (auto& a : lib.artists) {
+            glm::vec3 p = starPosition(a.name, a.primaryGenre, genres);
+            a.layoutPos[0] = p.x;
+            a.layoutPos[1] = p.y;
+            a.layoutPos[2] = p.z;
+            a.hasLayout = true;
+        }
+        uint64_t gen = prevSnap.generation() + 1;
+        std::map<uint64_t, ArtPackItem> art = prepareArt(lib, gen);
+        if (cfg.analysis) analyze(lib);
+        std::map<std::string, std::string> tracks = trackUrls(lib);
+
+        std::string bytes = encodeSnapshot(lib, gen);
+        // Only the generation field (bytes 8-15) may differ
+        bool same = published.size() == bytes.size() && published.compare(0, 8, bytes, 0, 8) == 0 &&
+                    published.compare(16, std::string::npos, bytes, 16, std::string::npos) == 0;
+        if (same) {
+            LOG_INFO("Indexer") << "No changes; generation " << prevSnap.generation() << " stays current ("
+                                << scanSec << " s scan)";
+        } else {
+            publish(bytes, gen, art);
+            published.swap(bytes);
+        }
+        // The table covers every file the current generation refers to
+        table.clear();
+        table["/version"] = dir + "version";
+        table["/galaxy.snap"] = dir + "galaxy.snap";
+        table["/art.pack"] = dir + "art.pack";
+        for (auto& entry : fs::directory_iterator(dir + "art"))
+            table["/art/" + entry.path().filename().string()] = entry.path().string();
+        for (auto& [url, path] : tracks) table[url] = path;
+    }
+
+    const std::map<std::string, std::string>& files() const { return table; }
+
+private:
+    IndexerConfig cfg;
+    std::string dir;
+    GalaxySnapshot prevSnap;
+    ArtPack prevArt;
+    std::string published;                      // bytes of the current galaxy.snap
+    std::vector<std::vector<uint8_t>> thumbs;   // new thumbnails of this run
+    std::map<std::string, std::string> table;
+
+    MusicLibrary scan() {
+        MusicLibrary lib;
+        if (!cfg.roots.empty()) {
+            LibraryScanner scanner;
+            for (auto& root : cfg.roots) scanner.addRoot(root, dir + "tags/");
+            // busy() before poll(): a root publishes its library before it reports done
+            for (;;) {
+                bool busy = scanner.busy();
+                std::vector<MusicLibrary> done;
+                scanner.poll(done);
+                for (auto& l : done) mergeLibrary(lib, std::move(l));
+                if (!busy) break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+        }
+#ifdef PLANETARY_HAVE_CURL
+        if (!cfg.subsonic.empty()) mergeLibrary(lib, fetchMusicLibraryFromNavidrome(cfg.subsonic));
+#else
+        if (!cfg.subsonic.empty()) LOG_ERROR("Indexer") << "Built without libcurl; --subsonic ignored";
+#endif
+        LOG_INFO("Indexer") << lib.artists.size() << " artists, " << lib.totalAlbums << " albums, "
+                            << lib.totalTracks << " tracks";
+        return lib;
+    }
+
+    // Art hash per album (0 = none); returns the pack contents. Covers
+    // already in the previous pack are reused as they are.
+    std::map<uint64_t, ArtPackItem> prepareArt(MusicLibrary& lib, uint64_t gen) {
+        auto t0 = std::chrono::steady_clock::now();
+        // Subsonic covers are only fetched for albums the last snapshot didn't have
+        std::map<std::string, const SnapAlbum*> prevById;
+        for (uint32_t i = 0; i < prevSnap.albumCount(); i++) {
+            const SnapAlbum& a = prevSnap.album(i);
+            if (a.artHash && prevArt.find(a.artHash)) prevById[prevSnap.text(a.id)] = &a;
+        }
+        std::vector<AlbumData*> albums;
+        for (auto& a : lib.artists)
+            for (auto& b : a.albums) albums.push_back(&b);
+        thumbs.assign(albums.size(), {});
+
+        int size = cfg.artSize;
+        std::atomic<int> decoded{0}, fetched{0};
+        parallelFor(albums.size(), [&](size_t i) {
+            AlbumData& album = *albums[i];
+            bool remote = !album.tracks.empty() && album.tracks[0].filePath.find("://") != std::string::npos;
+            if (album.coverArtData.empty() && remote && !album.id.empty()) {
+                auto prev = prevById.find(album.id);
+                if (prev != prevById.end()) {
+                    album.artHash = prev->second->artHash;
+                    album.palette = prev->second->palette;
+                    return;
+                }
+#ifdef PLANETARY_HAVE_CURL
+                std::string img = navidrome::httpGet(navidrome::buildUrl(cfg.subsonic, "getCoverArt.view",
+                    "id=" + album.id + "&size=" + std::to_string(size * 2)));
+                album.coverArtData = decodeCover((const uint8_t*)img.data(), img.size(),
+                                                 album.coverArtW, album.coverArtH);
+                fetched++;
+#endif
+            }
+            if (album.coverArtData.empty()) return;
+            // Scanned covers arrive decoded (decodeCover); the hash is of those pixels
+            int dims[3] = {size, album.coverArtW, album.coverArtH};
+            uint64_t hash = fnv1a64(album.coverArtData.data(), album.coverArtData.size(),
+                                    fnv1a64(dims, sizeof(dims)));
+            if (!prevArt.find(hash)) {
+                // Square thumbnail; covers are close enough to square
+                thumbs[i] = boxDownscale(album.coverArtData.data(), album.coverArtW, album.coverArtH, size, size);
+                decoded++;
+            }
+            if (album.palette.count == 0) {
+                const uint8_t* px = prevArt.image(hash);
+                album.palette = extractPalette(px ? px : thumbs[i].data(), size, size);
+            }
+            album.artHash = hash;
+            album.coverArtData.clear();
+            album.coverArtData.shrink_to_fit();
+        });
+
+        std::map<uint64_t, ArtPackItem> items;
+        for (size_t i = 0; i < albums.size(); i++) {
+            uint64_t hash = albums[i]->artHash;
+            if (!hash || items.count(hash)) continue;
+            if (const ArtPackEntry* e = prevArt.find(hash)) items[hash] = {hash, e->addedGen, prevArt.pixels(*e)};
+            else if (!thumbs[i].empty()) items[hash] = {hash, gen, thumbs[i].data()};
+        }
+        LOG_INFO("Indexer") << items.size() << " covers (" << decoded << " new, " << fetched << " fetched) in "
+                            << secondsSince(t0) << " s";
+        return items;
+    }
+
+    // Tempo / loudness of local tracks; results carry over by path
+    void analyze(MusicLibrary& lib) {
+        auto t0 = std::chrono::steady_clock::now();
+        std::map<std::string, const SnapTrack*> known;
+        for (uint32_t i = 0; i < prevSnap.trackCount(); i++) {
+            const SnapTrack& t = prevSnap.track(i);
+            if (t.loudness != 0) known[prevSnap.text(t.path)] = &t;
+        }
+        std::vector<TrackData*> todo;
+        for (auto& a : lib.artists)
+            for (auto& b : a.albums)
+                for (auto& t : b.tracks) {
+                    if (t.filePath.find("://") != std::string::npos) continue;   // streams: no local audio
+                    auto it = known.find(publishedPath(t.filePath));
+                    if (it != known.end() && it->second->duration == t.duration) {
+                        t.bpm = it->second->bpm;
+                        t.loudness = it->second->loudness;
+                    } else {
+                        todo.push_back(&t);
+                    }
+                }
+        if (todo.empty()) return;
+        LOG_INFO("Indexer") << "Analysing " << todo.size() << " tracks";
+        std::atomic<int> done{0};
+        parallelFor(todo.size(), [&](size_t i) {
+            TrackData& t = *todo[i];
+            float bpm = 0, loudness = 0;
+            if (analyzeTrack(t.filePath, t.duration, bpm, loudness)) {
+                t.bpm = bpm;
+                t.loudness = loudness;
+            }
+            if (++done % 500 == 0) LOG_INFO("Indexer") << done << " / " << todo.size() << " analysed";
+        });
+        LOG_INFO("Indexer") << "Analysis took " << secondsSince(t0) << " s";
+    }
+
+    // What clients get as the track path
+    std::string publishedPath(const std::string& path) const {
+        if (cfg.localPaths || path.find("://") != std::string::npos) return path;
+        size_t dot = path.find_last_of("./");
+        std::string ext = dot != std::string::npos && path[dot] == '.' ? path.substr(dot) : "";
+        return "track/" + MediaServer::trackId(path) + ext;
+    }
+
+    // Rewrites local paths for clients; returns URL -> file to serve
+    std::map<std::string, std::string> trackUrls(MusicLibrary& lib) const {
+        std::map<std::string, std::string> urls;
+        for (auto& a : lib.artists)
+            for (auto& b : a.albums)
+                for (auto& t : b.tracks) {
+                    std::string p = publishedPath(t.filePath);
+                    if (p == t.filePath) continue;
+                    urls["/" + p] = t.filePath;
+                    t.filePath = p;
+                }
+        return urls;
+    }
+
+    void publish(const std::string& bytes, uint64_t gen, const std::map<uint64_t, ArtPackItem>& art) {
+        std::vector<ArtPackItem> items;
+        for (auto& [hash, item] : art) items.push_back(item);
+        std::string artDir = dir + "art/";
+        bool ok = writeArtPack(dir + "art.pack", gen, 0, cfg.artSize, items);
+        // art/delta-G: what a client at generation G is missing
+        for (uint64_t g = gen > (uint64_t)DELTA_GENERATIONS ? gen - DELTA_GENERATIONS : 1; g < gen && ok; g++) {
+            std::vector<ArtPackItem> newer;
+            for (auto& it : items) if (it.addedGen > g) newer.push_back(it);
+            ok = writeArtPack(artDir + "delta-" + std::to_string(g), gen, g, cfg.artSize, newer);
+        }
+        for (auto& entry : fs::directory_iterator(artDir)) {
+            uint64_t g = strtoull(entry.path().filename().string().c_str() + 6, nullptr, 10);
+            if (g + DELTA_GENERATIONS < gen) fs::remove(entry.path());
+        }
+        // The version goes last: a client that reads it finds the files in place
+        std::string version = std::to_string(gen) + "\n";
+        ok = ok && writeFileAtomic(dir + "galaxy.snap", bytes.data(), bytes.size()) &&
+             writeFileAtomic(dir + "version", version.data(), version.size());
+        if (!ok) {
+            LOG_ERROR("Indexer") << "Cannot write to " << dir;
+            return;
+        }
+        prevSnap.open(dir + "galaxy.snap");
+        prevArt.open(dir + "art.pack");
+        thumbs.clear();
+        LOG_INFO("Indexer") << "Published generation " << gen << ": snapshot " << bytes.size() / 1024
+                            << " KB, " << items.size() << " covers at " << cfg.artSize << " px";
+    }
+};
+
+int main(int argc, char* argv[]) {
+    IndexerConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--subsonic" && hasValue) cfg.subsonic = argv[++i];
+        else if (a == "--out" && hasValue) cfg.out = argv[++i];
+        else if (a == "--port" && hasValue) cfg.port = atoi(argv[++i]);
+        else if (a == "--art-size" && hasValue) cfg.artSize = std::clamp(atoi(argv[++i]), 16, COVER_MAX_SIZE);
+        else if (a == "--rescan" && hasValue) cfg.rescanSec = std::max(0, atoi(argv[++i]));
+        else if (a == "--no-analysis") cfg.analysis = false;
+        else if (a == "--local-paths") cfg.localPaths = true;
+        else if (a == "--once") cfg.once = true;
+        else if (a.rfind("--", 0) != 0) cfg.roots.push_back(parseRootLine(a));
+        else {
+            fprintf(stderr, "Unknown option %s\n", a.c_str());
+            return 1;
+        }
+    }
+    if (cfg.roots.empty() && cfg.subsonic.empty()) {
+        fprintf(stderr, "usage: planetary-indexer [ROOT...] [--subsonic URL] [--out DIR] [--port N]\n"
+                        "       [--art-size PX] [--rescan SECONDS] [--no-analysis] [--local-paths] [--once]\n");
+        return 1;
+    }
+#ifdef PLANETARY_HAVE_CURL
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+#endif
+
+    Indexer indexer(cfg);
+    MediaServer server;
+    if (!cfg.once && !server.start(cfg.port)) return 1;
+    for (;;) {
+        indexer.run();
+        if (cfg.once) break;
+        server.publishFiles(indexer.files());
+        if (cfg.rescanSec == 0) {
+            for (;;) std::this_thread::sleep_for(std::chrono::hours(1));
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(cfg.rescanSec));
+    }
+    Logger::get().flush();
+    return 0;
+}